@@ -875,6 +875,12 @@ macro(process_options)
     endif()
   endif()
 
+  # Thread-safe reference counts and packet buffers, required by the
+  # multithreaded simulator; they must be seen by every module
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+  endif()
+
   # Use upstream boost package config with CMake 3.30 and above
   if(POLICY CMP0167)
     cmake_policy(SET CMP0167 NEW)
@@ -1183,6 +1189,11 @@ macro(process_options)
     add_definitions(-DNS3_ASSERT_ENABLE)
   endif()
 
+  # Compile out the trace points written with NS_TRACE
+  if(NOT ${NS3_TRACING})
+    add_definitions(-DNS3_TRACING_DISABLE)
+  endif()
+
   set(ENABLE_TAP OFF)
   if(${NS3_TAP})
     set(ENABLE_TAP ON)
@@ -1225,6 +1236,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${NS3_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
@@ -15,6 +15,7 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 NS_LOG_COMPONENT_DEFINE("CI-SGC-Application");
@@ -69,7 +70,7 @@ RsuApplication::SendHeartbeat()
     ByteWriter bw(bytes);
     heartbeat->Serialize(bw);
 
-    ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>(bytes.data(), bytes.size());
+    ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>(std::move(bytes));
 
     // NS_LOG_INFO("[" << ns3::Simulator::Now().As(ns3::Time::MS) << "]\tRSU ("
     //                 << AddressToString(local_addr_)
@@ -89,7 +90,7 @@ RsuApplication::LaunchSessionKeyEncap()
         ByteWriter bw(bytes);
         ntf->Serialize(bw);
 
-        ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>(bytes.data(), bytes.size());
+        ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>(std::move(bytes));
 
         socket_->SendTo(packet, 0, broadcast_addr_);
     }
@@ -117,6 +118,7 @@ RsuApplication::Install(ns3::Ptr<ns3::Node> node,
                         ns3::Time hb_interval,
                         ns3::Time key_encap_interval,
                         ns3::Time key_upd_threshold,
+                        ns3::Time key_upd_lease,
                         uint32_t group_size,
                         uint32_t max_group_num)
 {
@@ -143,7 +145,8 @@ RsuApplication::Install(ns3::Ptr<ns3::Node> node,
     app->local_addr_ = local_addr;
     app->broadcast_addr_ = broadcast_addr;
     app->port_ = port;
-    app->sgc_proto_ = std::make_shared<SGCRSU>(group_size, max_group_num, key_upd_threshold);
+    app->sgc_proto_ =
+        std::make_shared<SGCRSU>(group_size, max_group_num, key_upd_threshold, key_upd_lease);
     app->heartbeat_interval_ = hb_interval;
     app->session_key_encap_interval_ = key_encap_interval;
 
@@ -190,7 +193,7 @@ RsuApplication::HandleRecv(ns3::Ptr<ns3::Socket> socket)
                     //                 << AddressToString(broadcast_addr_)
                     //                 << " Packet size=" << packet->GetSize());
                     ns3::Ptr<ns3::Packet> resp_packet =
-                        ns3::Create<ns3::Packet>(resp_bytes.data(), resp_bytes.size());
+                        ns3::Create<ns3::Packet>(std::move(resp_bytes));
                     socket_->SendTo(resp_packet, 0, broadcast_addr_);
                 }
             }
@@ -263,8 +266,7 @@ VehicleApplication::HandleRecv(ns3::Ptr<ns3::Socket> socket)
                     ByteWriter bw(resp_bytes);
                     resp->Serialize(bw);
 
-                    ns3::Ptr<ns3::Packet> resp =
-                        ns3::Create<ns3::Packet>(resp_bytes.data(), resp_bytes.size());
+                    ns3::Ptr<ns3::Packet> resp = ns3::Create<ns3::Packet>(std::move(resp_bytes));
                     // socket_->SendTo(resp, 0, from);
 
                     socket->SendTo(resp, 0, broadcast_addr_);
@@ -295,23 +297,18 @@ VehicleApplication::LaunchSessionKeyUpd()
         return;
     }
 
+    // Only ask RSU for a lease here. The update itself is encrypted once the grant arrives, see
+    // SGCVehicle::HandleKeyUpdGrant.
     auto sgc_proto_vehicle = std::dynamic_pointer_cast<SGCVehicle>(sgc_proto_);
-    auto start_time = std::chrono::steady_clock::now();
-    auto upd = sgc_proto_vehicle->LaunchKeyUpdate(32);
-    ns3::Time exec_time = ConvertRealTimeToSimTime(std::chrono::steady_clock::now() - start_time);
-    if (upd)
+    auto req = sgc_proto_vehicle->RequestKeyUpdate(32);
+    if (req)
     {
-        std::vector<uint8_t> upd_bytes;
-        ByteWriter bw(upd_bytes);
-        upd->Serialize(bw);
+        std::vector<uint8_t> req_bytes;
+        ByteWriter bw(req_bytes);
+        req->Serialize(bw);
 
-        ns3::Ptr<ns3::Packet> upd_packet =
-            ns3::Create<ns3::Packet>(upd_bytes.data(), upd_bytes.size());
-
-        ns3::Simulator::Schedule(exec_time, [this, upd_packet, sgc_proto_vehicle]() {
-            // INFO("Vehicle-" << sgc_proto_vehicle->GetPid() << " send session key update");
-            socket_->SendTo(upd_packet, 0, broadcast_addr_);
-        });
+        ns3::Ptr<ns3::Packet> req_packet = ns3::Create<ns3::Packet>(std::move(req_bytes));
+        socket_->SendTo(req_packet, 0, broadcast_addr_);
     }
 
     ns3::Simulator::Schedule(session_key_upd_interval_,
@@ -319,6 +316,12 @@ VehicleApplication::LaunchSessionKeyUpd()
                              this);
 }
 
+int64_t
+VehicleApplication::AssignStreams(int64_t stream)
+{
+    return std::dynamic_pointer_cast<SGCVehicle>(sgc_proto_)->AssignStreams(stream);
+}
+
 ns3::Ptr<VehicleApplication>
 VehicleApplication::Install(ns3::Ptr<ns3::Node> node,
                             uint32_t port,
@@ -30,6 +30,7 @@ class RsuApplication : public ns3::Application
                                             ns3::Time hb_interval,
                                             ns3::Time key_encap_interval,
                                             ns3::Time key_upd_threshold,
+                                            ns3::Time key_upd_lease,
                                             uint32_t group_size,
                                             uint32_t max_group_num);
     void SetLocalAddress(ns3::Address addr);
@@ -63,6 +64,7 @@ class VehicleApplication : public ns3::Application
                                                 uint32_t port,
                                                 ns3::Time stop_time,
                                                 ns3::Time key_upd_interval);
+    int64_t AssignStreams(int64_t stream) override;
 
   private:
     void StartApplication() override;
@@ -0,0 +1,321 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Micro-benchmark of the SAAGKA primitives.
+//
+// Each operation is run `warmup` times untimed and then `reps` times timed. One CSV row with
+// summary statistics (microseconds) is written per operation and parameter set:
+//
+//   op,security_level,group_size,n_groups,warmup,reps,
+//   mean_us,stddev_us,min_us,median_us,p95_us,max_us
+//
+// group_size and n_groups are 0 for operations that do not depend on them. The security level
+// is fixed per process (MIRACL is initialized once), so run the binary once per level, see
+// script/run_crypto_bench.sh.
+
+#include "crypto/agka.h"
+#include "crypto/pki.h"
+#include "message/bytereader.h"
+#include "message/bytewriter.h"
+#include "sgc/sgc.h"
+#include "utils.h"
+
+#include "ns3/command-line.h"
+#include "ns3/simulator.h"
+#include "ns3/singleton.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+namespace
+{
+
+struct BenchConfig
+{
+    uint32_t security_level;
+    uint32_t warmup;
+    uint32_t reps;
+};
+
+class CsvReporter
+{
+  public:
+    explicit CsvReporter(std::ostream& os)
+        : os_(os)
+    {
+        os_ << "op,security_level,group_size,n_groups,warmup,reps,mean_us,stddev_us,min_us,"
+               "median_us,p95_us,max_us"
+            << std::endl;
+    }
+
+    void Report(const std::string& op,
+                const BenchConfig& cfg,
+                uint32_t group_size,
+                uint32_t n_groups,
+                std::vector<double> samples)
+    {
+        std::sort(samples.begin(), samples.end());
+        double n = samples.size();
+        double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+        double var = 0;
+        for (auto s : samples)
+        {
+            var += (s - mean) * (s - mean);
+        }
+        double stddev = samples.size() > 1 ? std::sqrt(var / (n - 1)) : 0;
+        auto percentile = [&samples](double p) {
+            size_t i = std::min(samples.size() - 1, static_cast<size_t>(p * samples.size()));
+            return samples[i];
+        };
+
+        os_ << op << "," << cfg.security_level << "," << group_size << "," << n_groups << ","
+            << cfg.warmup << "," << cfg.reps << std::fixed << std::setprecision(3) << "," << mean
+            << "," << stddev << "," << samples.front() << "," << percentile(0.5) << ","
+            << percentile(0.95) << "," << samples.back() << std::defaultfloat << std::endl;
+    }
+
+  private:
+    std::ostream& os_;
+};
+
+// Run op warmup + reps times, return the timed samples in microseconds.
+std::vector<double>
+Measure(const BenchConfig& cfg, const std::function<void()>& op)
+{
+    for (uint32_t i = 0; i < cfg.warmup; i++)
+    {
+        op();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(cfg.reps);
+    for (uint32_t i = 0; i < cfg.reps; i++)
+    {
+        auto st = std::chrono::steady_clock::now();
+        op();
+        auto elapsed = std::chrono::steady_clock::now() - st;
+        samples.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+    }
+    return samples;
+}
+
+// Let member take slot pos of the group, doing the RSU side of the join (see SGCRSU::AckJoin)
+// on gsi.
+void
+JoinGroup(SGC::GroupSessionInfo& gsi, SAAGKA& member, uint32_t pos)
+{
+    auto pp = SAAGKA::GetPublicParameter();
+    auto pfc = pp->pfc;
+    auto kam = member.MessageGen(gsi.sid_, gsi.ek_, gsi.size_param_, pos);
+
+    auto& matrix = pp->matrices[kam.size_param];
+    size_t scale = matrix.size();
+    const auto& pk = Singleton<PKI>::Get()->Get(kam.pk_id);
+    auto pseudo_pk = SAAGKA::PublicKey{matrix[pos][scale + 1], matrix[pos][scale + 2]};
+    Big v = SAAGKA::HashAnyToBig(kam.sid.Bytes(), pk, kam.u);
+    Big pseudo_v = SAAGKA::HashAnyToBig({}, pseudo_pk, matrix[pos][scale]);
+    G1 tmp = pk.y1 + pfc->mult(pk.y2, v) + (-pseudo_pk.y1) + (-pfc->mult(pseudo_pk.y2, pseudo_v));
+
+    gsi.ek_.lambda = gsi.ek_.lambda + kam.u + (-matrix[pos][scale]);
+    gsi.ek_.mu = gsi.ek_.mu * pfc->pairing(tmp, pp->g0);
+    for (size_t i = 0; i < scale; i++)
+    {
+        if (i != pos)
+        {
+            gsi.d_[i] = gsi.d_[i] + (-matrix[pos][i]) + kam.z[i];
+        }
+    }
+    gsi.n_member_++;
+    gsi.mem_bitmap_.Set(pos);
+
+    if (!member.AsymKeyDerive(gsi.sid_, pos, gsi.d_[pos], gsi.ek_))
+    {
+        FATAL_ERROR("crypto-bench: join of slot " << pos << " failed");
+    }
+}
+
+void
+BenchSizeIndependent(const BenchConfig& cfg, CsvReporter& out)
+{
+    auto pp = SAAGKA::GetPublicParameter();
+    auto pfc = pp->pfc;
+
+    SAAGKA member;
+    out.Report("KeyGen", cfg, 0, 0, Measure(cfg, [&member]() { member.KeyGen(); }));
+
+    auto pk = member.GetPublicKey();
+    Sid sid(0, 0, Seconds(60));
+    G1 u;
+    Big w;
+    pfc->random(w);
+    u = pfc->mult(pp->generator_1, w);
+    out.Report("HashAnyToBig", cfg, 0, 0, Measure(cfg, [&]() {
+                   SAAGKA::HashAnyToBig(sid.Bytes(), pk, u);
+               }));
+
+    // PKI::Upload builds the y2 table once per key; it pays off after a few mult(pk.y2, v)
+    out.Report("PrecompY2", cfg, 0, 0, Measure(cfg, [&]() {
+                   G1 y2 = pk.y2;
+                   pfc->precomp_for_mult(y2);
+               }));
+    G1 y2_table = pk.y2;
+    pfc->precomp_for_mult(y2_table);
+    out.Report("MultY2", cfg, 0, 0, Measure(cfg, [&]() { pfc->mult(pk.y2, w); }));
+    out.Report("MultY2Precomp", cfg, 0, 0, Measure(cfg, [&]() { pfc->mult(y2_table, w); }));
+
+    std::vector<uint8_t> g1_bytes;
+    out.Report("G1Serialize", cfg, 0, 0, Measure(cfg, [&]() {
+                   g1_bytes.clear();
+                   ByteWriter bw(g1_bytes);
+                   bw.write(u);
+               }));
+    out.Report("G1Deserialize", cfg, 0, 0, Measure(cfg, [&]() {
+                   ByteReader br(g1_bytes.data(), g1_bytes.size());
+                   br.read<G1>();
+               }));
+
+    GT gt = pfc->pairing(u, pp->g0);
+    std::vector<uint8_t> gt_bytes;
+    out.Report("GTSerialize", cfg, 0, 0, Measure(cfg, [&]() {
+                   gt_bytes.clear();
+                   ByteWriter bw(gt_bytes);
+                   bw.write(gt);
+               }));
+    out.Report("GTDeserialize", cfg, 0, 0, Measure(cfg, [&]() {
+                   ByteReader br(gt_bytes.data(), gt_bytes.size());
+                   br.read<GT>();
+               }));
+}
+
+void
+BenchGroup(const BenchConfig& cfg,
+           uint32_t size_param,
+           uint32_t max_encrypt_groups,
+           CsvReporter& out)
+{
+    auto pp = SAAGKA::GetPublicParameter();
+    uint32_t group_size = pp->matrices[size_param].size();
+    if (group_size < 2)
+    {
+        return;
+    }
+
+    SGC::GroupSessionInfo gsi(size_param, size_param);
+
+    // slot 0 decrypts, slot 1 provides the material other members apply in UpdateKey
+    SAAGKA member;
+    member.KeyGen();
+    JoinGroup(gsi, member, 0);
+
+    SAAGKA joiner;
+    joiner.KeyGen();
+    auto kam = joiner.MessageGen(gsi.sid_, gsi.ek_, gsi.size_param_, 1);
+
+    // MessageGen on a used key runs KeyGen first, as it does in the simulation
+    SAAGKA prober;
+    prober.KeyGen();
+    out.Report("MessageGen", cfg, group_size, 0, Measure(cfg, [&]() {
+                   prober.MessageGen(gsi.sid_, gsi.ek_, gsi.size_param_, 1);
+               }));
+
+    out.Report("CheckValid", cfg, group_size, 0, Measure(cfg, [&kam]() {
+                   if (!SAAGKA::CheckValid(kam))
+                   {
+                       FATAL_ERROR("crypto-bench: CheckValid rejected a valid material");
+                   }
+               }));
+
+    std::vector<uint8_t> msg = GenerateRandomBytes(32);
+    for (uint32_t n_groups = 1; n_groups <= max_encrypt_groups; n_groups++)
+    {
+        std::vector<SAAGKA::EncryptionKey> eks(n_groups, gsi.ek_);
+        out.Report("Encrypt", cfg, group_size, n_groups, Measure(cfg, [&]() {
+                       SAAGKA::Encrypt(msg, eks);
+                   }));
+    }
+
+    std::vector<SAAGKA::EncryptionKey> eks(1, gsi.ek_);
+    auto ct = SAAGKA::Encrypt(msg, eks);
+    if (member.Decrypt(ct, 0) != msg)
+    {
+        FATAL_ERROR("crypto-bench: Decrypt does not recover the plaintext");
+    }
+    out.Report("Decrypt", cfg, group_size, 0, Measure(cfg, [&]() { member.Decrypt(ct, 0); }));
+
+    // UpdateKey keeps folding the same material into the member's keys, which is fine for
+    // timing but leaves them unusable; it runs last
+    out.Report("UpdateKey", cfg, group_size, 0, Measure(cfg, [&]() { member.UpdateKey(kam); }));
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t securityLevel = 80;
+    uint32_t minGroupSize = 10;
+    uint32_t maxGroupSize = 100;
+    uint32_t groupSizeStep = 10;
+    uint32_t maxEncryptGroups = 5;
+    uint32_t warmup = 3;
+    uint32_t reps = 20;
+    std::string out = "crypto-bench.csv";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("securityLevel", "Security level (80 or 128)", securityLevel);
+    cmd.AddValue("minGroupSize", "Smallest group size to benchmark", minGroupSize);
+    cmd.AddValue("maxGroupSize", "Largest group size to benchmark", maxGroupSize);
+    cmd.AddValue("groupSizeStep", "Step size of group size", groupSizeStep);
+    cmd.AddValue("maxEncryptGroups",
+                 "Encrypt is measured for 1..maxEncryptGroups groups",
+                 maxEncryptGroups);
+    cmd.AddValue("warmup", "Untimed runs before measuring", warmup);
+    cmd.AddValue("reps", "Timed runs per measurement", reps);
+    cmd.AddValue("out", "CSV output file, '-' for stdout", out);
+    cmd.Parse(argc, argv);
+
+    if (reps == 0 || groupSizeStep == 0)
+    {
+        NS_FATAL_ERROR("reps and groupSizeStep must be positive");
+    }
+
+    SAAGKA::Setup(securityLevel, maxGroupSize, groupSizeStep);
+
+    std::ofstream ofs;
+    if (out != "-")
+    {
+        ofs.open(out);
+        if (!ofs)
+        {
+            NS_FATAL_ERROR("cannot open " << out);
+        }
+    }
+    CsvReporter reporter(out == "-" ? std::cout : ofs);
+    BenchConfig cfg{securityLevel, warmup, reps};
+
+    BenchSizeIndependent(cfg, reporter);
+
+    auto pp = SAAGKA::GetPublicParameter();
+    for (uint32_t i = 0; i < pp->matrices.size(); i++)
+    {
+        if (pp->matrices[i].size() >= minGroupSize)
+        {
+            BenchGroup(cfg, i, maxEncryptGroups, reporter);
+        }
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
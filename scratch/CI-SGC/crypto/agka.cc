@@ -50,7 +50,11 @@ SAAGKA::KeyGen()
     pk_.y2 = pfc->mult(pp_->generator_1, sk_.x2);
     is_key_used_ = false;
     pk_id_ = pk_counter_;
-    ns3::Singleton<PKI>::Get()->Upload(pk_id_, pk_);
+    if (!ns3::Singleton<PKI>::Get()->Upload(pk_id_, pk_))
+    {
+        FATAL_ERROR("KeyGen failed: cannot upload public key " << pk_id_);
+        return;
+    }
     pk_counter_++;
 }
 
@@ -61,10 +65,10 @@ SAAGKA::UpdateKey(const KAMaterial& kam)
     auto pfc = pp_->pfc;
     auto scale = matrix.size();
 
-    auto pk = ns3::Singleton<PKI>::Get()->Get(kam.pk_id);
+    const auto& pk = ns3::Singleton<PKI>::Get()->Get(kam.pk_id);
     auto pseudo_pk = SAAGKA::PublicKey{matrix[kam.pos][scale + 1], matrix[kam.pos][scale + 2]};
-    Big v = SAAGKA::HashAnyToBig(kam.sid, pk, kam.u);
-    Big pseudo_v = SAAGKA::HashAnyToBig(std::vector<uint8_t>(), pseudo_pk, matrix[kam.pos][scale]);
+    Big v = SAAGKA::HashAnyToBig(kam.sid.Bytes(), pk, kam.u);
+    Big pseudo_v = SAAGKA::HashAnyToBig({}, pseudo_pk, matrix[kam.pos][scale]);
     G1 tmp = pk.y1 + pfc->mult(pk.y2, v) + (-pseudo_pk.y1) + (-pfc->mult(pseudo_pk.y2, pseudo_v));
 
     GT delta_mu = pfc->pairing(tmp, pp_->g0);
@@ -77,7 +81,7 @@ SAAGKA::UpdateKey(const KAMaterial& kam)
 }
 
 SAAGKA::KAMaterial
-SAAGKA::MessageGen(const std::vector<uint8_t>& sid,
+SAAGKA::MessageGen(const Sid& sid,
                    const EncryptionKey& cur_ek,
                    int size_param,
                    int pos)
@@ -96,9 +100,9 @@ SAAGKA::MessageGen(const std::vector<uint8_t>& sid,
     kam.size_param = size_param;
     kam.pos = pos;
     kam.u = pfc->mult(pp_->generator_1, w);
-    kam.sid = std::vector<uint8_t>(sid);
+    kam.sid = sid;
 
-    Big v = HashAnyToBig(kam.sid, pk_, kam.u);
+    Big v = HashAnyToBig(kam.sid.Bytes(), pk_, kam.u);
     for (int j = 0; j < pp_->matrices[size_param].size(); ++j)
     {
         G1 elem = pfc->mult(pp_->g0, sk_.x1 + (v * sk_.x2)) + pfc->mult(pp_->h[j], w);
@@ -117,7 +121,7 @@ SAAGKA::MessageGen(const std::vector<uint8_t>& sid,
     auto scale = matrix.size();
 
     auto pseudo_pk = SAAGKA::PublicKey{matrix[pos][scale + 1], matrix[pos][scale + 2]};
-    Big pseudo_v = SAAGKA::HashAnyToBig(std::vector<uint8_t>(), pseudo_pk, matrix[pos][scale]);
+    Big pseudo_v = SAAGKA::HashAnyToBig({}, pseudo_pk, matrix[pos][scale]);
     G1 tmp = pk_.y1 + pfc->mult(pk_.y2, v) + (-pseudo_pk.y1) + (-pfc->mult(pseudo_pk.y2, pseudo_v));
 
     GT delta_mu = pfc->pairing(tmp, pp_->g0);
@@ -131,12 +135,12 @@ SAAGKA::MessageGen(const std::vector<uint8_t>& sid,
 }
 
 bool
-SAAGKA::AsymKeyDerive(const std::vector<uint8_t>& sid,
+SAAGKA::AsymKeyDerive(const Sid& sid,
                       uint32_t pos,
                       const G1& d,
                       const EncryptionKey& expected_ek)
 {
-    if (!IsEqual(sid, sid_) || pending_pos_ != pos)
+    if (sid != sid_ || pending_pos_ != pos)
     {
         INFO("AsymKeyDerive failed: sid or position not match");
         return false;
@@ -156,6 +160,12 @@ SAAGKA::AsymKeyDerive(const std::vector<uint8_t>& sid,
     ek_ = pending_ek_;
     pos_ = pending_pos_;
 
+    // h[pos_] is fixed for the lifetime of the membership, so its pairing table pays off on every
+    // Decrypt. A precomputed G1 cannot be assigned to, hence the fresh object.
+    neg_h_pos_ = std::make_unique<G1>();
+    *neg_h_pos_ = -pp_->h[pos_];
+    pp_->pfc->precomp_for_pairing(*neg_h_pos_);
+
     return true;
     // INFO("Asymmetric key derived, Group-" << ParseGroupSeqFromSid(sid) << ", member-" << pos_
     //                                       << ", ek=" << ek_ << ", dk=" << ToString(dk_));
@@ -183,7 +193,7 @@ SAAGKA::GenOneMatrix(int size)
             {
                 continue;
             }
-            Big v = HashAnyToBig(std::vector<uint8_t>(), PublicKey{y1, y2}, u);
+            Big v = HashAnyToBig({}, PublicKey{y1, y2}, u);
             m[i][j] = pfc->mult(pp_->h[j], w) + pfc->mult(pp_->g0, x1 + (x2 * v));
         }
         m[i][j] = u;
@@ -251,12 +261,12 @@ SAAGKA::GetPublicParameter()
 }
 
 Big
-SAAGKA::HashAnyToBig(const std::vector<uint8_t>& m, const PublicKey& pk, const G1& elem)
+SAAGKA::HashAnyToBig(std::span<const uint8_t> m, const PublicKey& pk, const G1& elem)
 {
     std::vector<uint8_t> buf;
     ByteWriter bw(buf);
 
-    bw.write(m);
+    bw.write(m.data(), m.size());
     bw.write(pk.y1);
     bw.write(pk.y2);
     bw.write(elem);
@@ -278,7 +288,7 @@ SAAGKA::HashAnyToBig(const std::vector<uint8_t>& m, const PublicKey& pk, const G
 bool
 SAAGKA::CheckValid(const KAMaterial& kam)
 {
-    auto pk = ns3::Singleton<PKI>::Get()->Get(kam.pk_id);
+    const auto& pk = ns3::Singleton<PKI>::Get()->Get(kam.pk_id);
     std::vector<Big> r(pp_->matrices[kam.size_param].size());
 
     Big r_sum = 0;
@@ -303,7 +313,7 @@ SAAGKA::CheckValid(const KAMaterial& kam)
 
     // INFO("SAAGKA::CheckValid, left_GT=" << ToString(left_GT));
 
-    Big v = HashAnyToBig(kam.sid, pk, kam.u);
+    Big v = HashAnyToBig(kam.sid.Bytes(), pk, kam.u);
     // INFO("SAAGKA::CheckValid, v=" << v);
 
     GT right1_GT = pfc->pairing(pk.y1 + pfc->mult(pk.y2, v), pfc->mult(pp_->g0, r_sum));
@@ -341,11 +351,18 @@ SAAGKA::Encrypt(const std::vector<uint8_t>& msg, std::vector<EncryptionKey>& eks
 std::vector<uint8_t>
 SAAGKA::Decrypt(const Ciphertext& ct, uint32_t index)
 {
+    if (!neg_h_pos_)
+    {
+        FATAL_ERROR("Decrypt failed: no asymmetric key derived yet");
+    }
     auto pfc = pp_->pfc;
 
-    GT gt1 = pfc->pairing(dk_, ct.c1_);
-    GT gt2 = pfc->pairing(pp_->h[pos_], ct.c2_[index]);
-    return BytesXOR(ct.c3_[index], HashGTToBytes(gt1 / gt2, ct.c3_[index].size()));
+    // e(dk, c1) / e(h[pos], c2) = e(dk, c1) * e(-h[pos], c2), computed as a product of pairings
+    // that shares one final exponentiation
+    G1* left[2] = {&dk_, neg_h_pos_.get()};
+    G1* right[2] = {const_cast<G1*>(&ct.c1_), const_cast<G1*>(&ct.c2_[index])};
+    GT gt = pfc->multi_pairing(2, left, right);
+    return BytesXOR(ct.c3_[index], HashGTToBytes(gt, ct.c3_[index].size()));
 }
 
 std::vector<uint8_t>
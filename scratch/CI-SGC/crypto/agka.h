@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../sgc/sid.h"
 #include "MIRACL-wrapper.h"
 #include "utils.h"
 
@@ -7,6 +8,7 @@
 #include <cstdint>
 #include <memory>
 #include <ostream>
+#include <span>
 #include <vector>
 
 class SAAGKA
@@ -63,7 +65,7 @@ class SAAGKA
         uint32_t pk_id;
         uint32_t size_param;
         uint32_t pos;
-        std::vector<uint8_t> sid;
+        Sid sid;
         G1 u;
         std::vector<G1> z;
 
@@ -139,11 +141,11 @@ class SAAGKA
     SAAGKA()
         : is_key_used_(false) {};
     virtual ~SAAGKA() {};
-    KAMaterial MessageGen(const std::vector<uint8_t>& sid,
+    KAMaterial MessageGen(const Sid& sid,
                           const EncryptionKey& cur_ek,
                           int size_param,
                           int pos);
-    bool AsymKeyDerive(const std::vector<uint8_t>& sid,
+    bool AsymKeyDerive(const Sid& sid,
                        uint32_t pos,
                        const G1& d,
                        const EncryptionKey& expected_ek);
@@ -154,7 +156,7 @@ class SAAGKA
     EncryptionKey GetEncryptionKey();
     void UpdateKey(const KAMaterial& kam);
 
-    static Big HashAnyToBig(const std::vector<uint8_t>& m, const PublicKey& pk, const G1& elem);
+    static Big HashAnyToBig(std::span<const uint8_t> m, const PublicKey& pk, const G1& elem);
     static std::vector<uint8_t> HashGTToBytes(const GT& gt, uint32_t length);
 
     static void Setup(int security_level, int max_group_size, int size_step);
@@ -177,9 +179,12 @@ class SAAGKA
     uint32_t pk_id_;
     EncryptionKey ek_;
     DecryptionKey dk_;
-    std::vector<uint8_t> sid_;
+    Sid sid_;
     uint32_t pos_;
 
+    // -h[pos_] with a precomputed pairing table, rebuilt whenever pos_ changes
+    std::unique_ptr<G1> neg_h_pos_;
+
     // pending values for latest session
     EncryptionKey pending_ek_;
     uint32_t pending_pos_;
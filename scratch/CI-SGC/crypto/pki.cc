@@ -2,23 +2,110 @@
 
 #include "agka.h"
 
+PKI::~PKI()
+{
+    for (auto& chunk : chunks_)
+    {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
 bool
-PKI::Upload(uint32_t pk_id, SAAGKA::PublicKey pk)
+PKI::Upload(uint32_t pk_id, const SAAGKA::PublicKey& pk)
 {
-    if (bulletin_board_.find(pk_id) != bulletin_board_.end())
+    uint32_t chunk_index = pk_id >> ChunkBits;
+    if (chunk_index >= MaxChunks)
     {
         return false;
     }
-    bulletin_board_[pk_id] = pk;
+
+    Entry& entry = GetOrCreateChunk(chunk_index)[pk_id & (ChunkSize - 1)];
+    uint8_t expected = kEmpty;
+    if (!entry.state_.compare_exchange_strong(expected, kWriting, std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    entry.pk_.y1 = pk.y1;
+    entry.pk_.y2 = pk.y2;
+    SAAGKA::GetPublicParameter()->pfc->precomp_for_mult(entry.pk_.y2);
+
+    entry.state_.store(kReady, std::memory_order_release);
     return true;
 }
 
-SAAGKA::PublicKey
-PKI::Get(uint32_t pk_id)
+const SAAGKA::PublicKey&
+PKI::Get(uint32_t pk_id) const
+{
+    static const SAAGKA::PublicKey empty_pk;
+
+    const Entry* entry = FindEntry(pk_id);
+    return entry ? entry->pk_ : empty_pk;
+}
+
+void
+PKI::GetMany(std::span<const uint32_t> pk_ids, std::span<const SAAGKA::PublicKey*> out) const
 {
-    if (bulletin_board_.find(pk_id) == bulletin_board_.end())
+    // resolve all entries first, so the key data can be pulled in while we keep walking the ids
+    for (size_t i = 0; i < pk_ids.size(); i++)
     {
-        return SAAGKA::PublicKey();
+        const Entry* entry = FindEntry(pk_ids[i]);
+        if (entry)
+        {
+            __builtin_prefetch(&entry->pk_);
+        }
+        out[i] = entry ? &entry->pk_ : nullptr;
     }
-    return bulletin_board_[pk_id];
+}
+
+bool
+PKI::Contains(uint32_t pk_id) const
+{
+    return FindEntry(pk_id) != nullptr;
+}
+
+const PKI::Entry*
+PKI::FindEntry(uint32_t pk_id) const
+{
+    uint32_t chunk_index = pk_id >> ChunkBits;
+    if (chunk_index >= MaxChunks)
+    {
+        return nullptr;
+    }
+
+    const Entry* chunk = chunks_[chunk_index].load(std::memory_order_acquire);
+    if (!chunk)
+    {
+        return nullptr;
+    }
+
+    const Entry& entry = chunk[pk_id & (ChunkSize - 1)];
+    if (entry.state_.load(std::memory_order_acquire) != kReady)
+    {
+        return nullptr;
+    }
+    return &entry;
+}
+
+PKI::Entry*
+PKI::GetOrCreateChunk(uint32_t chunk_index)
+{
+    Entry* chunk = chunks_[chunk_index].load(std::memory_order_acquire);
+    if (chunk)
+    {
+        return chunk;
+    }
+
+    auto fresh = new Entry[ChunkSize];
+    if (chunks_[chunk_index].compare_exchange_strong(chunk,
+                                                     fresh,
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire))
+    {
+        return fresh;
+    }
+
+    // another thread installed the chunk first
+    delete[] fresh;
+    return chunk;
 }
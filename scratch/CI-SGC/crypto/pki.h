@@ -2,14 +2,62 @@
 
 #include "agka.h"
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
+// Append-only bulletin board of public keys, indexed densely by pk_id.
+//
+// Entries live in fixed-size chunks that are allocated on first use and never moved or freed
+// before the board is destroyed, so references returned by Get stay valid. Publishing an entry
+// and looking one up are lock-free: a chunk is installed with a CAS, and each entry carries a
+// state word that readers acquire before touching the key.
+//
+// Each entry keeps a fixed-base precomputation table for y2 (inside the G1 object), so that
+// pfc->mult(pk.y2, v) in CheckValid/UpdateKey/AckJoin can use it. Callers must hold a reference
+// to the stored key for this to apply; copying a G1 drops the table. The table is built in
+// Upload rather than on the first Get: readers share the entry without locking, and building
+// it in place would change y2 under them. KeyGen pays for it once per key; crypto-bench reports
+// the cost (PrecompY2) against what it saves per use (MultY2 vs. MultY2Precomp).
 class PKI
 {
   public:
-    bool Upload(uint32_t pk_id, SAAGKA::PublicKey pk);
-    SAAGKA::PublicKey Get(uint32_t pk_id);
+    PKI() = default;
+    ~PKI();
+    PKI(const PKI&) = delete;
+    PKI& operator=(const PKI&) = delete;
+
+    // Returns false if pk_id is out of range (see MaxChunks) or already taken.
+    bool Upload(uint32_t pk_id, const SAAGKA::PublicKey& pk);
+    // Returns an empty key if pk_id has not been uploaded.
+    const SAAGKA::PublicKey& Get(uint32_t pk_id) const;
+    // Look up several keys at once. out[i] is set to the key of pk_ids[i], or nullptr if it has
+    // not been uploaded. out must be at least as large as pk_ids.
+    void GetMany(std::span<const uint32_t> pk_ids, std::span<const SAAGKA::PublicKey*> out) const;
+    bool Contains(uint32_t pk_id) const;
 
   private:
-    std::unordered_map<uint32_t, SAAGKA::PublicKey> bulletin_board_;
+    enum EntryState : uint8_t
+    {
+        kEmpty,
+        kWriting,
+        kReady,
+    };
+
+    struct Entry
+    {
+        std::atomic<uint8_t> state_{kEmpty};
+        SAAGKA::PublicKey pk_;
+    };
+
+    static constexpr uint32_t ChunkBits = 8;
+    static constexpr uint32_t ChunkSize = 1u << ChunkBits;
+    static constexpr uint32_t MaxChunks = 1u << 12; // up to 1M keys
+
+    const Entry* FindEntry(uint32_t pk_id) const;
+    Entry* GetOrCreateChunk(uint32_t chunk_index);
+
+    std::array<std::atomic<Entry*>, MaxChunks> chunks_{};
 };
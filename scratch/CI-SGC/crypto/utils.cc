@@ -1,5 +1,6 @@
 #include "utils.h"
 
+#include <iomanip>
 #include <pairing_1.h>
 #include <sstream>
 
@@ -38,7 +39,7 @@ ToString(const GT& elem)
 }
 
 std::string
-ToString(const std::vector<uint8_t>& m)
+ToString(std::span<const uint8_t> m)
 {
     stringstream ss;
     ss << std::hex << std::setfill('0');
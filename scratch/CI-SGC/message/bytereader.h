@@ -121,6 +121,15 @@ struct ByteReadTrait<GT>
     }
 };
 
+template <>
+struct ByteReadTrait<Sid>
+{
+    static Sid read(ByteReader& r)
+    {
+        return Sid::FromBytes(r.readBytes(Sid::Length));
+    }
+};
+
 template <>
 struct ByteReadTrait<Big>
 {
@@ -143,8 +152,7 @@ struct ByteReadTrait<SAAGKA::KAMaterial>
         kam.size_param = r.read<uint32_t>();
         kam.pos = r.read<uint32_t>();
 
-        const uint8_t* sid_p = r.readBytes(SGC::SidLength);
-        kam.sid.insert(kam.sid.end(), sid_p, sid_p + SGC::SidLength);
+        kam.sid = r.read<Sid>();
 
         kam.u = r.read<G1>();
 
@@ -227,15 +235,16 @@ struct ByteReadTrait<SGC::GroupSessionInfo>
 
         gsi.n_member_ = r.read<uint32_t>();
 
-        const uint8_t* sid_p = r.readBytes(SGC::SidLength);
-        gsi.sid_.insert(gsi.sid_.end(), sid_p, sid_p + SGC::SidLength);
+        gsi.sid_ = r.read<Sid>();
         gsi.expiry_time_ = r.read<ns3::Time>();
 
         gsi.size_param_ = ParseSizeParamFromSid(gsi.sid_);
         auto scale = SAAGKA::GetPublicParameter()->matrices[gsi.size_param_].size();
-        size_t bm_size = ((scale + 63) / 64) * 8;
-        const uint8_t* bm_p = r.readBytes(bm_size);
-        gsi.mem_bitmap_.insert(gsi.mem_bitmap_.end(), bm_p, bm_p + bm_size);
+        gsi.mem_bitmap_ = MemberBitmap(scale);
+        for (size_t i = 0; i < gsi.mem_bitmap_.NumWords(); i++)
+        {
+            gsi.mem_bitmap_.SetWord(i, r.read<uint64_t>());
+        }
 
         gsi.ek_ = r.read<SAAGKA::EncryptionKey>();
 
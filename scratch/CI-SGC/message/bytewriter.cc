@@ -17,6 +17,21 @@ ByteWriter::write(const std::vector<uint8_t>& v)
     out_.insert(out_.end(), v.begin(), v.end());
 }
 
+void
+ByteWriter::write(const Sid& sid)
+{
+    write(sid.data(), sid.size());
+}
+
+void
+ByteWriter::write(const MemberBitmap& bm)
+{
+    for (size_t i = 0; i < bm.NumWords(); i++)
+    {
+        write(bm.GetWord(i));
+    }
+}
+
 void
 ByteWriter::write(const Big& b)
 {
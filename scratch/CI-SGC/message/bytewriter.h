@@ -33,6 +33,12 @@ class ByteWriter
     // std::vector<uint8_t>
     void write(const std::vector<uint8_t>& v);
 
+    // NOTE: fixed length, no length prefix
+    void write(const Sid& sid);
+
+    // NOTE: words are written big-endian, see member-bitmap.h
+    void write(const MemberBitmap& bm);
+
     // NOTE: total_lenth = length + 2B
     // -------------------------
     // | length (2B) | payload |
@@ -13,6 +13,8 @@ enum class MsgType : uint32_t
     kKeyEncap,
     kKeyUpdate,
     kKeyUpdateAck,
+    kKeyUpdateRequest,
+    kKeyUpdateGrant,
 
     kMsgTypeNum,
 };
@@ -52,6 +54,12 @@ operator<<(std::ostream& os, MsgType t)
     case MsgType::kKeyUpdateAck:
         os << "kKeyUpdateAck";
         break;
+    case MsgType::kKeyUpdateRequest:
+        os << "kKeyUpdateRequest";
+        break;
+    case MsgType::kKeyUpdateGrant:
+        os << "kKeyUpdateGrant";
+        break;
     default:
         os << "Unknown MsgType";
         break;
@@ -107,8 +107,7 @@ NotifyPosition::Serialize(ByteWriter& bw) const
 void
 NotifyPosition::Deserialize(ByteReader& br)
 {
-    const uint8_t* sid_p = br.readBytes(SGC::SidLength);
-    sid_ = std::vector<uint8_t>(sid_p, sid_p + SGC::SidLength);
+    sid_ = br.read<Sid>();
     pos_ = br.read<uint32_t>();
     pid_ = br.read<uint32_t>();
 }
@@ -156,9 +155,7 @@ JoinAck::Serialize(ByteWriter& bw) const
 void
 JoinAck::Deserialize(ByteReader& br)
 {
-    const uint8_t* sid_p = br.readBytes(SGC::SidLength);
-    sid_.clear();
-    sid_.insert(sid_.end(), sid_p, sid_p + SGC::SidLength);
+    sid_ = br.read<Sid>();
 
     pos_ = br.read<uint32_t>();
     pk_id_ = br.read<uint32_t>();
@@ -220,8 +217,7 @@ KeyEncap::Deserialize(ByteReader& br)
     kv_ = br.read<SGC::KeyVerifier>();
     for (size_t i = 0; i < group_num_; ++i)
     {
-        const uint8_t* sid_p = br.readBytes(SGC::SidLength);
-        sids_.emplace_back(sid_p, sid_p + SGC::SidLength);
+        sids_.push_back(br.read<Sid>());
     }
     ct_ = br.read<SAAGKA::Ciphertext>();
 }
@@ -256,8 +252,7 @@ KeyUpd::Deserialize(ByteReader& br)
     kv_ = br.read<SGC::KeyVerifier>();
     for (size_t i = 0; i < group_num_; ++i)
     {
-        const uint8_t* sid_p = br.readBytes(SGC::SidLength);
-        sids_.emplace_back(sid_p, sid_p + SGC::SidLength);
+        sids_.push_back(br.read<Sid>());
     }
     ct_ = br.read<SAAGKA::Ciphertext>();
 }
@@ -283,3 +278,64 @@ KeyUpdAck::Deserialize(ByteReader& br)
     pid_ = br.read<uint32_t>();
     kv_ = br.read<SGC::KeyVerifier>();
 }
+
+// KeyUpdRequest
+void
+KeyUpdRequest::Serialize(ByteWriter& bw) const
+{
+    Header header(MsgType::kKeyUpdateRequest);
+    bw.write(header);
+    size_t payload_start = bw.position();
+
+    bw.write(pid_);
+    bw.write(cur_key_version_);
+
+    header.payload_len_ = bw.position() - payload_start;
+    bw.patch_u32(payload_start - sizeof(uint32_t), header.payload_len_);
+}
+
+void
+KeyUpdRequest::Deserialize(ByteReader& br)
+{
+    pid_ = br.read<uint32_t>();
+    cur_key_version_ = br.read<uint32_t>();
+}
+
+std::string
+KeyUpdRequest::fmtString() const
+{
+    std::stringstream ss;
+    ss << "{pid_=" << pid_ << ", cur_key_version_=" << cur_key_version_ << "}";
+    return ss.str();
+}
+
+// KeyUpdGrant
+void
+KeyUpdGrant::Serialize(ByteWriter& bw) const
+{
+    Header header(MsgType::kKeyUpdateGrant);
+    bw.write(header);
+    size_t payload_start = bw.position();
+
+    bw.write(holder_pid_);
+    bw.write(lease_expiry_);
+
+    header.payload_len_ = bw.position() - payload_start;
+    bw.patch_u32(payload_start - sizeof(uint32_t), header.payload_len_);
+}
+
+void
+KeyUpdGrant::Deserialize(ByteReader& br)
+{
+    holder_pid_ = br.read<uint32_t>();
+    lease_expiry_ = br.read<ns3::Time>();
+}
+
+std::string
+KeyUpdGrant::fmtString() const
+{
+    std::stringstream ss;
+    ss << "{holder_pid_=" << holder_pid_ << ", lease_expiry_=" << lease_expiry_.As(ns3::Time::MS)
+       << "}";
+    return ss.str();
+}
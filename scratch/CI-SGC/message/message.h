@@ -8,6 +8,7 @@
 #include "bytewriter.h"
 
 #include <cstdint>
+#include <limits>
 #include <ostream>
 #include <vector>
 
@@ -51,7 +52,7 @@ class HeartbeatAck : public SGCMessage
 class NotifyPosition : public SGCMessage
 {
   public:
-    std::vector<uint8_t> sid_;
+    Sid sid_;
     uint32_t pos_;
     uint32_t pid_;
 
@@ -76,7 +77,7 @@ class Join : public SGCMessage
 class JoinAck : public SGCMessage
 {
   public:
-    std::vector<uint8_t> sid_;
+    Sid sid_;
     uint32_t pos_;
     uint32_t pk_id_;
     G1 d_;
@@ -114,7 +115,7 @@ class KeyEncap : public SGCMessage
   public:
     uint32_t group_num_;
     uint32_t pid_;
-    std::vector<std::vector<uint8_t>> sids_; // each corresponds to a (ct2, ct3) in ct_
+    std::vector<Sid> sids_; // each corresponds to a (ct2, ct3) in ct_
     SGC::KeyVerifier kv_;
     SAAGKA::Ciphertext ct_;
 
@@ -138,7 +139,7 @@ class KeyUpd : public SGCMessage
   public:
     uint32_t group_num_;
     uint32_t pid_;
-    std::vector<std::vector<uint8_t>> sids_; // each corresponds to a (ct2, ct3) in ct_
+    std::vector<Sid> sids_; // each corresponds to a (ct2, ct3) in ct_
     SGC::KeyVerifier kv_;
     SAAGKA::Ciphertext ct_;
 
@@ -169,3 +170,34 @@ class KeyUpdAck : public SGCMessage
     void Serialize(ByteWriter& bw) const override;
     void Deserialize(ByteReader& br) override;
 };
+
+// vehicle -> RSU: ask for the right to launch a session key update
+class KeyUpdRequest : public SGCMessage
+{
+  public:
+    uint32_t pid_;
+    uint32_t cur_key_version_;
+
+    KeyUpdRequest() = default;
+
+    void Serialize(ByteWriter& bw) const override;
+    void Deserialize(ByteReader& br) override;
+    std::string fmtString() const override;
+};
+
+// RSU -> vehicles: the current key update lease. Vehicles other than holder_pid_ that are waiting
+// for a lease treat their request as coalesced into this one.
+class KeyUpdGrant : public SGCMessage
+{
+  public:
+    const static uint32_t NoHolder = std::numeric_limits<uint32_t>::max();
+
+    uint32_t holder_pid_{NoHolder}; // NoHolder if no lease could be granted
+    ns3::Time lease_expiry_;        // without holder: earliest time to ask again
+
+    KeyUpdGrant() = default;
+
+    void Serialize(ByteWriter& bw) const override;
+    void Deserialize(ByteReader& br) override;
+    std::string fmtString() const override;
+};
@@ -16,6 +16,7 @@
 
 Metric::Metric()
     : event_counter_((size_t)EmitType::kTypeNum, 0),
+      counters_((size_t)CountType::kCountTypeNum, 0),
       once_flags_((size_t)MsgType::kMsgTypeNum)
 {
     auto real_time_evts_num = static_cast<size_t>(EmitType::kRealTimeEvtsNum);
@@ -94,6 +95,18 @@ Metric::Cancel(EmitType type, std::string key)
     }
 }
 
+void
+Metric::Count(CountType type)
+{
+    counters_[(size_t)type]++;
+}
+
+uint64_t
+Metric::GetCount(CountType type) const
+{
+    return counters_[(size_t)type];
+}
+
 // Metric::Microseconds
 // Metric::GetStat(EmitType type, std::string key)
 // {
@@ -160,6 +173,18 @@ Metric::Summarize()
         std::cout << "\t\t\tAvg:" << total.GetMicroSeconds() / st.size() << " us\n\n";
     }
 
+    std::cout << "\tCounters:" << std::endl;
+    for (size_t i = 0; i < counters_.size(); i++)
+    {
+        std::cout << "\t\t" << CountType(i) << ":" << counters_[i] << std::endl;
+    }
+    auto n_encrypt = GetCount(CountType::kKeyUpdEncrypt);
+    if (n_encrypt > 0)
+    {
+        std::cout << "\t\tKey update rejected work ratio:"
+                  << static_cast<double>(GetCount(CountType::kKeyUpdReject)) / n_encrypt << "\n\n";
+    }
+
     std::cout << "\tMsg Size:" << std::endl;
     for (auto& p : msg_size_)
     {
@@ -91,6 +91,53 @@ operator<<(std::ostream& os, EmitType type)
     return os;
 }
 
+// plain event counters, not timed
+enum class CountType
+{
+    kKeyUpdRequest,  // vehicle asked RSU for a key update lease
+    kKeyUpdGrant,    // RSU granted a lease
+    kKeyUpdCoalesce, // request absorbed by a lease held by another vehicle
+    kKeyUpdDeny,     // request denied, key updated too recently
+    kKeyUpdEncrypt,  // vehicle ran SAAGKA::Encrypt for a key update
+    kKeyUpdAccept,   // RSU accepted a key update
+    kKeyUpdReject,   // RSU rejected a key update, i.e. the Encrypt was wasted
+
+    kCountTypeNum,
+};
+
+inline std::ostream&
+operator<<(std::ostream& os, CountType type)
+{
+    switch (type)
+    {
+    case CountType::kKeyUpdRequest:
+        os << "kKeyUpdRequest";
+        break;
+    case CountType::kKeyUpdGrant:
+        os << "kKeyUpdGrant";
+        break;
+    case CountType::kKeyUpdCoalesce:
+        os << "kKeyUpdCoalesce";
+        break;
+    case CountType::kKeyUpdDeny:
+        os << "kKeyUpdDeny";
+        break;
+    case CountType::kKeyUpdEncrypt:
+        os << "kKeyUpdEncrypt";
+        break;
+    case CountType::kKeyUpdAccept:
+        os << "kKeyUpdAccept";
+        break;
+    case CountType::kKeyUpdReject:
+        os << "kKeyUpdReject";
+        break;
+    default:
+        os << "Unknown CountType";
+        break;
+    }
+    return os;
+}
+
 const std::unordered_map<EmitType, int> TotalPhaseNum = {
     {EmitType::kComputeSetup, 2},
     {EmitType::kComputeKeyGen, 2},
@@ -131,6 +178,8 @@ class Metric
     void Emit(MsgType type, int size);
     bool TryEmit(EmitType type, std::string key);
     void Cancel(EmitType type, std::string key);
+    void Count(CountType type);
+    uint64_t GetCount(CountType type) const;
     void Summarize();
 
     // Generate a new stat key
@@ -151,6 +200,7 @@ class Metric
     std::vector<uint> event_counter_;
     std::set<std::string> cancelled_keys_;
 
+    std::vector<uint64_t> counters_;
     std::map<MsgType, int> msg_size_;
     std::vector<std::once_flag> once_flags_;
 };
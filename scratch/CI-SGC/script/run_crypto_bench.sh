@@ -0,0 +1,34 @@
+#!/usr/bin/env bash
+
+set -euo pipefail
+
+BIN=./build/scratch/CI-SGC/ns3-dev-ci-sgc-crypto-bench-default
+OUT_DIR=./scratch/CI-SGC/log
+OUT_FILE=${OUT_DIR}/crypto_bench.csv
+
+mkdir -p ${OUT_DIR}
+rm -f ${OUT_FILE}
+
+for SECURITY_LEVEL in 80 128; do
+    echo "Running crypto benchmark, securityLevel=${SECURITY_LEVEL}"
+
+    TMP_FILE=${OUT_DIR}/crypto_bench_security${SECURITY_LEVEL}.csv
+    ${BIN} \
+        --securityLevel=${SECURITY_LEVEL} \
+        --minGroupSize=10 \
+        --maxGroupSize=100 \
+        --groupSizeStep=10 \
+        --maxEncryptGroups=5 \
+        --warmup=3 \
+        --reps=20 \
+        --out=${TMP_FILE}
+
+    # keep a single header line
+    if [ -f ${OUT_FILE} ]; then
+        tail -n +2 ${TMP_FILE} >> ${OUT_FILE}
+    else
+        cp ${TMP_FILE} ${OUT_FILE}
+    fi
+done
+
+echo "Results written to ${OUT_FILE}"
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Occupancy bitmap of the member slots of one group.
+//
+// Slots are packed into 64-bit words. Slot i lives in word i / 64 at bit (63 - i % 64), i.e. the
+// most significant bit of a word is the lowest slot. Writing the words big-endian therefore
+// yields the same byte layout as a byte array with mask (0x80 >> (i % 8)), which is the wire
+// format of the heartbeat.
+class MemberBitmap
+{
+  public:
+    static constexpr uint32_t WordBits = 64;
+
+    MemberBitmap() = default;
+
+    explicit MemberBitmap(uint32_t n_slot)
+        : n_slot_(n_slot),
+          words_((n_slot + WordBits - 1) / WordBits, 0)
+    {
+    }
+
+    uint32_t NumSlots() const
+    {
+        return n_slot_;
+    }
+
+    size_t NumWords() const
+    {
+        return words_.size();
+    }
+
+    // size of the serialized bitmap in bytes
+    size_t ByteSize() const
+    {
+        return words_.size() * sizeof(uint64_t);
+    }
+
+    uint64_t GetWord(size_t i) const
+    {
+        return words_[i];
+    }
+
+    void SetWord(size_t i, uint64_t w)
+    {
+        words_[i] = w;
+    }
+
+    bool Test(uint32_t pos) const
+    {
+        return (words_[pos / WordBits] & Mask(pos)) != 0;
+    }
+
+    void Set(uint32_t pos)
+    {
+        words_[pos / WordBits] |= Mask(pos);
+    }
+
+    void Reset(uint32_t pos)
+    {
+        words_[pos / WordBits] &= ~Mask(pos);
+    }
+
+    // number of occupied slots
+    uint32_t Count() const
+    {
+        uint32_t n = 0;
+        for (auto w : words_)
+        {
+            n += std::popcount(w);
+        }
+        return n;
+    }
+
+    // Call f(pos) for every occupied slot, in ascending order.
+    template <typename F>
+    void ForEachSet(F&& f) const
+    {
+        for (size_t i = 0; i < words_.size(); ++i)
+        {
+            VisitWord(words_[i], i, f);
+        }
+    }
+
+    // Slots whose occupancy differs between this bitmap and other, in ascending order.
+    std::vector<uint32_t> Diff(const MemberBitmap& other) const
+    {
+        std::vector<uint32_t> diff;
+        size_t n = std::min(words_.size(), other.words_.size());
+        for (size_t i = 0; i < n; ++i)
+        {
+            VisitWord(words_[i] ^ other.words_[i], i, [&diff](uint32_t pos) {
+                diff.push_back(pos);
+            });
+        }
+        return diff;
+    }
+
+    friend bool operator==(const MemberBitmap& a, const MemberBitmap& b)
+    {
+        return a.n_slot_ == b.n_slot_ && a.words_ == b.words_;
+    }
+
+  private:
+    static uint64_t Mask(uint32_t pos)
+    {
+        return uint64_t{1} << (WordBits - 1 - pos % WordBits);
+    }
+
+    // Visit the set bits of w, the word at index word_index, from the lowest slot upwards.
+    template <typename F>
+    void VisitWord(uint64_t w, size_t word_index, F&& f) const
+    {
+        uint32_t base = word_index * WordBits;
+        while (w)
+        {
+            uint32_t pos = base + std::countl_zero(w);
+            if (pos >= n_slot_)
+            {
+                return;
+            }
+            f(pos);
+            w &= ~Mask(pos);
+        }
+    }
+
+    uint32_t n_slot_{0};
+    std::vector<uint64_t> words_;
+};
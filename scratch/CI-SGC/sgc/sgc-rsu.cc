@@ -28,10 +28,11 @@
 
 uint32_t SGCRSU::group_seq_ = 0;
 
-SGCRSU::SGCRSU(int size, int max_group_num, ns3::Time key_upd_threshold)
+SGCRSU::SGCRSU(int size, int max_group_num, ns3::Time key_upd_threshold, ns3::Time key_upd_lease)
     : state_(State::kIdle),
       max_group_num_(max_group_num),
-      key_upd_threshold_(key_upd_threshold)
+      key_upd_threshold_(key_upd_threshold),
+      key_upd_lease_(key_upd_lease)
 {
     auto pp = SAAGKA::GetPublicParameter();
     for (size_t i = 0; i < pp->matrices.size(); i++)
@@ -155,14 +156,25 @@ SGCRSU::HandleMsg(const uint8_t* bytes, size_t len)
     case MsgType::kKeyUpdate: {
         auto key_upd_msg = std::make_shared<KeyUpd>();
         key_upd_msg->Deserialize(br);
-        resp.push_back(key_upd_msg);
         auto upd_resp = HandleKeyUpd(key_upd_msg);
+        // only relay updates that were accepted
         if (upd_resp)
         {
+            resp.push_back(key_upd_msg);
             resp.push_back(upd_resp);
         }
     }
     break;
+    case MsgType::kKeyUpdateRequest: {
+        auto req_msg = std::make_shared<KeyUpdRequest>();
+        req_msg->Deserialize(br);
+        auto grant = HandleKeyUpdRequest(req_msg);
+        if (grant)
+        {
+            resp.push_back(grant);
+        }
+    }
+    break;
 
     default:
         // INFO("RSU receives unknown message type: " << header.type_);
@@ -280,7 +292,7 @@ SGCRSU::AckJoin(std::shared_ptr<SGCMessage> join_msg)
     auto& matrix = pp->matrices[kam.size_param];
     auto pfc = pp->pfc;
 
-    auto pk = ns3::Singleton<PKI>::Get()->Get(kam.pk_id);
+    const auto& pk = ns3::Singleton<PKI>::Get()->Get(kam.pk_id);
     auto pseudo_pk = SAAGKA::PublicKey{matrix[kam.pos][scale + 1], matrix[kam.pos][scale + 2]};
     Big v = SAAGKA::HashAnyToBig(kam.sid, pk, kam.u);
     Big pseudo_v = SAAGKA::HashAnyToBig(std::vector<uint8_t>(), pseudo_pk, matrix[kam.pos][scale]);
@@ -394,21 +406,26 @@ SGCRSU::HandleKeyUpd(std::shared_ptr<SGCMessage> upd_msg)
         FATAL_ERROR("Unexpcted downcast error");
     }
 
+    auto metric = ns3::Singleton<Metric>::Get();
     auto now = ns3::Simulator::Now();
     if (cur_kv_.version_ >= upd->kv_.version_ || upd->kv_.timestamp_ + ns3::Seconds(1) < now)
     {
+        metric->Count(CountType::kKeyUpdReject);
         WARN("RSU rejects update from Vehicle-" << upd->pid_ << ", reason=stale key");
         return nullptr;
     }
-    if (now - last_key_upd_time_ < key_upd_threshold_)
+    if (lease_holder_ != static_cast<int>(upd->pid_) || lease_expiry_ < now)
     {
-        WARN("RSU rejects update from Vehicle-" << upd->pid_ << ", reason=key update too frequent");
+        metric->Count(CountType::kKeyUpdReject);
+        WARN("RSU rejects update from Vehicle-" << upd->pid_ << ", reason=no lease");
         return nullptr;
     }
 
     INFO("RSU accept key verifier (UPDATE), kv=" << upd->kv_ << ", from=Vehicle-" << upd->pid_);
+    metric->Count(CountType::kKeyUpdAccept);
     cur_kv_ = upd->kv_;
     last_key_upd_time_ = now;
+    lease_holder_ = -1;
 
     auto upd_ack = std::make_shared<KeyUpdAck>();
     upd_ack->kv_ = upd->kv_;
@@ -416,6 +433,47 @@ SGCRSU::HandleKeyUpd(std::shared_ptr<SGCMessage> upd_msg)
     return upd_ack;
 }
 
+std::shared_ptr<SGCMessage>
+SGCRSU::HandleKeyUpdRequest(std::shared_ptr<SGCMessage> req_msg)
+{
+    auto req = std::dynamic_pointer_cast<KeyUpdRequest>(req_msg);
+    if (!req)
+    {
+        FATAL_ERROR("Unexpcted downcast error");
+    }
+
+    auto metric = ns3::Singleton<Metric>::Get();
+    auto now = ns3::Simulator::Now();
+    auto grant = std::make_shared<KeyUpdGrant>();
+
+    if (lease_holder_ != -1 && now <= lease_expiry_)
+    {
+        // a key update is already on its way, the requester will receive it as well
+        metric->Count(CountType::kKeyUpdCoalesce);
+        grant->holder_pid_ = lease_holder_;
+        grant->lease_expiry_ = lease_expiry_;
+        return grant;
+    }
+    lease_holder_ = -1;
+
+    if (now - last_key_upd_time_ < key_upd_threshold_)
+    {
+        metric->Count(CountType::kKeyUpdDeny);
+        grant->lease_expiry_ = last_key_upd_time_ + key_upd_threshold_;
+        return grant;
+    }
+
+    metric->Count(CountType::kKeyUpdGrant);
+    lease_holder_ = req->pid_;
+    lease_expiry_ = now + key_upd_lease_;
+    grant->holder_pid_ = req->pid_;
+    grant->lease_expiry_ = lease_expiry_;
+
+    INFO("RSU grants key update lease to Vehicle-" << req->pid_ << ", expiry="
+                                                    << lease_expiry_.As(ns3::Time::MS));
+    return grant;
+}
+
 void
 SGCRSU::LazyDropVehicleInfo(ns3::Time timeout)
 {
@@ -23,7 +23,7 @@ class SGCRSU : public SGC
         std::multimap<ns3::Time, uint32_t>::iterator time_it_;
     };
 
-    SGCRSU(int size, int max_group_num, ns3::Time key_upd_threshold);
+    SGCRSU(int size, int max_group_num, ns3::Time key_upd_threshold, ns3::Time key_upd_lease);
     virtual ~SGCRSU();
 
     std::vector<std::shared_ptr<SGCMessage>> HandleMsg(const uint8_t* bytes, size_t len) override;
@@ -34,6 +34,7 @@ class SGCRSU : public SGC
     std::shared_ptr<SGCMessage> NotifyKeyEncap();
     void HandleKeyEncap(std::shared_ptr<SGCMessage> encap_msg); // RSU handle
     std::shared_ptr<SGCMessage> HandleKeyUpd(std::shared_ptr<SGCMessage> upd_msg);
+    std::shared_ptr<SGCMessage> HandleKeyUpdRequest(std::shared_ptr<SGCMessage> req_msg);
 
   private:
     void LazyDropVehicleInfo(ns3::Time timeout);
@@ -54,6 +55,11 @@ class SGCRSU : public SGC
     ns3::Time key_upd_threshold_;
     ns3::Time last_key_upd_time_{ns3::Seconds(0)};
 
+    // key update lease: only the holder may launch a key update until the lease expires
+    int lease_holder_{-1};
+    ns3::Time lease_expiry_{ns3::Seconds(0)};
+    ns3::Time key_upd_lease_;
+
     // for metric
     std::string metric_join_commu_key_;
 };
@@ -11,6 +11,7 @@
 
 #include "ns3/singleton.h"
 
+#include <algorithm>
 #include <big.h>
 #include <chrono>
 #include <cstddef>
@@ -30,7 +31,8 @@ uint32_t SGCVehicle::user_seq_ = 0;
 SGCVehicle::SGCVehicle()
     : state_(State::kPrepare),
       pid_(user_seq_++),
-      ka_proto_(std::make_shared<SAAGKA>())
+      ka_proto_(std::make_shared<SAAGKA>()),
+      upd_backoff_jitter_(ns3::CreateObject<ns3::UniformRandomVariable>())
 {
 }
 
@@ -127,6 +129,17 @@ SGCVehicle::HandleMsg(const uint8_t* bytes, size_t len)
     }
     break;
 
+    case MsgType::kKeyUpdateGrant: {
+        auto grant_msg = std::make_shared<KeyUpdGrant>();
+        grant_msg->Deserialize(br);
+        auto upd = HandleKeyUpdGrant(grant_msg);
+        if (upd)
+        {
+            resp.push_back(upd);
+        }
+    }
+    break;
+
     default:
         // INFO("Vehicle-" << pid_ << " receives unknown message type: " << header.type_);
         break;
@@ -162,7 +175,7 @@ SGCVehicle::HandleHeartbeat(std::shared_ptr<SGCMessage> hb_msg)
 
         if (it->second->n_member_ < gsi.n_member_)
         {
-            if (sid_.size() > 0 && IsEqual(it->second->sid_, sid_) && state_ == State::kJoined)
+            if (!sid_.IsEmpty() && it->second->sid_ == sid_ && state_ == State::kJoined)
             {
                 int n_slot = SAAGKA::GetPublicParameter()->matrices[gsi.size_param_].size();
                 auto diff = SlotDiff(gsi.mem_bitmap_, it->second->mem_bitmap_, n_slot);
@@ -240,7 +253,7 @@ SGCVehicle::HandleJoin(std::shared_ptr<SGCMessage> join_msg)
         FATAL_ERROR("Unexpcted downcast error");
     }
 
-    if (state_ != State::kJoined || !IsEqual(sid_, join->kam_.sid) ||
+    if (state_ != State::kJoined || sid_ != join->kam_.sid ||
         IsPositionOccupied(sid_, join->kam_.pos))
     {
         return;
@@ -282,7 +295,7 @@ SGCVehicle::HandleJoinAck(std::shared_ptr<SGCMessage> join_ack_msg)
         FATAL_ERROR("Unexpcted downcast error");
     }
 
-    if (!IsEqual(join_ack->sid_, sid_) || join_ack->pos_ != pos_ || state_ != State::kJoining)
+    if (join_ack->sid_ != sid_ || join_ack->pos_ != pos_ || state_ != State::kJoining)
     {
         return;
     }
@@ -431,6 +444,7 @@ SGCVehicle::LaunchKeyUpdate(uint32_t key_length)
         eks.push_back(gsi_p->ek_);
     }
     upd->ct_ = SAAGKA::Encrypt(key, eks);
+    metric->Count(CountType::kKeyUpdEncrypt);
 
     // set to pending list
     if (pending_kvs_.find(kv.version_) == pending_kvs_.end())
@@ -457,6 +471,64 @@ SGCVehicle::LaunchKeyUpdate(uint32_t key_length)
     return upd;
 }
 
+std::shared_ptr<SGCMessage>
+SGCVehicle::RequestKeyUpdate(uint32_t key_length)
+{
+    auto now = ns3::Simulator::Now();
+    if (state_ != State::kJoined || now < upd_backoff_until_)
+    {
+        return nullptr;
+    }
+    // the request or its grant may have been lost
+    if (upd_req_pending_ && now - upd_req_time_ < ns3::Seconds(1))
+    {
+        return nullptr;
+    }
+
+    upd_req_pending_ = true;
+    upd_req_time_ = now;
+    upd_key_length_ = key_length;
+    ns3::Singleton<Metric>::Get()->Count(CountType::kKeyUpdRequest);
+
+    auto req = std::make_shared<KeyUpdRequest>();
+    req->pid_ = pid_;
+    req->cur_key_version_ = cur_kv_.version_;
+    return req;
+}
+
+std::shared_ptr<SGCMessage>
+SGCVehicle::HandleKeyUpdGrant(std::shared_ptr<SGCMessage> grant_msg)
+{
+    auto grant = std::dynamic_pointer_cast<KeyUpdGrant>(grant_msg);
+    if (!grant)
+    {
+        FATAL_ERROR("Unexpcted downcast error");
+    }
+    if (!upd_req_pending_)
+    {
+        // someone else is rekeying, no point in asking before that is done
+        upd_backoff_until_ = std::max(upd_backoff_until_, grant->lease_expiry_);
+        return nullptr;
+    }
+
+    if (grant->holder_pid_ == pid_)
+    {
+        upd_req_pending_ = false;
+        upd_backoff_exp_ = 0;
+        return LaunchKeyUpdate(upd_key_length_);
+    }
+
+    // Either another vehicle holds the lease, and its update covers our request, or the key was
+    // updated too recently. Back off until the lease expires, plus a random jitter that grows
+    // with repeated misses so that the retries of waiting vehicles spread out.
+    upd_req_pending_ = false;
+    uint32_t jitter_window = 100 << std::min(upd_backoff_exp_, 4u);
+    auto jitter = ns3::MilliSeconds(upd_backoff_jitter_->GetInteger(0, jitter_window - 1));
+    upd_backoff_until_ = grant->lease_expiry_ + jitter;
+    upd_backoff_exp_++;
+    return nullptr;
+}
+
 void
 SGCVehicle::DecapsulateKey(std::shared_ptr<SGCMessage> encap_msg)
 {
@@ -495,7 +567,7 @@ SGCVehicle::DecapsulateKey(std::shared_ptr<SGCMessage> encap_msg)
     uint32_t index = -1;
     for (size_t i = 0; i < encap->sids_.size(); i++)
     {
-        if (IsEqual(encap->sids_[i], sid_))
+        if (encap->sids_[i] == sid_)
         {
             index = i;
             break;
@@ -600,7 +672,7 @@ SGCVehicle::HandleKeyUpd(std::shared_ptr<SGCMessage> upd_msg)
     uint32_t index = -1;
     for (size_t i = 0; i < upd->sids_.size(); i++)
     {
-        if (IsEqual(upd->sids_[i], sid_))
+        if (upd->sids_[i] == sid_)
         {
             index = i;
             break;
@@ -716,6 +788,13 @@ SGCVehicle::GetPid() const
     return pid_;
 }
 
+int64_t
+SGCVehicle::AssignStreams(int64_t stream)
+{
+    upd_backoff_jitter_->SetStream(stream);
+    return 1;
+}
+
 void
 SGCVehicle::TryUpdateSessionKey(const KeyVerifier& kv)
 {
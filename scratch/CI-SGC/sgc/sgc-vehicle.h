@@ -2,6 +2,8 @@
 
 #include "sgc.h"
 
+#include "ns3/random-variable-stream.h"
+
 #include <cstdint>
 #include <memory>
 
@@ -28,11 +30,16 @@ class SGCVehicle : public SGC
     void HandleJoinAck(std::shared_ptr<SGCMessage> join_ack_msg);
     std::shared_ptr<SGCMessage> EncapsulateKey(std::shared_ptr<SGCMessage> encap_ntf_msg);
     std::shared_ptr<SGCMessage> LaunchKeyUpdate(uint32_t key_length);
+    // Ask RSU for a key update lease. Returns nullptr if no request should be sent now.
+    std::shared_ptr<SGCMessage> RequestKeyUpdate(uint32_t key_length);
+    std::shared_ptr<SGCMessage> HandleKeyUpdGrant(std::shared_ptr<SGCMessage> grant_msg);
     void DecapsulateKey(std::shared_ptr<SGCMessage> encap_msg); // vehicle handle
     void HandleKeyUpd(std::shared_ptr<SGCMessage> upd_msg);
     void HandleKeyUpdAck(std::shared_ptr<SGCMessage> ack_msg);
 
     uint32_t GetPid() const;
+    // Use fixed random variable streams for the backoff jitter. Returns the number of streams.
+    int64_t AssignStreams(int64_t stream);
 
     // int ParseSid(std::vector<uint8_t> sid);
 
@@ -46,7 +53,7 @@ class SGCVehicle : public SGC
     State state_;
     uint32_t pid_;
     uint32_t pos_;
-    std::vector<uint8_t> sid_; // the group session that node belongs to
+    Sid sid_; // the group session that node belongs to
     std::shared_ptr<SAAGKA> ka_proto_;
     KeyVerifier cur_kv_;
     std::vector<uint8_t> cur_session_key_;
@@ -55,6 +62,14 @@ class SGCVehicle : public SGC
     std::unordered_map<uint32_t, std::vector<KeyTuple>> pending_kvs_;
     std::set<uint32_t> gap_positions_;
 
+    // key update lease request
+    bool upd_req_pending_{false};
+    ns3::Time upd_req_time_;
+    uint32_t upd_key_length_{0};
+    ns3::Time upd_backoff_until_{ns3::Seconds(0)};
+    uint32_t upd_backoff_exp_{0};
+    ns3::Ptr<ns3::UniformRandomVariable> upd_backoff_jitter_;
+
     // for metric
     std::string metric_join_commu_key_;
 };
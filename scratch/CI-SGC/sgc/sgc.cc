@@ -24,7 +24,6 @@
 #include <sys/resource.h>
 #include <vector>
 
-const int SGC::SidLength = 16;
 const int SGC::KeyVerifierLength = sizeof(uint32_t) + sizeof(uint64_t) + 32;
 
 std::vector<std::shared_ptr<SGCMessage>>
@@ -35,21 +34,17 @@ SGC::HandleMsg(const uint8_t* bytes, size_t len)
 }
 
 bool
-SGC::IsPositionOccupied(std::vector<uint8_t> sid, uint32_t pos) const
+SGC::IsPositionOccupied(std::span<const uint8_t, SidLength> sid, uint32_t pos) const
 {
-    auto gsi_p = gsis_.find(ParseGroupSeqFromSid(sid))->second;
-    size_t index = pos / 8;
-    uint8_t mask = 0x80 >> (pos % 8);
-    return (gsi_p->mem_bitmap_[index] & mask) != 0;
+    const auto& gsi_p = gsis_.find(ParseGroupSeqFromSid(sid))->second;
+    return gsi_p->mem_bitmap_.Test(pos);
 }
 
 void
-SGC::OccupyOnePosition(std::vector<uint8_t> sid, uint32_t pos)
+SGC::OccupyOnePosition(std::span<const uint8_t, SidLength> sid, uint32_t pos)
 {
-    auto gsi_p = gsis_.find(ParseGroupSeqFromSid(sid))->second;
-    size_t index = pos / 8;
-    uint8_t mask = 0x80 >> (pos % 8);
-    gsi_p->mem_bitmap_[index] |= mask;
+    const auto& gsi_p = gsis_.find(ParseGroupSeqFromSid(sid))->second;
+    gsi_p->mem_bitmap_.Set(pos);
 }
 
 // GroupSessionInfo
@@ -61,19 +56,10 @@ SGC::GroupSessionInfo::GroupSessionInfo(uint16_t seq, uint16_t size_param)
     auto pp = SAAGKA::GetPublicParameter();
     int scale = pp->matrices[size_param_].size();
 
-    size_t bm_size = ((scale + 63) / 64) * 8;
-    mem_bitmap_ = std::vector<uint8_t>(bm_size, 0);
+    mem_bitmap_ = MemberBitmap(scale);
 
     expiry_time_ = ns3::Simulator::Now() + ns3::Seconds(60);
-
-    // construct sid
-    sid_ = std::vector<uint8_t>();
-    ByteWriter bw(sid_);
-
-    bw.write("SID-");
-    bw.write(seq);
-    bw.write(size_param);
-    bw.write(expiry_time_);
+    sid_ = Sid(seq, size_param, expiry_time_);
 
     auto& matrix = pp->matrices[size_param_];
     d_.resize(scale);
@@ -87,7 +73,7 @@ SGC::GroupSessionInfo::GroupSessionInfo(uint16_t seq, uint16_t size_param)
     tmp.g.clear();
     for (int i = 0; i < scale; i++)
     {
-        auto v = SAAGKA::HashAnyToBig(std::vector<uint8_t>(),
+        auto v = SAAGKA::HashAnyToBig({},
                                       SAAGKA::PublicKey{matrix[i][scale + 1], matrix[i][scale + 2]},
                                       matrix[i][scale]);
         int j = 0;
@@ -110,9 +96,9 @@ SGC::GroupSessionInfo::GroupSessionInfo(uint16_t seq, uint16_t size_param)
 SGC::GroupSessionInfo::GroupSessionInfo(const GroupSessionInfo& gsi)
     : size_param_(gsi.size_param_),
       n_member_(gsi.n_member_),
+      sid_(gsi.sid_),
+      mem_bitmap_(gsi.mem_bitmap_),
       ek_(gsi.ek_),
       expiry_time_(gsi.expiry_time_)
 {
-    sid_.insert(sid_.end(), gsi.sid_.begin(), gsi.sid_.end());
-    mem_bitmap_.insert(mem_bitmap_.end(), gsi.mem_bitmap_.begin(), gsi.mem_bitmap_.end());
 }
@@ -2,6 +2,8 @@
 
 #include "../crypto/agka.h"
 #include "../crypto/utils.h"
+#include "member-bitmap.h"
+#include "sid.h"
 
 #include "ns3/nstime.h"
 
@@ -10,6 +12,7 @@
 #include <cstdint>
 #include <memory>
 #include <ostream>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
@@ -24,13 +27,9 @@ class SGC
         uint32_t size_param_;
         uint32_t n_member_;
 
-        // sid format:
-        // ---------------------------------------------------------------------------
-        // | prefix (4B) | sequence number (2B) | size_param (2B) | expiry time (8B) |
-        // ---------------------------------------------------------------------------
-        std::vector<uint8_t> sid_;
+        Sid sid_; // see sid.h for the format
 
-        std::vector<uint8_t> mem_bitmap_;
+        MemberBitmap mem_bitmap_;
 
         SAAGKA::EncryptionKey ek_;
         ns3::Time expiry_time_;
@@ -82,14 +81,14 @@ class SGC
     };
 
     const static int KeyVerifierLength;
-    const static int SidLength;
+    static constexpr size_t SidLength = Sid::Length;
 
     SGC() = default;
     virtual ~SGC() = default;
 
     virtual std::vector<std::shared_ptr<SGCMessage>> HandleMsg(const uint8_t* bytes, size_t len);
-    bool IsPositionOccupied(std::vector<uint8_t> sid, uint32_t pos) const;
-    void OccupyOnePosition(std::vector<uint8_t> sid, uint32_t pos);
+    bool IsPositionOccupied(std::span<const uint8_t, SidLength> sid, uint32_t pos) const;
+    void OccupyOnePosition(std::span<const uint8_t, SidLength> sid, uint32_t pos);
 
   private:
   protected:
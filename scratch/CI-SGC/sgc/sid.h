@@ -0,0 +1,110 @@
+#pragma once
+
+#include "ns3/nstime.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+// Fixed-size group session identifier.
+//
+// sid format:
+// ---------------------------------------------------------------------------
+// | prefix (4B) | sequence number (2B) | size_param (2B) | expiry time (8B) |
+// ---------------------------------------------------------------------------
+//
+// The bytes are kept inline so that a Sid can be copied and compared without touching the heap.
+// Comparison is done on two 64-bit words.
+class Sid
+{
+  public:
+    static constexpr size_t Length = 16;
+    using Span = std::span<const uint8_t, Length>;
+
+    Sid()
+        : bytes_{}
+    {
+    }
+
+    Sid(uint16_t seq, uint16_t size_param, ns3::Time expiry_time)
+    {
+        std::memcpy(bytes_.data(), "SID-", 4);
+        Store(4, seq);
+        Store(6, size_param);
+        Store(8, static_cast<uint64_t>(expiry_time.GetNanoSeconds()));
+    }
+
+    static Sid FromBytes(const uint8_t* data)
+    {
+        Sid sid;
+        std::memcpy(sid.bytes_.data(), data, Length);
+        return sid;
+    }
+
+    const uint8_t* data() const
+    {
+        return bytes_.data();
+    }
+
+    static constexpr size_t size()
+    {
+        return Length;
+    }
+
+    const uint8_t* begin() const
+    {
+        return bytes_.data();
+    }
+
+    const uint8_t* end() const
+    {
+        return bytes_.data() + Length;
+    }
+
+    Span Bytes() const
+    {
+        return Span(bytes_);
+    }
+
+    operator Span() const
+    {
+        return Bytes();
+    }
+
+    // A default-constructed sid is all zero and never names a group.
+    bool IsEmpty() const
+    {
+        return Word(0) == 0 && Word(1) == 0;
+    }
+
+    friend bool operator==(const Sid& a, const Sid& b)
+    {
+        return a.Word(0) == b.Word(0) && a.Word(1) == b.Word(1);
+    }
+
+    friend bool operator!=(const Sid& a, const Sid& b)
+    {
+        return !(a == b);
+    }
+
+  private:
+    uint64_t Word(size_t i) const
+    {
+        uint64_t w;
+        std::memcpy(&w, bytes_.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+        return w;
+    }
+
+    template <typename T>
+    void Store(size_t offset, T v)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            bytes_[offset + i] = static_cast<uint8_t>((v >> (8 * (sizeof(T) - 1 - i))) & 0xff);
+        }
+    }
+
+    std::array<uint8_t, Length> bytes_;
+};
@@ -55,6 +55,8 @@ main(int argc, char* argv[])
     uint32_t keyEncapInterval = 3000;
     uint32_t KeyUpdInterval = 2000;
     uint32_t KeyUpdThreshold = 2000;
+    uint32_t KeyUpdLease = 500;
+    std::string logFile;
     CommandLine cmd(__FILE__);
     cmd.AddValue("nVehicle", "Number of vehicle nodes", nVehicle);
     cmd.AddValue("maxVelocity", "Maximum velocity of vehicle nodes", maxVelocity);
@@ -74,6 +76,10 @@ main(int argc, char* argv[])
     cmd.AddValue("KeyUpdThreshold",
                  "RSU decides to accept or reject a key update according to this frequency (ms)",
                  KeyUpdThreshold);
+    cmd.AddValue("KeyUpdLease",
+                 "Time a granted key update lease keeps other vehicles from rekeying (ms)",
+                 KeyUpdLease);
+    cmd.AddValue("logFile", "Write the log to this binary file, read with log-decode", logFile);
 
     if (initPosMin >= initPosMax)
     {
@@ -82,6 +88,12 @@ main(int argc, char* argv[])
 
     cmd.Parse(argc, argv);
 
+    if (!logFile.empty())
+    {
+        SgcLogComponent().Enable(LogLevel(LOG_PREFIX_TIME | LOG_PREFIX_LEVEL));
+        LogSetBinaryFile(logFile);
+    }
+
     auto metric = ns3::Singleton<Metric>::Get();
     auto mk = metric->GenerateStatKey(EmitType::kComputeSetup);
     metric->Emit(EmitType::kComputeSetup, mk);
@@ -136,14 +148,17 @@ main(int argc, char* argv[])
                                        MilliSeconds(hbInterval),
                                        MilliSeconds(keyEncapInterval),
                                        MilliSeconds(KeyUpdThreshold),
+                                       MilliSeconds(KeyUpdLease),
                                        groupSize,
                                        maxGroupNum);
+    int64_t stream = 0;
     for (uint32_t i = 0; i < vehicles.GetN(); ++i)
     {
-        VehicleApplication::Install(vehicles.Get(i),
-                                    9999,
-                                    Seconds(stopTime),
-                                    MilliSeconds(KeyUpdInterval));
+        auto vehicle_app = VehicleApplication::Install(vehicles.Get(i),
+                                                       9999,
+                                                       Seconds(stopTime),
+                                                       MilliSeconds(KeyUpdInterval));
+        stream += vehicle_app->AssignStreams(stream);
     }
 
     Ipv4GlobalRoutingHelper::PopulateRoutingTables();
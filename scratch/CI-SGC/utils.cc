@@ -4,8 +4,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
+ns3::LogComponent&
+SgcLogComponent()
+{
+    static ns3::LogComponent component("CI-SGC", __FILE__);
+    return component;
+}
+
 std::string
 AddressToString(ns3::Address addr)
 {
@@ -32,77 +40,41 @@ BytesToTimePoint(const uint8_t* data)
 }
 
 int
-ParseSizeParamFromSid(const std::vector<uint8_t>& sid)
+ParseSizeParamFromSid(std::span<const uint8_t, Sid::Length> sid)
 {
-    if (sid.size() != SGC::SidLength)
-    {
-        FATAL_ERROR("Invalid sid");
-    }
-
     int size_param = sid[6];
     size_param = (size_param << 8) | sid[7];
     return size_param;
 }
 
 uint16_t
-ParseGroupSeqFromSid(const std::vector<uint8_t>& sid)
+ParseGroupSeqFromSid(std::span<const uint8_t, Sid::Length> sid)
 {
-    if (sid.size() != SGC::SidLength)
-    {
-        FATAL_ERROR("Invalid sid");
-    }
-
     uint16_t seq = sid[4];
     seq = (seq << 8) | sid[5];
     return seq;
 }
 
 std::vector<uint32_t>
-SlotDiff(const std::vector<uint8_t>& bm_more, const std::vector<uint8_t>& bm_less, uint32_t n_slot)
+SlotDiff(const MemberBitmap& bm_more, const MemberBitmap& bm_less, uint32_t n_slot)
 {
-    if (bm_more.size() != bm_less.size())
+    if (bm_more.NumWords() != bm_less.NumWords())
     {
         FATAL_ERROR("SlotDiff: bm_more and bm_less must have the same size");
     }
-    std::vector<uint32_t> diff;
 
-    uint32_t index = 0;
-    for (size_t i = 0; i < bm_more.size(); i++)
+    auto diff = bm_more.Diff(bm_less);
+    while (!diff.empty() && diff.back() >= n_slot)
     {
-        if (bm_more[i] == bm_less[i])
-        {
-            index += 8;
-            continue;
-        }
-        uint8_t diff_byte = bm_more[i] ^ bm_less[i];
-        for (int i = 0; i < 8; i++)
-        {
-            if (diff_byte & (0x80 >> i))
-            {
-                diff.push_back(index);
-            }
-            index++;
-        }
+        diff.pop_back();
     }
-
     return diff;
 }
 
 bool
 IsEqual(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b)
 {
-    if (a.size() != b.size())
-    {
-        return false;
-    }
-    for (int i = 0; i < a.size(); i++)
-    {
-        if (a[i] != b[i])
-        {
-            return false;
-        }
-    }
-    return true;
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
 }
 
 std::vector<uint8_t>
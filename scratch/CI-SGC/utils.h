@@ -1,33 +1,59 @@
 #pragma once
 
 #include "crypto/utils.h"
+#include "sgc/member-bitmap.h"
+#include "sgc/sid.h"
 
 #include "ns3/address.h"
 #include "ns3/inet-socket-address.h"
+#include "ns3/log.h"
 #include "ns3/nstime.h"
+#include "ns3/simulator.h"
 
 #include <cstdint>
 #include <iostream>
+#include <span>
 #include <string>
 #include <vector>
 
 #define FATAL_ERROR(msg)                                                                           \
+    std::cout.flush();                                                                             \
     std::cerr << ns3::Simulator::Now().As(ns3::Time::MS) << "\t[ERROR] " << __FILE__ << ": line "  \
               << __LINE__ << ": " << msg << std::endl;                                             \
     abort();
 
-#define INFO(msg)                                                                                  \
-    std::cout << ns3::Simulator::Now().As(ns3::Time::MS) << "\t[INFO] " << msg << std::endl;
-#define WARN(msg)                                                                                  \
-    std::cout << ns3::Simulator::Now().As(ns3::Time::MS) << "\t[WARN] " << msg << std::endl;
+// INFO and WARN go to the binary log file when ns3::LogSetBinaryFile() has
+// opened one, and otherwise to std::cout, flushed at exit or on FATAL_ERROR
+#define SGC_LOG(level, label, msg)                                                                 \
+    do                                                                                             \
+    {                                                                                              \
+        if (ns3::LogIsBinary())                                                                    \
+        {                                                                                          \
+            ns3::LogBinaryMessage(SgcLogComponent(), __FUNCTION__, level).GetStream() << msg;      \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            std::cout << ns3::Simulator::Now().As(ns3::Time::MS) << "\t[" label "] " << msg       \
+                      << '\n';                                                                     \
+        }                                                                                          \
+    } while (false);
+#define INFO(msg) SGC_LOG(ns3::LOG_INFO, "INFO", msg)
+#define WARN(msg) SGC_LOG(ns3::LOG_WARN, "WARN", msg)
+
+/**
+ * The LogComponent of the INFO and WARN messages in the binary log file.
+ *
+ * @return the LogComponent
+ */
+ns3::LogComponent& SgcLogComponent();
 
 // only support InetSocketAddress for now
 std::string AddressToString(ns3::Address addr);
 
-int ParseSizeParamFromSid(const std::vector<uint8_t>& sid);
-uint16_t ParseGroupSeqFromSid(const std::vector<uint8_t>& sid);
-std::vector<uint32_t> SlotDiff(const std::vector<uint8_t>& bm_more,
-                               const std::vector<uint8_t>& bm_less,
+int ParseSizeParamFromSid(std::span<const uint8_t, Sid::Length> sid);
+uint16_t ParseGroupSeqFromSid(std::span<const uint8_t, Sid::Length> sid);
+std::vector<uint32_t> SlotDiff(const MemberBitmap& bm_more,
+                               const MemberBitmap& bm_less,
                                uint32_t n_slot);
 
 bool IsEqual(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b);
@@ -15,7 +15,9 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * @file
@@ -304,6 +306,10 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 /**
  * @ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * Several paths can be resolved together: they are merged in a tree of
+ * path tokens, and the objects matching a prefix shared by several paths,
+ * such as all the devices of all the nodes, are looked up only once.
  */
 class Resolver
 {
@@ -314,11 +320,17 @@ class Resolver
      * @param [in] path The Config path.
      */
     Resolver(std::string path);
+    /**
+     * Construct from several Config paths, resolved together.
+     *
+     * @param [in] paths The Config paths.
+     */
+    Resolver(const std::vector<std::string>& paths);
     /** Destructor. */
     virtual ~Resolver();
 
     /**
-     * Parse the stored Config path into an object reference,
+     * Parse the stored Config paths into object references,
      * beginning at the indicated root object.
      *
      * @param [in] root The object corresponding to the current position in
@@ -327,29 +339,73 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
+    /** A node of the tree of path tokens. */
+    struct PathNode
+    {
+        std::vector<std::string> items; //!< The token leading to each child
+        std::vector<PathNode> children; //!< The nodes following each token
+        std::vector<std::size_t> paths; //!< The indices of the paths ending here
+    };
+
+    /** An attribute of a TypeId which leads to other objects. */
+    struct ObjectAttribute
+    {
+        std::string name;                      //!< The attribute name
+        uint32_t flags;                        //!< The attribute flags
+        Ptr<const AttributeAccessor> accessor; //!< The attribute accessor
+        bool isContainer;                      //!< Whether it holds an ObjectPtrContainer
+    };
+
     /**
-     * Parse the next element in the Config path.
+     * Add a Config path to the tree of path tokens.
      *
-     * @param [in] path The remaining portion of the Config path.
+     * @param [in] path The Config path.
+     */
+    void AddPath(std::string path);
+    /**
+     * Get the attributes of a TypeId and of its parents which hold a
+     * Pointer or an ObjectPtrContainer, in the order they are searched.
+     * They are indexed by TypeId the first time they are needed.
+     *
+     * @param [in] tid The TypeId.
+     * @returns The attributes leading to other objects.
+     */
+    static const std::vector<ObjectAttribute>& GetObjectAttributes(TypeId tid);
+    /**
+     * Get the value of an attribute leading to other objects.
+     *
+     * @param [in] object The object holding the attribute.
+     * @param [in] attribute The attribute.
+     * @param [out] value The attribute value.
+     */
+    static void GetObjectAttribute(Ptr<Object> object,
+                                   const ObjectAttribute& attribute,
+                                   AttributeValue& value);
+    /**
+     * Handle the paths ending at a node of the tree of path tokens, then
+     * parse the tokens following it.
+     *
+     * @param [in] node The node of the tree of path tokens.
      * @param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(const PathNode& node, Ptr<Object> root);
     /**
-     * Parse an index on the Config path.
+     * Parse the next element in the Config path.
      *
-     * @param [in] path The remaining Config path.
-     * @param [in,out] vector The resulting list of matching objects.
+     * @param [in] item The next element of the Config path.
+     * @param [in] node The node of the tree of path tokens following \pname{item}.
+     * @param [in] root The object corresponding to the current position
+     *                  in the Config path.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoResolveItem(const std::string& item, const PathNode& node, Ptr<Object> root);
     /**
-     * Handle one object found on the path.
+     * Parse an index on the Config path.
      *
-     * @param [in] object The current object on the Config path.
+     * @param [in] node The node of the tree of path tokens preceding the index.
+     * @param [in,out] vector The resulting list of matching objects.
      */
-    void DoResolveOne(Ptr<Object> object);
+    void DoArrayResolve(const PathNode& node, const ObjectPtrContainerValue& vector);
     /**
      * Get the current Config path.
      *
@@ -359,24 +415,37 @@ class Resolver
     /**
      * Handle one found object.
      *
+     * @param [in] i The index of the Config path.
      * @param [in] object The found object.
      * @param [in] path The matching Config path context.
      */
-    virtual void DoOne(Ptr<Object> object, std::string path) = 0;
+    virtual void DoOne(std::size_t i, Ptr<Object> object, std::string path) = 0;
 
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
-    /** The Config path. */
-    std::string m_path;
+    /** The tree of the tokens of the Config paths. */
+    PathNode m_paths;
+    /** The number of Config paths. */
+    std::size_t m_nPaths;
 
     // end of class Resolver
 };
 
 Resolver::Resolver(std::string path)
-    : m_path(path)
+    : m_nPaths(0)
 {
     NS_LOG_FUNCTION(this << path);
-    Canonicalize();
+    AddPath(path);
+}
+
+Resolver::Resolver(const std::vector<std::string>& paths)
+    : m_nPaths(0)
+{
+    NS_LOG_FUNCTION(this << paths.size());
+    for (const auto& path : paths)
+    {
+        AddPath(path);
+    }
 }
 
 Resolver::~Resolver()
@@ -385,22 +454,88 @@ Resolver::~Resolver()
 }
 
 void
-Resolver::Canonicalize()
+Resolver::AddPath(std::string path)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << path);
 
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
+    // the path is split on '/': a missing slash at the start or at the
+    // end of the path is implied
+    std::string::size_type start = (path.find('/') == 0) ? 1 : 0;
+    PathNode* node = &m_paths;
+    while (start < path.size())
     {
-        // no slash at start
-        m_path = "/" + m_path;
+        std::string::size_type next = path.find('/', start);
+        if (next == std::string::npos)
+        {
+            next = path.size();
+        }
+        std::string item = path.substr(start, next - start);
+        auto it = std::find(node->items.begin(), node->items.end(), item);
+        if (it == node->items.end())
+        {
+            node->items.push_back(item);
+            node->children.emplace_back();
+            it = node->items.end() - 1;
+        }
+        node = &node->children[it - node->items.begin()];
+        start = next + 1;
+    }
+    node->paths.push_back(m_nPaths++);
+}
+
+const std::vector<Resolver::ObjectAttribute>&
+Resolver::GetObjectAttributes(TypeId tid)
+{
+    // the number of attributes of the TypeId and of its parents, to notice
+    // the attributes added after the TypeId was indexed
+    uint32_t nAttributes = 0;
+    for (TypeId cur = tid;; cur = cur.GetParent())
+    {
+        nAttributes += cur.GetAttributeN();
+        if (cur.GetParent() == cur)
+        {
+            break;
+        }
+    }
+
+    static std::unordered_map<uint16_t, std::pair<uint32_t, std::vector<ObjectAttribute>>> index;
+    auto& [n, attributes] = index[tid.GetUid()];
+    if (n == nAttributes)
+    {
+        return attributes;
+    }
+    n = nAttributes;
+    attributes.clear();
+    for (TypeId cur = tid;; cur = cur.GetParent())
+    {
+        for (uint32_t i = 0; i < cur.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = cur.GetAttribute(i);
+            const auto checker = PeekPointer(info.checker);
+            bool isContainer = dynamic_cast<const ObjectPtrContainerChecker*>(checker) != nullptr;
+            if (isContainer || dynamic_cast<const PointerChecker*>(checker) != nullptr)
+            {
+                attributes.push_back({info.name, info.flags, info.accessor, isContainer});
+            }
+        }
+        if (cur.GetParent() == cur)
+        {
+            break;
+        }
     }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
+    return attributes;
+}
+
+void
+Resolver::GetObjectAttribute(Ptr<Object> object,
+                             const ObjectAttribute& attribute,
+                             AttributeValue& value)
+{
+    if (!(attribute.flags & TypeId::ATTR_GET) || !attribute.accessor->HasGetter() ||
+        !attribute.accessor->Get(PeekPointer(object), value))
     {
-        // no slash at end
-        m_path = m_path + "/";
+        // let ObjectBase::GetAttribute report the error
+        object->GetAttribute(attribute.name, value);
     }
 }
 
@@ -409,7 +544,7 @@ Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(m_paths, root);
 }
 
 std::string
@@ -426,39 +561,37 @@ Resolver::GetResolvedPath() const
 }
 
 void
-Resolver::DoResolveOne(Ptr<Object> object)
-{
-    NS_LOG_FUNCTION(this << object);
-
-    NS_LOG_DEBUG("resolved=" << GetResolvedPath());
-    DoOne(object, GetResolvedPath());
-}
-
-void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(const PathNode& node, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << root);
 
-    if (next == std::string::npos)
+    //
+    // If root is zero, we're beginning to see if we can use the object name
+    // service to resolve this path.  It is impossible to have a object name
+    // associated with the root of the object name service since that root
+    // is not an object.  This path must be referring to something in another
+    // namespace and it will have been found already since the name service
+    // is always consulted last.
+    //
+    if (root && !node.paths.empty())
     {
-        //
-        // If root is zero, we're beginning to see if we can use the object name
-        // service to resolve this path.  It is impossible to have a object name
-        // associated with the root of the object name service since that root
-        // is not an object.  This path must be referring to something in another
-        // namespace and it will have been found already since the name service
-        // is always consulted last.
-        //
-        if (root)
+        std::string resolved = GetResolvedPath();
+        NS_LOG_DEBUG("resolved=" << resolved);
+        for (auto i : node.paths)
         {
-            DoResolveOne(root);
+            DoOne(i, root, resolved);
         }
-        return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    for (std::size_t i = 0; i < node.items.size(); i++)
+    {
+        DoResolveItem(node.items[i], node.children[i], root);
+    }
+}
+
+void
+Resolver::DoResolveItem(const std::string& item, const PathNode& node, Ptr<Object> root)
+{
+    NS_LOG_FUNCTION(this << item << root);
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -467,16 +600,12 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     // the root of the "/Names" namespace, so we just ignore it and move on to
     // the next segment.
     //
-    if (!root)
+    if (!root && item.starts_with("Names"))
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
-        {
-            m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
-            m_workStack.pop_back();
-            return;
-        }
+        m_workStack.push_back(item);
+        DoResolve(node, root);
+        m_workStack.pop_back();
+        return;
     }
 
     //
@@ -490,7 +619,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(node, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -520,71 +649,52 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(node, object);
         m_workStack.pop_back();
     }
     else
     {
-        // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
+        // this is a normal attribute: only the attributes holding a pointer
+        // or a container of objects can lead to other objects
         bool foundMatch = false;
-
-        do
+        for (const auto& attribute : GetObjectAttributes(root->GetInstanceTypeId()))
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (attribute.name != item && item != "*")
+            {
+                continue;
+            }
+            if (!attribute.isContainer)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << attribute.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                GetObjectAttribute(root, attribute, pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                foundMatch = true;
+                m_workStack.push_back(attribute.name);
+                DoResolve(node, object);
+                m_workStack.pop_back();
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << attribute.name
+                                                     << " on path=" << GetResolvedPath());
+                foundMatch = true;
+                ObjectPtrContainerValue vector;
+                GetObjectAttribute(root, attribute, vector);
+                m_workStack.push_back(attribute.name);
+                DoArrayResolve(node, vector);
+                m_workStack.pop_back();
+            }
+        }
 
         if (!foundMatch)
         {
@@ -596,30 +706,22 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(const PathNode& node, const ObjectPtrContainerValue& container)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
-    {
-        return;
-    }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    NS_LOG_FUNCTION(this << &container);
 
-    ArrayMatcher matcher = ArrayMatcher(item);
-    ObjectPtrContainerValue::Iterator it;
-    for (it = container.Begin(); it != container.End(); ++it)
+    for (std::size_t i = 0; i < node.items.size(); i++)
     {
-        if (matcher.Matches((*it).first))
+        ArrayMatcher matcher = ArrayMatcher(node.items[i]);
+        ObjectPtrContainerValue::Iterator it;
+        for (it = container.Begin(); it != container.End(); ++it)
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
+            if (matcher.Matches((*it).first))
+            {
+                m_workStack.push_back(std::to_string((*it).first));
+                DoResolve(node.children[i], (*it).second);
+                m_workStack.pop_back();
+            }
         }
     }
 }
@@ -647,6 +749,21 @@ class ConfigImpl : public Singleton<ConfigImpl>
     void Disconnect(std::string path, const CallbackBase& cb);
     /** @copydoc ns3::Config::LookupMatches() */
     MatchContainer LookupMatches(std::string path);
+    /**
+     * Resolve several Config paths together.
+     *
+     * @param [in] paths The Config paths.
+     * @returns The container of the objects matching each path.
+     */
+    std::vector<MatchContainer> LookupMatches(const std::vector<std::string>& paths);
+    /**
+     * Connect each callback to the trace sources matching its Config path.
+     *
+     * @param [in] connections The Config paths and their callbacks.
+     * @param [in] withContext Whether the callbacks take the context as first argument.
+     */
+    void ConnectMany(const std::vector<std::pair<std::string, CallbackBase>>& connections,
+                     bool withContext);
 
     /** @copydoc ns3::Config::RegisterRootNamespaceObject() */
     void RegisterRootNamespaceObject(Ptr<Object> obj);
@@ -777,24 +894,33 @@ MatchContainer
 ConfigImpl::LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
+    return LookupMatches(std::vector<std::string>{path}).front();
+}
+
+std::vector<MatchContainer>
+ConfigImpl::LookupMatches(const std::vector<std::string>& paths)
+{
+    NS_LOG_FUNCTION(this << paths.size());
 
     class LookupMatchesResolver : public Resolver
     {
       public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
+        LookupMatchesResolver(const std::vector<std::string>& paths)
+            : Resolver(paths),
+              m_objects(paths.size()),
+              m_contexts(paths.size())
         {
         }
 
-        void DoOne(Ptr<Object> object, std::string path) override
+        void DoOne(std::size_t i, Ptr<Object> object, std::string path) override
         {
-            m_objects.push_back(object);
-            m_contexts.push_back(path);
+            m_objects[i].push_back(object);
+            m_contexts[i].push_back(path);
         }
 
-        std::vector<Ptr<Object>> m_objects;
-        std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+        std::vector<std::vector<Ptr<Object>>> m_objects;
+        std::vector<std::vector<std::string>> m_contexts;
+    } resolver = LookupMatchesResolver(paths);
 
     for (auto i = m_roots.begin(); i != m_roots.end(); i++)
     {
@@ -808,7 +934,42 @@ ConfigImpl::LookupMatches(std::string path)
     //
     resolver.Resolve(nullptr);
 
-    return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
+    std::vector<MatchContainer> containers;
+    containers.reserve(paths.size());
+    for (std::size_t i = 0; i < paths.size(); i++)
+    {
+        containers.emplace_back(resolver.m_objects[i], resolver.m_contexts[i], paths[i]);
+    }
+    return containers;
+}
+
+void
+ConfigImpl::ConnectMany(const std::vector<std::pair<std::string, CallbackBase>>& connections,
+                        bool withContext)
+{
+    NS_LOG_FUNCTION(this << connections.size() << withContext);
+
+    std::vector<std::string> roots;
+    std::vector<std::string> leaves;
+    for (const auto& [path, cb] : connections)
+    {
+        std::string root;
+        std::string leaf;
+        ParsePath(path, &root, &leaf);
+        roots.push_back(root);
+        leaves.push_back(leaf);
+    }
+    std::vector<MatchContainer> containers = LookupMatches(roots);
+    for (std::size_t i = 0; i < connections.size(); i++)
+    {
+        const auto& [path, cb] = connections[i];
+        bool ok = withContext ? containers[i].ConnectFailSafe(leaves[i], cb)
+                              : containers[i].ConnectWithoutContextFailSafe(leaves[i], cb);
+        if (!ok)
+        {
+            NS_FATAL_ERROR("Could not connect callback to " << path);
+        }
+    }
 }
 
 void
@@ -990,6 +1151,20 @@ Disconnect(std::string path, const CallbackBase& cb)
     ConfigImpl::Get()->Disconnect(path, cb);
 }
 
+void
+ConnectMany(const std::vector<std::pair<std::string, CallbackBase>>& connections)
+{
+    NS_LOG_FUNCTION(connections.size());
+    ConfigImpl::Get()->ConnectMany(connections, true);
+}
+
+void
+ConnectWithoutContextMany(const std::vector<std::pair<std::string, CallbackBase>>& connections)
+{
+    NS_LOG_FUNCTION(connections.size());
+    ConfigImpl::Get()->ConnectMany(connections, false);
+}
+
 MatchContainer
 LookupMatches(std::string path)
 {
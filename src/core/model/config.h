@@ -11,6 +11,7 @@
 #include "ptr.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -177,6 +178,32 @@ bool ConnectFailSafe(std::string path, const CallbackBase& cb);
  * This function undoes the work of Config::ConnectWithContext.
  */
 void Disconnect(std::string path, const CallbackBase& cb);
+/**
+ * @ingroup config
+ * @param [in] connections The paths to match trace sources, each with the
+ *             callback to connect to the matching trace sources.
+ *
+ * This function connects each callback as Config::Connect does, but
+ * resolves all the paths together: the objects matching a prefix shared
+ * by several paths, such as all the devices of all the nodes, are looked
+ * up once, which is much faster in large scenarios.  If no matching trace
+ * sources are found for a path, this method will throw a fatal error.
+ *
+ * @hidecaller
+ */
+void ConnectMany(const std::vector<std::pair<std::string, CallbackBase>>& connections);
+/**
+ * @ingroup config
+ * @param [in] connections The paths to match trace sources, each with the
+ *             callback to connect to the matching trace sources.
+ *
+ * This function connects each callback as Config::ConnectWithoutContext
+ * does, resolving all the paths together as Config::ConnectMany.
+ *
+ * @hidecaller
+ */
+void ConnectWithoutContextMany(
+    const std::vector<std::pair<std::string, CallbackBase>>& connections);
 
 /**
  * @ingroup config
@@ -9,9 +9,12 @@
 #include "default-simulator-impl.h"
 
 #include "assert.h"
+#include "event-profiler.h"
+#include "event-trace.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
 /**
  * @file
@@ -32,10 +35,24 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("EventTraceFile",
+                          "Record the event list operations to this file, for replay with "
+                          "utils/bench-event-trace. Empty to disable.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::SetEventTraceFile),
+                          MakeStringChecker())
+            .AddAttribute("ProfileFile",
+                          "Write the wall clock time spent in each event handler, by handler "
+                          "type and context, to this file at Simulator::Destroy, as collapsed "
+                          "stacks for flamegraph.pl. Empty to disable.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::SetProfileFile),
+                          MakeStringChecker());
     return tid;
 }
 
@@ -70,6 +87,8 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+    m_eventTrace = nullptr;
+    m_profiler = nullptr;
     SimulatorImpl::DoDispose();
 }
 
@@ -87,6 +106,11 @@ DefaultSimulatorImpl::Destroy()
             ev->Invoke();
         }
     }
+    if (m_profiler)
+    {
+        m_profiler->Write();
+        m_profiler = nullptr;
+    }
 }
 
 void
@@ -106,6 +130,20 @@ DefaultSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
     m_events = scheduler;
 }
 
+void
+DefaultSimulatorImpl::SetEventTraceFile(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_eventTrace = filename.empty() ? nullptr : std::make_unique<EventTraceWriter>(filename);
+}
+
+void
+DefaultSimulatorImpl::SetProfileFile(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_profiler = filename.empty() ? nullptr : std::make_unique<EventProfiler>(filename);
+}
+
 // System ID for non-distributed simulation is always zero
 uint32_t
 DefaultSimulatorImpl::GetSystemId() const
@@ -121,6 +159,10 @@ DefaultSimulatorImpl::ProcessOneEvent()
     PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
 
     NS_ASSERT(next.key.m_ts >= m_currentTs);
+    if (m_eventTrace)
+    {
+        m_eventTrace->Run(next.key.m_ts);
+    }
     m_unscheduledEvents--;
     m_eventCount++;
 
@@ -128,7 +170,14 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl, next.key.m_context);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -167,6 +216,10 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
+        if (m_eventTrace)
+        {
+            m_eventTrace->Insert(ev.key.m_uid, ev.key.m_ts, ev.key.m_context);
+        }
     }
 }
 
@@ -224,6 +277,10 @@ DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
     m_uid++;
     m_unscheduledEvents++;
     m_events->Insert(ev);
+    if (m_eventTrace)
+    {
+        m_eventTrace->Insert(ev.key.m_uid, ev.key.m_ts, ev.key.m_context);
+    }
     return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -243,6 +300,10 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         m_uid++;
         m_unscheduledEvents++;
         m_events->Insert(ev);
+        if (m_eventTrace)
+        {
+            m_eventTrace->Insert(ev.key.m_uid, ev.key.m_ts, ev.key.m_context);
+        }
     }
     else
     {
@@ -326,6 +387,10 @@ DefaultSimulatorImpl::Remove(const EventId& id)
     event.key.m_context = id.GetContext();
     event.key.m_uid = id.GetUid();
     m_events->Remove(event);
+    if (m_eventTrace)
+    {
+        m_eventTrace->Remove(event.key.m_uid);
+    }
     event.impl->Cancel();
     // whenever we remove an event from the event list, we have to unref it.
     event.impl->Unref();
@@ -339,6 +404,10 @@ DefaultSimulatorImpl::Cancel(const EventId& id)
     if (!IsExpired(id))
     {
         id.PeekEventImpl()->Cancel();
+        if (m_eventTrace && id.GetUid() != EventId::UID::DESTROY)
+        {
+            m_eventTrace->Cancel(id.GetUid());
+        }
     }
 }
 
@@ -12,7 +12,9 @@
 #include "simulator-impl.h"
 
 #include <list>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
 /**
@@ -25,12 +27,22 @@ namespace ns3
 {
 
 // Forward
+class EventProfiler;
+class EventTraceWriter;
 class Scheduler;
 
 /**
  * @ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the EventTraceFile attribute is set, every operation on the event
+ * list is recorded to that file (see EventTraceOp), so that the workload
+ * can be replayed against any Scheduler with utils/bench-event-trace.
+ *
+ * When the ProfileFile attribute is set, the wall clock time of each event
+ * is attributed to its handler and context (see EventProfiler), and written
+ * to that file at Simulator::Destroy, for flamegraph.pl.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -74,6 +86,17 @@ class DefaultSimulatorImpl : public SimulatorImpl
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
+    /**
+     * Start recording the event list operations.
+     * @param [in] filename The event trace file; empty to stop recording.
+     */
+    void SetEventTraceFile(const std::string& filename);
+    /**
+     * Start measuring the time spent in each kind of event.
+     * @param [in] filename The file to write the times to at Destroy();
+     *             empty to stop measuring.
+     */
+    void SetProfileFile(const std::string& filename);
 
     /** Wrap an event with its execution context. */
     struct EventWithContext
@@ -125,6 +148,11 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** Event trace recorder, if recording. */
+    std::unique_ptr<EventTraceWriter> m_eventTrace;
+    /** Event profiler, if profiling. */
+    std::unique_ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
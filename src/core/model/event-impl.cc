@@ -10,6 +10,9 @@
 
 #include "log.h"
 
+#include <algorithm>
+#include <array>
+
 /**
  * @file
  * @ingroup events
@@ -21,6 +24,180 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/**
+ * @ingroup events
+ * Per-thread cache of freed event memory.
+ *
+ * Each size class keeps a singly linked list of blocks threaded through the
+ * blocks themselves. The blocks come from the global allocator, so a block can
+ * be cached on, and released by, a thread other than the one that allocated it.
+ */
+class EventPool
+{
+  public:
+    /** Granularity of the size classes, in bytes. */
+    static constexpr std::size_t GRANULE = 16;
+    /** Number of size classes; events larger than GRANULE * CLASSES are not pooled. */
+    static constexpr std::size_t CLASSES = 16;
+    /** Maximum number of cached blocks per size class. */
+    static constexpr uint32_t MAX_CACHED = 4096;
+
+    constexpr EventPool() = default;
+    ~EventPool();
+
+    /**
+     * @param [in] size The block size.
+     * @returns A block of at least size bytes.
+     */
+    void* Allocate(std::size_t size);
+    /**
+     * @param [in] p The block to release.
+     * @param [in] size The block size, as passed to Allocate().
+     */
+    void Deallocate(void* p, std::size_t size);
+
+    /**
+     * @param [in] size The block size.
+     * @returns The size class of size, or CLASSES if it is not pooled.
+     */
+    static std::size_t SizeClass(std::size_t size)
+    {
+        return size == 0 ? 0 : std::min((size - 1) / GRANULE, CLASSES);
+    }
+
+    /**
+     * @param [in] c A size class.
+     * @returns The size of the blocks of class c.
+     */
+    static constexpr std::size_t BlockSize(std::size_t c)
+    {
+        return (c + 1) * GRANULE;
+    }
+
+  private:
+    /** A free block. */
+    struct FreeBlock
+    {
+        FreeBlock* next; //!< The next free block of the same class.
+    };
+
+    std::array<FreeBlock*, CLASSES> m_free{};  //!< Free lists, one per size class.
+    std::array<uint32_t, CLASSES> m_cached{}; //!< Length of each free list.
+};
+
+/** Set once the pool of this thread has been destroyed, at thread exit. */
+thread_local bool g_eventPoolDestroyed = false;
+/** The event pool of this thread. */
+thread_local EventPool g_eventPool;
+
+EventPool::~EventPool()
+{
+    for (auto head : m_free)
+    {
+        while (head)
+        {
+            FreeBlock* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+    g_eventPoolDestroyed = true;
+}
+
+void*
+EventPool::Allocate(std::size_t size)
+{
+    std::size_t c = SizeClass(size);
+    FreeBlock* block = m_free[c];
+    if (block)
+    {
+        m_free[c] = block->next;
+        m_cached[c]--;
+        return block;
+    }
+    return ::operator new(BlockSize(c));
+}
+
+void
+EventPool::Deallocate(void* p, std::size_t size)
+{
+    std::size_t c = SizeClass(size);
+    if (m_cached[c] >= MAX_CACHED)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = m_free[c];
+    m_free[c] = block;
+    m_cached[c]++;
+}
+
+/**
+ * @returns true if events should bypass the pool. Pooling would hide
+ * use-after-free of events from AddressSanitizer.
+ */
+constexpr bool
+EventPoolDisabled()
+{
+#if defined(__SANITIZE_ADDRESS__)
+    return true;
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+    return true;
+#else
+    return false;
+#endif
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t c = EventPool::SizeClass(size);
+    if (EventPoolDisabled() || c >= EventPool::CLASSES)
+    {
+        return ::operator new(size);
+    }
+    if (g_eventPoolDestroyed)
+    {
+        // the block may still end up in the pool of another thread
+        return ::operator new(EventPool::BlockSize(c));
+    }
+    return g_eventPool.Allocate(size);
+}
+
+void*
+EventImpl::operator new(std::size_t size, std::align_val_t al)
+{
+    return ::operator new(size, al);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    if (EventPoolDisabled() || EventPool::SizeClass(size) >= EventPool::CLASSES ||
+        g_eventPoolDestroyed)
+    {
+        ::operator delete(p);
+        return;
+    }
+    g_eventPool.Deallocate(p, size);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t /* size */, std::align_val_t al)
+{
+    ::operator delete(p, al);
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -10,6 +10,8 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
+#include <new>
 #include <stdint.h>
 
 /**
@@ -56,6 +58,33 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Allocate memory for an event from the per-thread event pool.
+     * @param [in] size The size of the event object.
+     * @returns The allocated memory.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Allocate memory for an over-aligned event. Not pooled.
+     * @param [in] size The size of the event object.
+     * @param [in] al The alignment of the event object.
+     * @returns The allocated memory.
+     */
+    static void* operator new(std::size_t size, std::align_val_t al);
+    /**
+     * Return the memory of an event to the per-thread event pool.
+     * @param [in] p The memory to release.
+     * @param [in] size The size of the event object.
+     */
+    static void operator delete(void* p, std::size_t size);
+    /**
+     * Release the memory of an over-aligned event.
+     * @param [in] p The memory to release.
+     * @param [in] size The size of the event object.
+     * @param [in] al The alignment of the event object.
+     */
+    static void operator delete(void* p, std::size_t size, std::align_val_t al);
+
   protected:
     /**
      * Implementation for Invoke().
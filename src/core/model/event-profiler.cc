@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-profiler.h"
+
+#include "demangle.h"
+#include "event-impl.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <typeinfo>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+EventProfiler::EventProfiler(const std::string& filename)
+    : m_file(filename, std::ios::trunc)
+{
+    NS_LOG_FUNCTION(this << filename);
+    if (!m_file)
+    {
+        NS_FATAL_ERROR("Cannot open event profile file " << filename);
+    }
+}
+
+void
+EventProfiler::Invoke(EventImpl* event, uint32_t context)
+{
+    Key key{typeid(*event), context};
+    auto start = std::chrono::steady_clock::now();
+    event->Invoke();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    m_times[key] += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+void
+EventProfiler::Write()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<std::pair<uint64_t, Key>> times;
+    times.reserve(m_times.size());
+    for (const auto& [key, time] : m_times)
+    {
+        times.emplace_back(time, key);
+    }
+    std::sort(times.begin(), times.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
+    std::map<std::type_index, std::string> handlers;
+    for (const auto& [time, key] : times)
+    {
+        auto handler = handlers.find(key.first);
+        if (handler == handlers.end())
+        {
+            handler =
+                handlers.emplace(key.first, GetHandlerName(Demangle(key.first.name()))).first;
+        }
+        m_file << handler->second << ';';
+        if (key.second == Simulator::NO_CONTEXT)
+        {
+            m_file << "no context";
+        }
+        else
+        {
+            m_file << "node " << key.second;
+        }
+        m_file << ' ' << time << '\n';
+    }
+    m_file.flush();
+    m_times.clear();
+}
+
+std::string
+EventProfiler::GetHandlerName(const std::string& type)
+{
+    // The events made by MakeEvent() are local classes, such as
+    //   ns3::MakeEvent<void (A::*)(int), A*, int>(void (A::*)(int), A*, int)::EventMemberImpl
+    // so skip the template arguments, and return the first function argument.
+    const std::string prefix = "ns3::MakeEvent<";
+    if (type.compare(0, prefix.size(), prefix) != 0)
+    {
+        return type;
+    }
+    int depth = 0;
+    std::size_t begin = std::string::npos;
+    for (std::size_t i = prefix.size() - 1; i < type.size(); i++)
+    {
+        char c = type[i];
+        if (depth == 0 && begin == std::string::npos)
+        {
+            if (c != '<' && c != '(')
+            {
+                break;
+            }
+            if (c == '(')
+            {
+                begin = i + 1;
+            }
+        }
+        else if (depth == 1 && begin != std::string::npos && (c == ',' || c == ')'))
+        {
+            return type.substr(begin, i - begin);
+        }
+        if (c == '<' || c == '(' || c == '[' || c == '{')
+        {
+            depth++;
+        }
+        else if (c == '>' || c == ')' || c == ']' || c == '}')
+        {
+            depth--;
+        }
+    }
+    return type;
+}
+
+} // namespace ns3
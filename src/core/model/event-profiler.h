@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * @ingroup simulator
+ * Measure the wall clock time spent in each kind of event.
+ *
+ * The time of each event is attributed to the type of its handler and to
+ * its context, which is the node id for the events of a node. The handler
+ * is the first argument of the MakeEvent() call which created the event:
+ * the method pointer type, which names the class, the function pointer
+ * type, or the lambda, which names the enclosing function.
+ *
+ * Write() prints one line per handler and context, in the collapsed stack
+ * format of flamegraph.pl:
+ *
+ *     void (ns3::WifiPhy::*)(ns3::Ptr<ns3::WifiPpdu>);node 3 1234567
+ *
+ * where the value is the time in nanoseconds.
+ */
+class EventProfiler
+{
+  public:
+    /**
+     * Open the output file.
+     * @param [in] filename The output file name.
+     */
+    EventProfiler(const std::string& filename);
+
+    /**
+     * Invoke an event and add its run time to its handler.
+     * @param [in] event The event.
+     * @param [in] context The event context.
+     */
+    void Invoke(EventImpl* event, uint32_t context);
+    /** Write the times to the file, the longest first. */
+    void Write();
+
+    /**
+     * Get the handler of an event from the demangled type of the event.
+     * @param [in] type The demangled type of the event.
+     * @returns The first argument of the MakeEvent() call which created
+     * the event, or the type if the event was not made by MakeEvent().
+     */
+    static std::string GetHandlerName(const std::string& type);
+
+  private:
+    /** The handler type and the context. */
+    using Key = std::pair<std::type_index, uint32_t>;
+
+    /** Hash a Key. */
+    struct KeyHash
+    {
+        /**
+         * @param [in] key The key.
+         * @returns The hash of the key.
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            return key.first.hash_code() ^ (std::size_t{key.second} * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    std::ofstream m_file;                               //!< The output file.
+    std::unordered_map<Key, uint64_t, KeyHash> m_times; //!< Time in ns by handler and context.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
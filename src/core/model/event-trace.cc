@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "event-trace.h"
+
+#include "fatal-error.h"
+#include "log.h"
+
+#include <cstring>
+#include <iterator>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventTraceWriter and ns3::EventTraceReader implementations.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventTrace");
+
+namespace
+{
+
+/** The magic at the start of an event trace file. */
+constexpr char EVENT_TRACE_MAGIC[] = "NS3EVTR1";
+/** Length of the magic, without the terminating null. */
+constexpr std::size_t EVENT_TRACE_MAGIC_LEN = sizeof(EVENT_TRACE_MAGIC) - 1;
+/** Records are written to the file once the buffer grows past this size. */
+constexpr std::size_t EVENT_TRACE_BUFFER_SIZE = 1 << 16;
+
+} // namespace
+
+EventTraceWriter::EventTraceWriter(const std::string& filename)
+    : m_file(filename, std::ios::binary | std::ios::trunc),
+      m_lastUid(0),
+      m_currentTs(0)
+{
+    NS_LOG_FUNCTION(this << filename);
+    if (!m_file)
+    {
+        NS_FATAL_ERROR("Cannot open event trace file " << filename);
+    }
+    m_file.write(EVENT_TRACE_MAGIC, EVENT_TRACE_MAGIC_LEN);
+    m_buffer.reserve(EVENT_TRACE_BUFFER_SIZE + 32);
+}
+
+EventTraceWriter::~EventTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+}
+
+void
+EventTraceWriter::Insert(uint32_t uid, uint64_t ts, uint32_t context)
+{
+    m_buffer.push_back(static_cast<uint8_t>(EventTraceOp::INSERT));
+    PutVarint(uid - m_lastUid - 1);
+    PutVarint(ts - m_currentTs);
+    PutVarint(static_cast<uint32_t>(context + 1));
+    m_lastUid = uid;
+    if (m_buffer.size() > EVENT_TRACE_BUFFER_SIZE)
+    {
+        Flush();
+    }
+}
+
+void
+EventTraceWriter::Run(uint64_t ts)
+{
+    m_buffer.push_back(static_cast<uint8_t>(EventTraceOp::RUN));
+    PutVarint(ts - m_currentTs);
+    m_currentTs = ts;
+    if (m_buffer.size() > EVENT_TRACE_BUFFER_SIZE)
+    {
+        Flush();
+    }
+}
+
+void
+EventTraceWriter::Remove(uint32_t uid)
+{
+    m_buffer.push_back(static_cast<uint8_t>(EventTraceOp::REMOVE));
+    PutVarint(m_lastUid - uid);
+    if (m_buffer.size() > EVENT_TRACE_BUFFER_SIZE)
+    {
+        Flush();
+    }
+}
+
+void
+EventTraceWriter::Cancel(uint32_t uid)
+{
+    m_buffer.push_back(static_cast<uint8_t>(EventTraceOp::CANCEL));
+    PutVarint(m_lastUid - uid);
+    if (m_buffer.size() > EVENT_TRACE_BUFFER_SIZE)
+    {
+        Flush();
+    }
+}
+
+void
+EventTraceWriter::Flush()
+{
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size());
+    m_file.flush();
+    m_buffer.clear();
+}
+
+void
+EventTraceWriter::PutVarint(uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        m_buffer.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    m_buffer.push_back(static_cast<uint8_t>(v));
+}
+
+std::vector<EventTraceReader::Record>
+EventTraceReader::ReadAll(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+    {
+        NS_FATAL_ERROR("Cannot open event trace file " << filename);
+    }
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+    if (data.size() < EVENT_TRACE_MAGIC_LEN ||
+        std::memcmp(data.data(), EVENT_TRACE_MAGIC, EVENT_TRACE_MAGIC_LEN) != 0)
+    {
+        NS_FATAL_ERROR(filename << " is not an event trace file");
+    }
+
+    std::size_t pos = EVENT_TRACE_MAGIC_LEN;
+    auto getVarint = [&data, &pos, &filename]() {
+        uint64_t v = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if (pos >= data.size())
+            {
+                NS_FATAL_ERROR("Truncated event trace file " << filename);
+            }
+            uint8_t b = data[pos++];
+            v |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80))
+            {
+                return v;
+            }
+        }
+        NS_FATAL_ERROR("Malformed event trace file " << filename);
+        return uint64_t{0};
+    };
+
+    std::vector<Record> records;
+    // timestamp of each inserted event, indexed by uid, to resolve REMOVE
+    std::vector<uint64_t> tsOfUid;
+    uint32_t lastUid = 0;
+    uint64_t currentTs = 0;
+    while (pos < data.size())
+    {
+        Record r{static_cast<EventTraceOp>(data[pos++]), 0, 0, 0};
+        switch (r.op)
+        {
+        case EventTraceOp::INSERT:
+            r.uid = lastUid + 1 + getVarint();
+            r.ts = currentTs + getVarint();
+            r.context = static_cast<uint32_t>(getVarint()) - 1;
+            lastUid = r.uid;
+            if (tsOfUid.size() <= r.uid)
+            {
+                tsOfUid.resize(r.uid + 1);
+            }
+            tsOfUid[r.uid] = r.ts;
+            break;
+        case EventTraceOp::RUN:
+            currentTs += getVarint();
+            r.ts = currentTs;
+            break;
+        case EventTraceOp::REMOVE:
+        case EventTraceOp::CANCEL:
+            r.uid = lastUid - getVarint();
+            r.ts = r.uid < tsOfUid.size() ? tsOfUid[r.uid] : 0;
+            break;
+        default:
+            NS_FATAL_ERROR("Unknown opcode " << +static_cast<uint8_t>(r.op) << " in event trace "
+                                             << filename);
+        }
+        records.push_back(r);
+    }
+    NS_LOG_DEBUG("Read " << records.size() << " records from " << filename);
+    return records;
+}
+
+} // namespace ns3
@@ -0,0 +1,132 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventTraceWriter and ns3::EventTraceReader declarations.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ * Operations on the event list recorded in an event trace.
+ *
+ * An event trace is a binary file holding the sequence of operations a
+ * SimulatorImpl performed on its Scheduler, so that the same sequence can
+ * be replayed against any Scheduler (see utils/bench-event-trace.cc).
+ *
+ * The file starts with the 8-byte magic "NS3EVTR1", followed by records.
+ * Each record is one opcode byte followed by unsigned LEB128 fields:
+ *
+ * Opcode   | Fields
+ * :------- | :-----
+ * INSERT   | uid - previous inserted uid - 1, delay, context + 1
+ * RUN      | timestamp of the event - timestamp of the previous RUN
+ * REMOVE   | last inserted uid - uid
+ * CANCEL   | last inserted uid - uid
+ *
+ * Delays are relative to the timestamp of the last RUN. Uids and contexts
+ * are those of the recording simulator; a context of
+ * Simulator::NO_CONTEXT is stored as 0.
+ */
+enum class EventTraceOp : uint8_t
+{
+    INSERT = 0, //!< An event was inserted in the event list.
+    RUN = 1,    //!< The earliest event was removed from the event list and run.
+    REMOVE = 2, //!< A specific event was removed from the event list.
+    CANCEL = 3, //!< An event was cancelled, it stays in the event list.
+};
+
+/**
+ * @ingroup simulator
+ * Write an event trace file.
+ */
+class EventTraceWriter
+{
+  public:
+    /**
+     * Open the trace file and write the header.
+     * @param [in] filename The trace file name.
+     */
+    EventTraceWriter(const std::string& filename);
+    /** Flush and close the trace file. */
+    ~EventTraceWriter();
+
+    /**
+     * Record the insertion of an event.
+     * @param [in] uid The event uid.
+     * @param [in] ts The event timestamp.
+     * @param [in] context The event context.
+     */
+    void Insert(uint32_t uid, uint64_t ts, uint32_t context);
+    /**
+     * Record that the earliest event is about to run.
+     * @param [in] ts The event timestamp.
+     */
+    void Run(uint64_t ts);
+    /**
+     * Record the removal of an event.
+     * @param [in] uid The event uid.
+     */
+    void Remove(uint32_t uid);
+    /**
+     * Record the cancellation of an event.
+     * @param [in] uid The event uid.
+     */
+    void Cancel(uint32_t uid);
+    /** Write the buffered records to the file. */
+    void Flush();
+
+  private:
+    /**
+     * Append an unsigned LEB128 value to the buffer.
+     * @param [in] v The value.
+     */
+    void PutVarint(uint64_t v);
+
+    std::ofstream m_file;          //!< The trace file.
+    std::vector<uint8_t> m_buffer; //!< Records not yet written.
+    uint32_t m_lastUid;            //!< Uid of the last inserted event.
+    uint64_t m_currentTs;          //!< Timestamp of the last RUN.
+};
+
+/**
+ * @ingroup simulator
+ * Read an event trace file.
+ */
+class EventTraceReader
+{
+  public:
+    /** A decoded record. */
+    struct Record
+    {
+        EventTraceOp op;  //!< The operation.
+        uint64_t ts;      //!< Absolute timestamp of the event; for RUN the expected timestamp.
+        uint32_t uid;     //!< The event uid; unused for RUN.
+        uint32_t context; //!< The event context; only for INSERT.
+    };
+
+    /**
+     * Read and decode a whole trace file.
+     * Aborts with NS_FATAL_ERROR if the file cannot be read or is malformed.
+     * @param [in] filename The trace file name.
+     * @returns The records, in order.
+     */
+    static std::vector<Record> ReadAll(const std::string& filename);
+};
+
+} // namespace ns3
+
+#endif /* EVENT_TRACE_H */
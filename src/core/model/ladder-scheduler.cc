@@ -0,0 +1,337 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <functional>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_nRungs(0),
+      m_size(0)
+{
+    NS_LOG_FUNCTION(this);
+    // SpawnRung() must not move the rungs while Refill() holds a bucket
+    m_rungs.reserve(MAX_RUNGS);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_size++;
+
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+    }
+    else
+    {
+        bool inserted = false;
+        for (uint32_t i = 0; i < m_nRungs; i++)
+        {
+            Rung& rung = m_rungs[i];
+            if (ts >= rung.CurrentStart())
+            {
+                rung.BucketOf(ts).push_back(ev);
+                rung.m_count++;
+                inserted = true;
+                break;
+            }
+        }
+        if (!inserted)
+        {
+            InsertBottom(ev);
+            if (m_bottom.size() > 2 * THRESHOLD)
+            {
+                SplitBottom();
+            }
+        }
+    }
+
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_bottom.empty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_bottom.empty());
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    m_size--;
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+    NS_LOG_DEBUG("remove " << ev.key.m_ts << " " << ev.key.m_uid);
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+
+    uint64_t ts = ev.key.m_ts;
+    bool found = false;
+    if (ts >= m_topStart)
+    {
+        found = RemoveFrom(m_top, ev);
+    }
+    else
+    {
+        bool inLadder = false;
+        for (uint32_t i = 0; i < m_nRungs; i++)
+        {
+            Rung& rung = m_rungs[i];
+            if (ts >= rung.CurrentStart())
+            {
+                found = RemoveFrom(rung.BucketOf(ts), ev);
+                rung.m_count -= found;
+                inLadder = true;
+                break;
+            }
+        }
+        if (!inLadder)
+        {
+            auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>());
+            if (it != m_bottom.end() && *it == ev)
+            {
+                m_bottom.erase(it);
+                found = true;
+            }
+        }
+    }
+    NS_ASSERT_MSG(found, "Event " << ev.key.m_uid << " is not in the queue");
+    m_size--;
+
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+uint64_t
+LadderScheduler::SpawnRung(uint64_t start,
+                           uint64_t end,
+                           Bucket::iterator first,
+                           Bucket::iterator last)
+{
+    NS_LOG_FUNCTION(this << start << end);
+    NS_ASSERT(m_nRungs < MAX_RUNGS);
+    NS_ASSERT(start < end);
+
+    auto n = static_cast<uint64_t>(last - first);
+    uint64_t nBuckets = std::clamp<uint64_t>(n, 1, MAX_BUCKETS);
+    uint64_t width = std::max<uint64_t>(1, (end - start + nBuckets - 1) / nBuckets);
+    nBuckets = (end - start + width - 1) / width;
+
+    if (m_rungs.size() == m_nRungs)
+    {
+        m_rungs.emplace_back();
+    }
+    Rung& rung = m_rungs[m_nRungs++];
+    rung.m_start = start;
+    rung.m_width = width;
+    rung.m_nBuckets = nBuckets;
+    rung.m_current = 0;
+    rung.m_count = n;
+    if (rung.m_buckets.size() < nBuckets)
+    {
+        rung.m_buckets.resize(nBuckets);
+    }
+    for (auto it = first; it != last; ++it)
+    {
+        rung.BucketOf(it->key.m_ts).push_back(*it);
+    }
+    NS_LOG_DEBUG("rung " << m_nRungs - 1 << ": start=" << start << ", width=" << width
+                         << ", buckets=" << nBuckets << ", events=" << n);
+    return start + nBuckets * width;
+}
+
+void
+LadderScheduler::Refill()
+{
+    NS_LOG_FUNCTION(this);
+    while (m_bottom.empty())
+    {
+        if (m_nRungs == 0)
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            TransferTop();
+            continue;
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.m_count == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+        while (rung.m_buckets[rung.m_current].empty())
+        {
+            rung.m_current++;
+        }
+
+        Bucket& bucket = rung.m_buckets[rung.m_current];
+        uint64_t bucketStart = rung.CurrentStart();
+        rung.m_current++;
+        rung.m_count -= bucket.size();
+
+        if (bucket.size() > THRESHOLD && rung.m_width > 1 && m_nRungs < MAX_RUNGS)
+        {
+            SpawnRung(bucketStart, bucketStart + rung.m_width, bucket.begin(), bucket.end());
+            bucket.clear();
+        }
+        else
+        {
+            // copy rather than swap, so that the bottom keeps its storage
+            m_bottom.assign(bucket.begin(), bucket.end());
+            bucket.clear();
+            std::sort(m_bottom.begin(), m_bottom.end(), std::greater<>());
+        }
+    }
+}
+
+void
+LadderScheduler::TransferTop()
+{
+    NS_LOG_FUNCTION(this << m_top.size());
+    NS_ASSERT(m_nRungs == 0 && m_bottom.empty() && !m_top.empty());
+
+    auto [minIt, maxIt] =
+        std::minmax_element(m_top.begin(), m_top.end(), [](const Event& a, const Event& b) {
+            return a.key.m_ts < b.key.m_ts;
+        });
+    uint64_t minTs = minIt->key.m_ts;
+    uint64_t maxTs = maxIt->key.m_ts;
+
+    if (m_top.size() <= THRESHOLD)
+    {
+        m_bottom.assign(m_top.begin(), m_top.end());
+        m_top.clear();
+        std::sort(m_bottom.begin(), m_bottom.end(), std::greater<>());
+        m_topStart = maxTs + 1;
+    }
+    else
+    {
+        m_topStart = SpawnRung(minTs, maxTs + 1, m_top.begin(), m_top.end());
+        m_top.clear();
+    }
+}
+
+void
+LadderScheduler::InsertBottom(const Event& ev)
+{
+    auto it = std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>());
+    m_bottom.insert(it, ev);
+}
+
+void
+LadderScheduler::SplitBottom()
+{
+    NS_LOG_FUNCTION(this << m_bottom.size());
+    if (m_nRungs == MAX_RUNGS)
+    {
+        return;
+    }
+
+    // keep about THRESHOLD events in the bottom; the split must fall between two
+    // timestamps, since the rung and the bottom cover disjoint ranges
+    uint64_t minTs = m_bottom.back().key.m_ts;
+    uint64_t splitTs = m_bottom[m_bottom.size() - 1 - THRESHOLD].key.m_ts;
+    if (splitTs == minTs)
+    {
+        auto later = std::find_if(m_bottom.rbegin(), m_bottom.rend(), [minTs](const Event& e) {
+            return e.key.m_ts > minTs;
+        });
+        if (later == m_bottom.rend())
+        {
+            return;
+        }
+        splitTs = later->key.m_ts;
+    }
+
+    auto last = std::partition_point(m_bottom.begin(), m_bottom.end(), [splitTs](const Event& e) {
+        return e.key.m_ts >= splitTs;
+    });
+    SpawnRung(splitTs, BottomEnd(), m_bottom.begin(), last);
+    m_bottom.erase(m_bottom.begin(), last);
+}
+
+uint64_t
+LadderScheduler::BottomEnd() const
+{
+    return m_nRungs == 0 ? m_topStart : m_rungs[m_nRungs - 1].CurrentStart();
+}
+
+bool
+LadderScheduler::RemoveFrom(Bucket& bucket, const Event& ev)
+{
+    auto it = std::find(bucket.begin(), bucket.end(), ev);
+    if (it == bucket.end())
+    {
+        return false;
+    }
+    *it = bucket.back();
+    bucket.pop_back();
+    return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,194 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue described in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale Discrete
+ * Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and Ian Li-Jin
+ * Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are kept in three tiers:
+ *
+ * - **Top**: an unsorted `std::vector` of the far-future events, those with
+ *   a timestamp at or after the end of the ladder.
+ * - **Ladder**: a stack of rungs.  Each rung is an array of unsorted buckets
+ *   of uniform width; rung `i + 1` subdivides the bucket of rung `i` which is
+ *   currently being consumed.
+ * - **Bottom**: a short sorted `std::vector` holding the earliest events,
+ *   from which RemoveNext() pops.
+ *
+ * When the bottom runs empty, the next non-empty bucket of the lowest rung
+ * either moves to the bottom (and is sorted there) if it holds at most
+ * `THRESHOLD` events, or is spread over a new, finer rung.  When the ladder
+ * runs empty the top is spread over a new first rung, with one bucket per
+ * event.  Each event is thus copied a bounded number of times before it is
+ * sorted, and only small sets of events are ever sorted.
+ *
+ * New events are appended to the top or to the bucket covering their
+ * timestamp, which is constant time.  Events due before every rung, which
+ * is typical of short timers and of the fan-out of a transmission to many
+ * receivers, are inserted in the bottom; when the bottom grows past
+ * `2 * THRESHOLD` its later part is spread over a new rung.
+ *
+ * The rungs and buckets are recycled, so a scheduler in steady state does
+ * not allocate.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to top or to a bucket; short sorted insert in bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Back of bottom
+ * Remove()     | ~Constant       | Search within a bucket, Linear if the event is in top
+ * RemoveNext() | ~Constant       | Pop from bottom; bucket transfers are amortized
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | ~`MAX_RUNGS` x `MAX_BUCKETS` x 3 x `sizeof (*)` | Recycled, mostly empty buckets
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Largest bucket moved to the bottom without being spread over a new rung. */
+    static constexpr uint32_t THRESHOLD = 50;
+    /** Maximum number of rungs. */
+    static constexpr uint32_t MAX_RUNGS = 8;
+    /** Maximum number of buckets of a rung. */
+    static constexpr uint32_t MAX_BUCKETS = 1 << 16;
+
+    /** A list of events, sorted or not depending on where it is used. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder: buckets of uniform width starting at m_start. */
+    struct Rung
+    {
+        uint64_t m_start;              //!< Timestamp at the start of the first bucket.
+        uint64_t m_width;              //!< Width of a bucket, in dimensionless time units.
+        uint32_t m_nBuckets;           //!< Number of buckets in use.
+        uint32_t m_current;            //!< Index of the first bucket not yet consumed.
+        uint32_t m_count;              //!< Number of events in the rung.
+        std::vector<Bucket> m_buckets; //!< The buckets; may be larger than m_nBuckets.
+
+        /** @returns The timestamp at the start of the current bucket. */
+        uint64_t CurrentStart() const
+        {
+            return m_start + m_current * m_width;
+        }
+
+        /**
+         * @param [in] ts A timestamp covered by the rung.
+         * @returns The bucket which covers ts.
+         */
+        Bucket& BucketOf(uint64_t ts)
+        {
+            return m_buckets[(ts - m_start) / m_width];
+        }
+    };
+
+    /**
+     * Spread events over a new rung covering [start, end).
+     *
+     * @param [in] start The first timestamp covered by the rung.
+     * @param [in] end The timestamp past the end of the rung.
+     * @param [in] first The first event to move to the rung.
+     * @param [in] last Past the last event to move to the rung.
+     * @returns The timestamp past the end of the new rung, which is at least end.
+     */
+    uint64_t SpawnRung(uint64_t start,
+                       uint64_t end,
+                       Bucket::iterator first,
+                       Bucket::iterator last);
+    /**
+     * Refill the bottom from the ladder, or the ladder from the top,
+     * until the bottom holds the earliest events or the queue is empty.
+     */
+    void Refill();
+    /** Spread the top over the first rung, or sort it into the bottom if it is small. */
+    void TransferTop();
+    /**
+     * Insert an event in the bottom, keeping it sorted.
+     *
+     * @param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+    /** Spread the later part of an oversized bottom over a new rung. */
+    void SplitBottom();
+    /**
+     * @returns The end of the range of timestamps which belong to the bottom.
+     */
+    uint64_t BottomEnd() const;
+    /**
+     * Remove an event from an unsorted bucket.
+     *
+     * @param [in] bucket The bucket.
+     * @param [in] ev The event.
+     * @returns \c true if the event was found.
+     */
+    static bool RemoveFrom(Bucket& bucket, const Scheduler::Event& ev);
+
+    /** Far-future events, unsorted. */
+    Bucket m_top;
+    /** Timestamps at or after this one belong to the top. */
+    uint64_t m_topStart;
+    /**
+     * The rungs.  Only the first m_nRungs are in use, the others are kept to
+     * recycle their buckets.
+     */
+    std::vector<Rung> m_rungs;
+    /** Number of rungs in use. */
+    uint32_t m_nRungs;
+    /** The earliest events, sorted in decreasing order so the next one is at the back. */
+    Bucket m_bottom;
+    /** Number of events in the queue. */
+    uint32_t m_size;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
@@ -0,0 +1,508 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "log.h"
+#include "nstime.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup logging
+ * ns3::LogBinaryMessage and the binary log file implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup logging
+ * Unnamed namespace for log-binary.cc
+ */
+namespace
+{
+
+/** The magic number of the binary log files. */
+constexpr char LOG_BINARY_MAGIC[8] = {'N', 'S', '3', 'L', 'O', 'G', 'B', '1'};
+
+/** The kinds of entries of a binary log file. */
+enum LogBinaryEntry : uint8_t
+{
+    LOG_BINARY_STRING = 1, //!< The definition of a string id.
+    LOG_BINARY_MESSAGE = 2 //!< A message.
+};
+
+/** The header of a message in the binary log file, followed by its text. */
+struct LogBinaryHeader
+{
+    uint8_t entry;      //!< LOG_BINARY_MESSAGE.
+    uint8_t parameters; //!< 1 if the text is the list of parameters of NS_LOG_FUNCTION.
+    uint16_t reserved;  //!< Padding, 0.
+    uint32_t component; //!< The string id of the LogComponent name.
+    uint32_t function;  //!< The string id of the function name.
+    uint32_t level;     //!< The log level and the prefixes to print.
+    uint32_t context;   //!< The simulation context.
+    uint32_t length;    //!< The length of the text.
+    int64_t time;       //!< The simulation time, in time steps.
+};
+
+/** The capacity in bytes of the ring buffer of each thread. */
+constexpr std::size_t LOG_BINARY_RING_SIZE = 1 << 20;
+
+/**
+ * A single producer, single consumer ring buffer of messages.
+ *
+ * The logging thread appends whole messages, and the writer thread
+ * copies them to the file.
+ */
+class LogBinaryRing
+{
+  public:
+    /**
+     * Append a message, waiting for the writer thread if the buffer is full.
+     * @param [in] header The header of the message.
+     * @param [in] text The text of the message.
+     */
+    void Push(const LogBinaryHeader& header, std::string_view text)
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        std::size_t size = sizeof(header) + text.size();
+        while (head + size - m_tail.load(std::memory_order_acquire) > LOG_BINARY_RING_SIZE)
+        {
+            std::this_thread::yield();
+        }
+        Copy(head, reinterpret_cast<const char*>(&header), sizeof(header));
+        Copy(head + sizeof(header), text.data(), text.size());
+        m_head.store(head + size, std::memory_order_release);
+    }
+
+    /**
+     * Copy the messages to a file.
+     * @param [in] os The file.
+     */
+    void Drain(std::ostream& os)
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        if (head == tail)
+        {
+            return;
+        }
+        std::size_t offset = tail % LOG_BINARY_RING_SIZE;
+        std::size_t size = head - tail;
+        std::size_t first = std::min(size, LOG_BINARY_RING_SIZE - offset);
+        os.write(m_buffer.get() + offset, first);
+        os.write(m_buffer.get(), size - first);
+        m_tail.store(head, std::memory_order_release);
+    }
+
+  private:
+    /**
+     * Copy bytes to the buffer.
+     * @param [in] position The position of the bytes in the stream of messages.
+     * @param [in] data The bytes.
+     * @param [in] size The number of bytes.
+     */
+    void Copy(uint64_t position, const char* data, std::size_t size)
+    {
+        std::size_t offset = position % LOG_BINARY_RING_SIZE;
+        std::size_t first = std::min(size, LOG_BINARY_RING_SIZE - offset);
+        std::memcpy(m_buffer.get() + offset, data, first);
+        std::memcpy(m_buffer.get(), data + first, size - first);
+    }
+
+    /** The buffer. */
+    std::unique_ptr<char[]> m_buffer{new char[LOG_BINARY_RING_SIZE]};
+    std::atomic<uint64_t> m_head{0}; //!< The bytes appended, written by the logging thread.
+    std::atomic<uint64_t> m_tail{0}; //!< The bytes copied, written by the writer thread.
+};
+
+/** The binary log file, and its writer thread. */
+struct LogBinaryFile
+{
+    /** Destructor: flush the file at exit. */
+    ~LogBinaryFile();
+
+    /** Stop the writer thread and close the file. */
+    void Close();
+
+    /** The writer thread: copy the strings and messages to the file. */
+    void Write();
+
+    std::mutex mutex;            //!< Protects the members below, not the ring contents.
+    std::condition_variable cv;  //!< Wakes up the writer thread to stop.
+    std::ofstream file;          //!< The file, written by the writer thread.
+    std::thread writer;          //!< The writer thread.
+    bool stop{false};            //!< Stop the writer thread.
+    uint64_t generation{0};      //!< The number of files opened.
+    std::string strings;         //!< The string definitions not written yet.
+    uint32_t nStrings{0};        //!< The number of string ids.
+    std::unordered_map<const void*, uint32_t> ids; //!< The string ids, by address.
+    std::vector<std::shared_ptr<LogBinaryRing>> rings; //!< The rings of the threads.
+};
+
+/**
+ * Get the binary log file.
+ * @returns The binary log file.
+ */
+LogBinaryFile&
+GetLogBinaryFile()
+{
+    static LogBinaryFile file;
+    return file;
+}
+
+/** \c true while the binary log file is open. */
+std::atomic<bool> g_logBinary{false};
+
+LogBinaryFile::~LogBinaryFile()
+{
+    Close();
+}
+
+void
+LogBinaryFile::Close()
+{
+    if (!writer.joinable())
+    {
+        return;
+    }
+    g_logBinary = false;
+    {
+        std::lock_guard lock(mutex);
+        stop = true;
+    }
+    cv.notify_one();
+    writer.join();
+    file.close();
+    std::lock_guard lock(mutex);
+    rings.clear();
+    ids.clear();
+    strings.clear();
+    stop = false;
+}
+
+void
+LogBinaryFile::Write()
+{
+    bool stopping = false;
+    while (!stopping)
+    {
+        std::vector<std::shared_ptr<LogBinaryRing>> current;
+        {
+            std::unique_lock lock(mutex);
+            cv.wait_for(lock, std::chrono::milliseconds(1), [this]() { return stop; });
+            stopping = stop;
+            // the strings are defined before the messages using them are
+            // pushed, so they are written first
+            file.write(strings.data(), strings.size());
+            strings.clear();
+            current = rings;
+        }
+        for (const auto& ring : current)
+        {
+            ring->Drain(file);
+        }
+    }
+    file.flush();
+}
+
+/** The state of a logging thread. */
+struct LogBinaryThread
+{
+    uint64_t generation{0};                        //!< The file of the members below.
+    std::shared_ptr<LogBinaryRing> ring;           //!< The ring of the thread.
+    std::unordered_map<const void*, uint32_t> ids; //!< The string ids known to the thread.
+    std::vector<std::unique_ptr<std::stringstream>> streams; //!< The streams, by nesting depth.
+    std::size_t depth{0};                                    //!< The nesting depth.
+};
+
+/**
+ * Get the state of the calling thread.
+ * @returns The state of the calling thread.
+ */
+LogBinaryThread&
+GetLogBinaryThread()
+{
+    thread_local LogBinaryThread state;
+    return state;
+}
+
+/**
+ * Get the id of a string, defining it in the file the first time.
+ * @param [in] thread The state of the calling thread.
+ * @param [in] key The address identifying the string.
+ * @param [in] name The string.
+ * @returns The id of the string.
+ */
+uint32_t
+GetStringId(LogBinaryThread& thread, const void* key, const std::string& name)
+{
+    auto it = thread.ids.find(key);
+    if (it != thread.ids.end())
+    {
+        return it->second;
+    }
+    LogBinaryFile& file = GetLogBinaryFile();
+    std::lock_guard lock(file.mutex);
+    auto [fileIt, inserted] = file.ids.insert({key, file.nStrings});
+    if (inserted)
+    {
+        uint32_t id = file.nStrings++;
+        auto length = static_cast<uint32_t>(name.size());
+        file.strings.push_back(LOG_BINARY_STRING);
+        file.strings.append(reinterpret_cast<const char*>(&id), sizeof(id));
+        file.strings.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        file.strings.append(name);
+    }
+    thread.ids[key] = fileIt->second;
+    return fileIt->second;
+}
+
+/**
+ * Write the simulation time as DefaultTimePrinter() does.
+ * @param [in] os The output stream.
+ * @param [in] time The time, in time steps.
+ * @param [in] unit The time resolution.
+ */
+void
+PrintTime(std::ostream& os, int64_t time, Time::Unit unit)
+{
+    std::ios_base::fmtflags ff = os.flags();
+    std::streamsize oldPrecision = os.precision();
+    os << std::fixed;
+    switch (unit)
+    {
+    case Time::US:
+        os << std::setprecision(6);
+        break;
+    case Time::NS:
+        os << std::setprecision(9);
+        break;
+    case Time::PS:
+        os << std::setprecision(12);
+        break;
+    case Time::FS:
+        os << std::setprecision(15);
+        break;
+    default:
+        os << std::setprecision(5);
+    }
+    os << Time::From(time, unit).As(Time::S);
+    os << std::setprecision(oldPrecision);
+    os.flags(ff);
+}
+
+} // Unnamed namespace
+
+void
+LogSetBinaryFile(const std::string& filename)
+{
+    LogBinaryFile& file = GetLogBinaryFile();
+    file.Close();
+    if (filename.empty())
+    {
+        return;
+    }
+    file.file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file.file.is_open())
+    {
+        NS_FATAL_ERROR("Cannot open the binary log file " << filename);
+    }
+    auto resolution = static_cast<int32_t>(Time::GetResolution());
+    file.file.write(LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC));
+    file.file.write(reinterpret_cast<const char*>(&resolution), sizeof(resolution));
+    file.generation++;
+    file.nStrings = 0;
+    file.writer = std::thread(&LogBinaryFile::Write, &file);
+    g_logBinary = true;
+}
+
+bool
+LogIsBinary()
+{
+    return g_logBinary.load(std::memory_order_relaxed);
+}
+
+LogBinaryMessage::LogBinaryMessage(const LogComponent& component,
+                                   const char* function,
+                                   LogLevel level,
+                                   bool parameters)
+{
+    LogBinaryThread& thread = GetLogBinaryThread();
+    LogBinaryFile& file = GetLogBinaryFile();
+    if (thread.generation != file.generation)
+    {
+        std::lock_guard lock(file.mutex);
+        thread.generation = file.generation;
+        thread.ids.clear();
+        thread.ring = std::make_shared<LogBinaryRing>();
+        file.rings.push_back(thread.ring);
+    }
+
+    // a message may be logged while the arguments of another one are
+    // streamed, so each nesting depth has its own stream
+    m_depth = thread.depth++;
+    if (m_depth == thread.streams.size())
+    {
+        thread.streams.push_back(std::make_unique<std::stringstream>());
+    }
+    std::stringstream& stream = *thread.streams[m_depth];
+    stream.str("");
+    stream.clear();
+    stream.flags(std::ios_base::dec | std::ios_base::skipws | std::ios_base::boolalpha);
+
+    LogBinaryHeader header{};
+    header.entry = LOG_BINARY_MESSAGE;
+    header.parameters = parameters;
+    header.component = GetStringId(thread, &component, component.Name());
+    header.function = GetStringId(thread, function, function);
+    header.level = level;
+    for (auto prefix : {LOG_PREFIX_FUNC, LOG_PREFIX_LEVEL})
+    {
+        if (component.IsEnabled(prefix))
+        {
+            header.level |= prefix;
+        }
+    }
+    // as with the text log, the time and node prefixes need a simulator
+    if (LogGetTimePrinter() && component.IsEnabled(LOG_PREFIX_TIME))
+    {
+        header.level |= LOG_PREFIX_TIME;
+        header.time = Simulator::Now().GetTimeStep();
+    }
+    if (LogGetNodePrinter() && component.IsEnabled(LOG_PREFIX_NODE))
+    {
+        header.level |= LOG_PREFIX_NODE;
+        header.context = Simulator::GetContext();
+    }
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+LogBinaryMessage::~LogBinaryMessage()
+{
+    LogBinaryThread& thread = GetLogBinaryThread();
+    thread.depth--;
+    std::string_view message = thread.streams[m_depth]->view();
+    LogBinaryHeader header;
+    std::memcpy(&header, message.data(), sizeof(header));
+    // a message too long for the ring is truncated
+    std::string_view text =
+        message.substr(sizeof(header), LOG_BINARY_RING_SIZE / 2 - sizeof(header));
+    header.length = static_cast<uint32_t>(text.size());
+    thread.ring->Push(header, text);
+}
+
+std::ostream&
+LogBinaryMessage::GetStream()
+{
+    return *GetLogBinaryThread().streams[m_depth];
+}
+
+bool
+LogBinaryDecode(std::istream& is, std::ostream& os)
+{
+    char magic[sizeof(LOG_BINARY_MAGIC)];
+    int32_t resolution;
+    is.read(magic, sizeof(magic));
+    is.read(reinterpret_cast<char*>(&resolution), sizeof(resolution));
+    if (!is || std::memcmp(magic, LOG_BINARY_MAGIC, sizeof(magic)) != 0)
+    {
+        return false;
+    }
+    auto unit = static_cast<Time::Unit>(resolution);
+
+    // the messages of a thread may use a string defined after them by
+    // another thread, so all the strings are read first
+    std::streampos start = is.tellg();
+    std::unordered_map<uint32_t, std::string> strings;
+    for (bool messages : {false, true})
+    {
+        is.clear();
+        is.seekg(start);
+        LogBinaryHeader header;
+        std::string text;
+        while (is.read(reinterpret_cast<char*>(&header.entry), 1))
+        {
+            if (header.entry == LOG_BINARY_STRING)
+            {
+                uint32_t id;
+                uint32_t length;
+                is.read(reinterpret_cast<char*>(&id), sizeof(id));
+                is.read(reinterpret_cast<char*>(&length), sizeof(length));
+                text.resize(length);
+                is.read(text.data(), length);
+                strings[id] = text;
+                continue;
+            }
+            if (header.entry != LOG_BINARY_MESSAGE)
+            {
+                return false;
+            }
+            is.read(reinterpret_cast<char*>(&header) + 1, sizeof(header) - 1);
+            text.resize(header.length);
+            is.read(text.data(), header.length);
+            if (!is)
+            {
+                return false;
+            }
+            if (!messages)
+            {
+                continue;
+            }
+
+            auto level = static_cast<LogLevel>(header.level);
+            const std::string& component = strings[header.component];
+            const std::string& function = strings[header.function];
+            if (level & LOG_PREFIX_TIME)
+            {
+                PrintTime(os, header.time, unit);
+                os << " ";
+            }
+            if (level & LOG_PREFIX_NODE)
+            {
+                if (header.context == Simulator::NO_CONTEXT)
+                {
+                    os << "-1 ";
+                }
+                else
+                {
+                    os << header.context << " ";
+                }
+            }
+            if (header.parameters)
+            {
+                os << component << ":" << function << "(" << text << ")\n";
+                continue;
+            }
+            if (level & LOG_PREFIX_FUNC)
+            {
+                os << component << ":" << function << "(): ";
+            }
+            if (level & LOG_PREFIX_LEVEL)
+            {
+                os << "[" << LogComponent::GetLevelLabel(LogLevel(level & ~LOG_PREFIX_ALL))
+                   << "] ";
+            }
+            os << text << "\n";
+        }
+    }
+    return true;
+}
+
+} // namespace ns3
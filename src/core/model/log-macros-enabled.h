@@ -173,6 +173,11 @@
     {                                                                                              \
         if (g_log.IsEnabled(level))                                                                \
         {                                                                                          \
+            if (ns3::LogIsBinary())                                                                \
+            {                                                                                      \
+                ns3::LogBinaryMessage(g_log, __FUNCTION__, level).GetStream() << msg;              \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -198,6 +203,11 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
+            if (ns3::LogIsBinary())                                                                \
+            {                                                                                      \
+                ns3::LogBinaryMessage(g_log, __FUNCTION__, ns3::LOG_FUNCTION, true);               \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
@@ -234,6 +244,14 @@
     {                                                                                              \
         if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
         {                                                                                          \
+            if (ns3::LogIsBinary())                                                                \
+            {                                                                                      \
+                ns3::ParameterLogger(                                                              \
+                    ns3::LogBinaryMessage(g_log, __FUNCTION__, ns3::LOG_FUNCTION, true)            \
+                        .GetStream())                                                              \
+                    << parameters;                                                                 \
+                break;                                                                             \
+            }                                                                                      \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
             NS_LOG_APPEND_CONTEXT;                                                                 \
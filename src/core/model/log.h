@@ -313,6 +313,36 @@ void LogSetNodePrinter(NodePrinter np);
  */
 NodePrinter LogGetNodePrinter();
 
+/**
+ * Write the log messages to a binary file instead of std::clog.
+ *
+ * The messages are formatted on the logging thread, but their prefixes
+ * are stored as raw values and the file is written by a background
+ * thread, from a ring buffer per logging thread.  The file is flushed
+ * when the binary log is stopped, or at exit.  LogBinaryDecode(), and
+ * the \c log-decode utility, print it as text.
+ *
+ * This must not be called while other threads are logging.
+ *
+ * @param [in] filename The name of the binary log file, or an empty
+ *             string to stop writing it and go back to std::clog.
+ */
+void LogSetBinaryFile(const std::string& filename);
+/**
+ * Check if the log messages are written to a binary file.
+ * @returns \c true if LogSetBinaryFile() has opened a binary log file.
+ */
+bool LogIsBinary();
+/**
+ * Print the messages of a binary log file as text, as they would have
+ * been written to std::clog.
+ *
+ * @param [in] is The binary log file.
+ * @param [in] os The output stream.
+ * @returns \c false if \pname{is} is not a binary log file.
+ */
+bool LogBinaryDecode(std::istream& is, std::ostream& os);
+
 /**
  * A single log component configuration.
  */
@@ -475,6 +505,46 @@ class ParameterLogger
     // end of class ParameterLogger
 };
 
+/**
+ * A log message written to the binary log file.
+ *
+ * The message is streamed to GetStream(), and stored in the ring buffer
+ * of the thread when the LogBinaryMessage is destroyed.  The time and
+ * node prefixes are taken from the simulator when the message is created.
+ */
+class LogBinaryMessage
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] component The LogComponent, whose prefix flags are used.
+     * @param [in] function The name of the function logging the message.
+     * @param [in] level The log level of the message.
+     * @param [in] parameters \c true if the message is the list of
+     *             parameters of an NS_LOG_FUNCTION() message.
+     */
+    LogBinaryMessage(const LogComponent& component,
+                     const char* function,
+                     LogLevel level,
+                     bool parameters = false);
+    /** Destructor: store the message. */
+    ~LogBinaryMessage();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogBinaryMessage(const LogBinaryMessage&) = delete;
+    LogBinaryMessage& operator=(const LogBinaryMessage&) = delete;
+
+    /**
+     * Get the stream to write the message to.
+     * @returns The stream.
+     */
+    std::ostream& GetStream();
+
+  private:
+    std::size_t m_depth; //!< The nesting depth, selecting the buffer of the message.
+};
+
 template <typename T>
 ParameterLogger&
 ParameterLogger::operator<<(const T& param)
@@ -523,6 +523,19 @@ class CORE_EXPORT Time
             return Time();
         }
 
+        // Optimization: a whole number of a unit at least as coarse as the
+        // resolution is an exact integer product, as computed by From()
+        Information* info = PeekInformation(unit);
+        if (info->isValid && info->fromMul &&
+            std::fabs(value) * info->factor < MAX_EXACT_PRODUCT)
+        {
+            auto n = static_cast<int64_t>(value);
+            if (n == value)
+            {
+                return Time(n * info->factor);
+            }
+        }
+
         return From(int64x64_t(value), unit);
     }
 
@@ -598,6 +611,15 @@ class CORE_EXPORT Time
             return 0;
         }
 
+        // Optimization: converting to the resolution or a finer unit is an
+        // exact integer product, as computed by To()
+        Information* info = PeekInformation(unit);
+        if (info->isValid && info->toMul &&
+            std::fabs(static_cast<double>(m_data)) * info->factor < MAX_EXACT_PRODUCT)
+        {
+            return static_cast<double>(m_data * info->factor);
+        }
+
         return To(unit).GetDouble();
     }
 
@@ -663,6 +685,12 @@ class CORE_EXPORT Time
     typedef void (*TracedCallback)(Time value);
 
   private:
+    /**
+     * Bound on the magnitude of the integer products computed without
+     * int64x64_t, with margin for the rounding of the check in double.
+     */
+    static constexpr double MAX_EXACT_PRODUCT = 0x1p62;
+
     /** How to convert between other units and the current unit. */
     struct Information
     {
@@ -766,9 +794,17 @@ class CORE_EXPORT Time
      *  before calling Mark(). Likewise, the dtor also needs to check before
      *  calling Clear(). On Windows, attempting to access g_markingTimes
      *  directly from outside the compilation unit is an access violation so
-     *  this method is provided to work around that limitation.
+     *  this method is provided to work around that limitation.  Elsewhere
+     *  it is inline, since every Time constructor calls it.
      */
+#ifdef _WIN32
     static bool MarkingTimes();
+#else
+    static bool MarkingTimes()
+    {
+        return (g_markingTimes != nullptr);
+    }
+#endif
 
   public:
     /**
@@ -1071,6 +1107,16 @@ template <class T>
 std::enable_if_t<std::is_floating_point_v<T>, Time>
 operator*(const Time& lhs, T rhs)
 {
+    // Optimization: scaling by a whole number is an exact integer product
+    if (std::fabs(static_cast<double>(lhs.m_data) * rhs) < Time::MAX_EXACT_PRODUCT &&
+        std::fabs(rhs) < Time::MAX_EXACT_PRODUCT)
+    {
+        auto n = static_cast<int64_t>(rhs);
+        if (n == rhs)
+        {
+            return Time(lhs.m_data * n);
+        }
+    }
     return lhs * int64x64_t(rhs);
 }
 
@@ -1157,6 +1203,15 @@ template <class T>
 std::enable_if_t<std::is_floating_point_v<T>, Time>
 operator/(const Time& lhs, T rhs)
 {
+    // Optimization: an exact division by a whole number is an integer quotient
+    if (rhs > 0 && rhs < Time::MAX_EXACT_PRODUCT)
+    {
+        auto n = static_cast<int64_t>(rhs);
+        if (n == rhs && lhs.m_data % n == 0)
+        {
+            return Time(lhs.m_data / n);
+        }
+    }
     return lhs / int64x64_t(rhs);
 }
 
@@ -95,6 +95,9 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
                     "initial values of the object attributes as soon as object construction is "
                     "completed (see issue #1249)\n"
                     "- the class deriving from Object does not define a static GetTypeId() method");
+    // look up the default values in the environment only if it defines some
+    auto envDefaults = EnvironmentVariable::GetDictionary("NS_ATTRIBUTE_DEFAULT");
+    bool hasEnvDefaults = envDefaults->Get().first;
     do // Do this tid and all parents
     {
         // loop over all attributes in object type
@@ -131,11 +134,10 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
                 }
             }
 
-            if (!value)
+            if (!value && hasEnvDefaults)
             {
                 NS_LOG_DEBUG("trying to set from environment variable NS_ATTRIBUTE_DEFAULT");
-                auto [found, val] =
-                    EnvironmentVariable::Get("NS_ATTRIBUTE_DEFAULT", tid.GetAttributeFullName(i));
+                auto [found, val] = envDefaults->Get(tid.GetAttributeFullName(i));
                 if (found)
                 {
                     NS_LOG_DEBUG("found in environment: " << val);
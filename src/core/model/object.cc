@@ -13,10 +13,15 @@
 #include "attribute.h"
 #include "log.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * @file
  * @ingroup object
@@ -94,11 +99,9 @@ Object::Object()
     : m_tid(Object::GetTypeId()),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
-      m_getObjectCount(0)
+      m_aggregates(AllocateAggregates(1))
 {
     NS_LOG_FUNCTION(this);
-    m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
 }
 
@@ -116,6 +119,8 @@ Object::~Object()
                          &m_aggregates->buffer[i + 1],
                          sizeof(Object*) * (m_aggregates->n - (i + 1)));
             m_aggregates->n--;
+            // the cached indices of the next aggregates are now wrong
+            ClearCache(m_aggregates);
         }
     }
     // finally, if all objects have been removed from the list,
@@ -132,10 +137,8 @@ Object::Object(const Object& o)
     : m_tid(o.m_tid),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
-      m_getObjectCount(0)
+      m_aggregates(AllocateAggregates(1))
 {
-    m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
 }
 
@@ -146,39 +149,70 @@ Object::Construct(const AttributeConstructionList& attributes)
     ConstructSelf(attributes);
 }
 
+Object::Aggregates*
+Object::AllocateAggregates(uint32_t n)
+{
+    auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (n - 1) * sizeof(Object*));
+    aggregates->n = n;
+    ClearCache(aggregates);
+    return aggregates;
+}
+
+void
+Object::ClearCache(Aggregates* aggregates)
+{
+    std::fill_n(aggregates->cache, CACHE_SIZE, NOT_AGGREGATED);
+}
+
 Ptr<Object>
 Object::DoGetObject(TypeId tid) const
 {
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(CheckLoose());
 
-    // First check if the object is in the normal aggregates.
-    uint32_t n = m_aggregates->n;
+    // First check if the object is in the normal aggregates, starting with
+    // the result of the last lookup of this TypeId.  With NS3_MTP other
+    // threads may look up the same aggregates concurrently, so the cache
+    // entries are accessed atomically.
     TypeId objectTid = Object::GetTypeId();
-    for (uint32_t i = 0; i < n; i++)
+    uint32_t uid = tid.GetUid();
+    uint32_t& entry = m_aggregates->cache[uid % CACHE_SIZE];
+#ifdef NS3_MTP
+    uint32_t cached = std::atomic_ref<uint32_t>(entry).load(std::memory_order_relaxed);
+#else
+    uint32_t cached = entry;
+#endif
+    uint32_t index = cached & NOT_AGGREGATED;
+    if ((cached >> 16) != uid)
     {
-        Object* current = m_aggregates->buffer[i];
-        TypeId cur = current->GetInstanceTypeId();
-        while (cur != tid && cur != objectTid)
+        uint32_t n = m_aggregates->n;
+        index = NOT_AGGREGATED;
+        for (uint32_t i = 0; i < n && index == NOT_AGGREGATED; i++)
         {
-            cur = cur.GetParent();
+            TypeId cur = m_aggregates->buffer[i]->GetInstanceTypeId();
+            while (cur != tid && cur != objectTid)
+            {
+                cur = cur.GetParent();
+            }
+            if (cur == tid)
+            {
+                index = i;
+            }
         }
-        if (cur == tid)
+        if (n < NOT_AGGREGATED)
         {
-            // This is an attempt to 'cache' the result of this lookup.
-            // the idea is that if we perform a lookup for a TypeId on this object,
-            // we are likely to perform the same lookup later so, we make sure
-            // that the aggregate array is sorted by the number of accesses
-            // to each object.
-
-            // first, increment the access count
-            current->m_getObjectCount++;
-            // then, update the sort
-            UpdateSortedArray(m_aggregates, i);
-            // finally, return the match
-            return const_cast<Object*>(current);
+#ifdef NS3_MTP
+            std::atomic_ref<uint32_t>(entry).store((uid << 16) | index,
+                                                   std::memory_order_relaxed);
+#else
+            entry = (uid << 16) | index;
+#endif
         }
     }
+    if (index != NOT_AGGREGATED)
+    {
+        return const_cast<Object*>(m_aggregates->buffer[index]);
+    }
 
     // Next check if it's a unidirectional aggregate
     for (auto& uniItem : m_unidirectionalAggregates)
@@ -277,20 +311,6 @@ restart:
     }
 }
 
-void
-Object::UpdateSortedArray(Aggregates* aggregates, uint32_t j) const
-{
-    NS_LOG_FUNCTION(this << aggregates << j);
-    while (j > 0 &&
-           aggregates->buffer[j]->m_getObjectCount > aggregates->buffer[j - 1]->m_getObjectCount)
-    {
-        Object* tmp = aggregates->buffer[j - 1];
-        aggregates->buffer[j - 1] = aggregates->buffer[j];
-        aggregates->buffer[j] = tmp;
-        j--;
-    }
-}
-
 void
 Object::AggregateObject(Ptr<Object> o)
 {
@@ -303,8 +323,7 @@ Object::AggregateObject(Ptr<Object> o)
     Object* other = PeekPointer(o);
     // first create the new aggregate buffer.
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
-    auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
-    aggregates->n = total;
+    Aggregates* aggregates = AllocateAggregates(total);
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -324,7 +343,6 @@ Object::AggregateObject(Ptr<Object> o)
                            << other->GetInstanceTypeId() << " on objects of type "
                            << GetInstanceTypeId());
         }
-        UpdateSortedArray(aggregates, m_aggregates->n + i);
     }
 
     // keep track of the old aggregate buffers for the iteration
@@ -367,6 +367,11 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /** Number of entries of the lookup cache of the aggregates. */
+    static constexpr uint32_t CACHE_SIZE = 16;
+    /** Cache entry index of an Object which is not in the aggregates. */
+    static constexpr uint32_t NOT_AGGREGATED = 0xffff;
+
     /**
      * The list of Objects aggregated to this one.
      *
@@ -383,10 +388,34 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /**
+         * The results of the recent lookups, so that GetObject() does not
+         * need to scan \c buffer and walk the TypeId hierarchy of its
+         * Objects again.  An entry is indexed by the uid of the TypeId
+         * looked up modulo CACHE_SIZE, and holds that uid in its upper 16
+         * bits and the index in \c buffer of the matching Object, or
+         * NOT_AGGREGATED, in its lower 16 bits.  The cache is shared, like
+         * \c buffer, by all the aggregated Objects.
+         */
+        uint32_t cache[CACHE_SIZE];
         /** The array of Objects. */
         Object* buffer[1];
     };
 
+    /**
+     * Allocate a list of aggregates, with an empty lookup cache.
+     *
+     * @param [in] n The number of aggregates.
+     * @return The list, to free with std::free().
+     */
+    static Aggregates* AllocateAggregates(uint32_t n);
+    /**
+     * Clear the lookup cache of a list of aggregates.
+     *
+     * @param [in,out] aggregates The list of aggregated Objects.
+     */
+    static void ClearCache(Aggregates* aggregates);
+
     /**
      * Find an Object of TypeId tid in the aggregates of this Object.
      *
@@ -434,13 +463,6 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      */
     void Construct(const AttributeConstructionList& attributes);
 
-    /**
-     * Keep the list of aggregates in most-recently-used order
-     *
-     * @param [in,out] aggregates The list of aggregated Objects.
-     * @param [in] i The most recently used entry in the list.
-     */
-    void UpdateSortedArray(Aggregates* aggregates, uint32_t i) const;
     /**
      * Attempt to delete this Object.
      *
@@ -482,15 +504,6 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * Aggregation would create an issue.
      */
     std::vector<Ptr<Object>> m_unidirectionalAggregates;
-
-    /**
-     * The number of times the Object was accessed with a
-     * call to GetObject().
-     *
-     * This integer is used to implement a heuristic to sort
-     * the array of aggregates in most-frequently accessed order.
-     */
-    uint32_t m_getObjectCount;
 };
 
 template <typename T>
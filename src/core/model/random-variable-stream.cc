@@ -23,6 +23,7 @@
 #include "rng-stream.h"
 #include "string.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <numbers>
@@ -132,12 +133,69 @@ RandomVariableStream::GetStream() const
     return m_stream;
 }
 
+void
+RandomVariableStream::GetValues(std::span<double> values)
+{
+    for (auto& value : values)
+    {
+        value = GetValue();
+    }
+}
+
 RngStream*
 RandomVariableStream::Peek() const
 {
     return m_rng;
 }
 
+namespace
+{
+
+/**
+ * Fill a buffer with random values each computed from one uniform value,
+ * drawing again for the values above a bound, in the order successive
+ * scalar draws would use the uniform values.
+ *
+ * @tparam Transform \deduced The type of the transform.
+ * @param [in] rng The RngStream to draw the uniform values from.
+ * @param [in] antithetic Whether to use antithetic uniform values.
+ * @param [out] values The random values.
+ * @param [in] bound The upper bound on the values, or 0 for no bound.
+ * @param [in] transform The transform of a uniform value to a random value.
+ */
+template <typename Transform>
+void
+GetBoundedValues(RngStream* rng,
+                 bool antithetic,
+                 std::span<double> values,
+                 double bound,
+                 Transform transform)
+{
+    while (!values.empty())
+    {
+        rng->RandU01(values);
+        if (antithetic)
+        {
+            for (auto& v : values)
+            {
+                v = (1 - v);
+            }
+        }
+        std::size_t accepted = 0;
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            double r = transform(values[i]);
+            if (bound == 0 || r <= bound)
+            {
+                values[accepted++] = r;
+            }
+        }
+        values = values.subspan(accepted);
+    }
+}
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(UniformRandomVariable);
 
 TypeId
@@ -208,6 +266,25 @@ UniformRandomVariable::GetValue()
     return GetValue(m_min, m_max);
 }
 
+void
+UniformRandomVariable::GetValues(std::span<double> values)
+{
+    Peek()->RandU01(values);
+    for (auto& v : values)
+    {
+        v = m_min + v * (m_max - m_min);
+    }
+    if (IsAntithetic())
+    {
+        for (auto& v : values)
+        {
+            v = m_min + (m_max - v);
+        }
+    }
+    NS_LOG_DEBUG(values.size() << " values, stream: " << GetStream() << " min: " << m_min
+                               << " max: " << m_max);
+}
+
 uint32_t
 UniformRandomVariable::GetInteger()
 {
@@ -266,6 +343,12 @@ ConstantRandomVariable::GetValue()
     return GetValue(m_constant);
 }
 
+void
+ConstantRandomVariable::GetValues(std::span<double> values)
+{
+    std::fill(values.begin(), values.end(), m_constant);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(SequentialRandomVariable);
 
 TypeId
@@ -441,6 +524,17 @@ ExponentialRandomVariable::GetValue()
     return GetValue(m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues(std::span<double> values)
+{
+    double mean = m_mean;
+    GetBoundedValues(Peek(), IsAntithetic(), values, m_bound, [mean](double v) {
+        return -mean * std::log(v);
+    });
+    NS_LOG_DEBUG(values.size() << " values, stream: " << GetStream() << " mean: " << m_mean
+                               << " bound: " << m_bound);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId
@@ -537,6 +631,18 @@ ParetoRandomVariable::GetValue()
     return GetValue(m_scale, m_shape, m_bound);
 }
 
+void
+ParetoRandomVariable::GetValues(std::span<double> values)
+{
+    double scale = m_scale;
+    double exponent = 1.0 / m_shape;
+    GetBoundedValues(Peek(), IsAntithetic(), values, m_bound, [scale, exponent](double v) {
+        return (scale * (1.0 / std::pow(v, exponent)));
+    });
+    NS_LOG_DEBUG(values.size() << " values, stream: " << GetStream() << " scale: " << m_scale
+                               << " shape: " << m_shape << " bound: " << m_bound);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(WeibullRandomVariable);
 
 TypeId
@@ -648,6 +754,17 @@ WeibullRandomVariable::GetValue()
     return GetValue(m_scale, m_shape, m_bound);
 }
 
+void
+WeibullRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    double scale = m_scale;
+    double exponent = 1.0 / m_shape;
+    GetBoundedValues(Peek(), IsAntithetic(), values, m_bound, [scale, exponent](double v) {
+        return scale * std::pow(-std::log(v), exponent);
+    });
+}
+
 NS_OBJECT_ENSURE_REGISTERED(NormalRandomVariable);
 
 TypeId
@@ -786,6 +903,17 @@ NormalRandomVariable::GetValue()
     return GetValue(m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues(std::span<double> values)
+{
+    // The polar method rejects pairs of uniform values, and caches the
+    // second value of a pair: draw each value as GetValue() does.
+    for (auto& value : values)
+    {
+        value = GetValue(m_mean, m_variance, m_bound);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId
@@ -21,6 +21,7 @@
 
 #include <limits>
 #include <map>
+#include <span>
 #include <stdint.h>
 
 /**
@@ -144,6 +145,18 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * @brief Fill a buffer with the next random values drawn from the
+     * distribution, the same values as successive calls to GetValue().
+     *
+     * The base implementation calls GetValue() for each value.  The
+     * distributions which transform one uniform value per value draw all
+     * their uniform values at once.
+     *
+     * @param [out] values The random values.
+     */
+    virtual void GetValues(std::span<double> values);
+
   protected:
     /**
      * @brief Get the pointer to the underlying RngStream.
@@ -269,6 +282,9 @@ class UniformRandomVariable : public RandomVariableStream
      */
     double GetValue() override;
 
+    // Inherited
+    void GetValues(std::span<double> values) override;
+
     /**
      * @copydoc RandomVariableStream::GetInteger()
      * @note The upper limit is included in the output range, unlike GetValue().
@@ -331,6 +347,8 @@ class ConstantRandomVariable : public RandomVariableStream
      * @note This RNG always returns the same value.
      */
     double GetValue() override;
+    // Inherited
+    void GetValues(std::span<double> values) override;
     /* \note This RNG always returns the same value. */
     using RandomVariableStream::GetInteger;
 
@@ -586,6 +604,7 @@ class ExponentialRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void GetValues(std::span<double> values) override;
     using RandomVariableStream::GetInteger;
 
   private:
@@ -723,6 +742,7 @@ class ParetoRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void GetValues(std::span<double> values) override;
     using RandomVariableStream::GetInteger;
 
   private:
@@ -884,6 +904,7 @@ class WeibullRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void GetValues(std::span<double> values) override;
     using RandomVariableStream::GetInteger;
 
   private:
@@ -1042,6 +1063,7 @@ class NormalRandomVariable : public RandomVariableStream
 
     // Inherited
     double GetValue() override;
+    void GetValues(std::span<double> values) override;
     using RandomVariableStream::GetInteger;
 
   private:
@@ -7,6 +7,7 @@
 
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
+#include <span>
 #include <stdint.h>
 #include <string>
 
@@ -59,6 +60,13 @@ class RngStream
      * @returns The next random.
      */
     double RandU01();
+    /**
+     * Generate the next random numbers for this stream, the same numbers
+     * as successive calls to RandU01().
+     *
+     * @param [out] values The random numbers.
+     */
+    void RandU01(std::span<double> values);
 
   private:
     /**
@@ -16,6 +16,10 @@
 #include <limits>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * @file
  * @ingroup ptr
@@ -68,6 +72,10 @@ class Empty
  *
  * Interesting users of this class include ns3::Object as well as ns3::Packet.
  *
+ * When ns-3 is built with multithreaded simulation support (NS3_MTP),
+ * the reference count is atomic, since objects may be referenced
+ * from the events of several threads.
+ *
  * Inheritance graph was not generated because of its size.
  * @hideinheritancegraph
  */
@@ -120,8 +128,7 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        if (--m_count == 0)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -146,7 +153,11 @@ class SimpleRefCount : public PARENT
      * Note we make this mutable so that the const methods can still
      * change it.
      */
+#ifdef NS3_MTP
+    mutable std::atomic<uint32_t> m_count;
+#else
     mutable uint32_t m_count;
+#endif
 };
 
 } // namespace ns3
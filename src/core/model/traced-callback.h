@@ -12,13 +12,66 @@
 #include "callback.h"
 
 #include <list>
+#include <vector>
 
 /**
  * @file
  * @ingroup tracing
- * ns3::TracedCallback declaration and template implementation.
+ * ns3::TracedCallback declaration and template implementation,
+ * and the NS_TRACE and NS_TRACE_ALWAYS macros.
  */
 
+/**
+ * @ingroup tracing
+ * @brief Fire a TracedCallback, evaluating the arguments only when a
+ * Callback is connected to it.
+ *
+ * Trace points on the per-packet paths often build their arguments, such
+ * as a Ptr<const Packet> or a copy of a header, only to find that nothing
+ * is connected.  This macro tests the TracedCallback first, so those
+ * arguments cost nothing while the trace source is not connected.
+ *
+ * Unlike NS_TRACE, this macro is kept when tracing is disabled.  Use it
+ * for the trace sources that models connect to, such as the Queue traces
+ * which a QueueDisc and the NetDeviceQueue flow control rely on.
+ *
+ * @param [in] traced The TracedCallback to fire.
+ * @param [in] ... The arguments of the TracedCallback.
+ */
+#define NS_TRACE_ALWAYS(traced, ...)                                                               \
+    do                                                                                             \
+        if (!(traced).IsEmpty()) [[unlikely]]                                                      \
+        {                                                                                          \
+            (traced)(__VA_ARGS__);                                                                 \
+        }                                                                                          \
+    while (false)
+
+/**
+ * @ingroup tracing
+ * @brief Fire a TracedCallback, evaluating the arguments only when a
+ * Callback is connected to it, or not at all if tracing is disabled.
+ *
+ * This is NS_TRACE_ALWAYS for the trace sources that only users connect
+ * to.  When ns-3 is configured with tracing disabled (\c NS3_TRACING=OFF,
+ * which defines \c NS3_TRACING_DISABLE), the trace points written with
+ * this macro are compiled out: connecting to their trace sources still
+ * succeeds, but they never fire.
+ *
+ * @param [in] traced The TracedCallback to fire.
+ * @param [in] ... The arguments of the TracedCallback.
+ */
+#ifndef NS3_TRACING_DISABLE
+#define NS_TRACE(traced, ...) NS_TRACE_ALWAYS(traced, __VA_ARGS__)
+#else
+#define NS_TRACE(traced, ...)                                                                      \
+    do                                                                                             \
+        if (false)                                                                                 \
+        {                                                                                          \
+            (traced)(__VA_ARGS__);                                                                 \
+        }                                                                                          \
+    while (false)
+#endif
+
 namespace ns3
 {
 
@@ -34,7 +87,10 @@ namespace ns3
  *
  * This is a functor: the chain of Callbacks is invoked by
  * calling the \c operator() form with the appropriate
- * number of arguments.
+ * number of arguments.  Most trace sources are never connected, so
+ * the chain is a vector, whose emptiness is checked first: firing an
+ * unconnected TracedCallback is a single test.  Use NS_TRACE to also
+ * skip the construction of the arguments.
  *
  * @tparam Ts \explicit Types of the functor arguments.
  *
@@ -105,7 +161,7 @@ class TracedCallback
      *
      * @tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
     /** The chain of Callbacks. */
     CallbackList m_callbackList;
 };
@@ -184,9 +240,15 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+    if (m_callbackList.empty()) [[likely]]
+    {
+        return;
+    }
+    // A Callback may connect another one to this TracedCallback, which
+    // would invalidate the iterators of the vector
+    for (std::size_t i = 0; i < m_callbackList.size(); i++)
     {
-        (*i)(args...);
+        m_callbackList[i](args...);
     }
 }
 
@@ -12,7 +12,10 @@
 #include "singleton.h"
 #include "trace-source-accessor.h"
 
+#include <algorithm>
+#include <functional>
 #include <map>
+#include <string_view>
 #include <vector>
 
 /**
@@ -33,12 +36,102 @@ NS_LOG_COMPONENT_DEFINE("TypeId");
 // IidManager needs to be in ns3 namespace for NS_ASSERT and NS_LOG
 // to find g_log
 
+/**
+ * @ingroup object
+ * @brief A flat open addressing index of the IidManager records.
+ *
+ * The index maps a 64-bit hash to a non-zero value, with linear probing
+ * in a power of two sized table which is kept at most half full.  The
+ * hashes are not unique, so Find() checks the entries with the requested
+ * hash with a predicate comparing the actual keys, which are stored in
+ * the records of the IidManager.
+ */
+class IidIndex
+{
+  public:
+    /**
+     * Find a value.
+     * @tparam Match \deduced The type of the predicate.
+     * @param [in] hash The hash of the key.
+     * @param [in] match The predicate, called with each value whose key
+     *             has the same hash until it returns \c true.
+     * @returns The value found, or 0 if none matches.
+     */
+    template <typename Match>
+    uint32_t Find(uint64_t hash, Match match) const
+    {
+        if (m_entries.empty())
+        {
+            return 0;
+        }
+        std::size_t mask = m_entries.size() - 1;
+        for (std::size_t i = hash & mask; m_entries[i].value != 0; i = (i + 1) & mask)
+        {
+            if (m_entries[i].hash == hash && match(m_entries[i].value))
+            {
+                return m_entries[i].value;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * Add a value.
+     * @param [in] hash The hash of the key.
+     * @param [in] value The value, which must not be 0.
+     */
+    void Insert(uint64_t hash, uint32_t value)
+    {
+        if (2 * (m_size + 1) > m_entries.size())
+        {
+            std::vector<Entry> entries(std::max<std::size_t>(2 * m_entries.size(), 512));
+            std::swap(entries, m_entries);
+            for (const auto& entry : entries)
+            {
+                if (entry.value != 0)
+                {
+                    Place(entry);
+                }
+            }
+        }
+        Place({hash, value});
+        m_size++;
+    }
+
+  private:
+    /** An entry of the table. */
+    struct Entry
+    {
+        uint64_t hash;  //!< The hash of the key.
+        uint32_t value; //!< The value, 0 for a free entry.
+    };
+
+    /**
+     * Store an entry in the first free slot of its probe sequence.
+     * @param [in] entry The entry.
+     */
+    void Place(const Entry& entry)
+    {
+        std::size_t mask = m_entries.size() - 1;
+        std::size_t i = entry.hash & mask;
+        while (m_entries[i].value != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        m_entries[i] = entry;
+    }
+
+    std::vector<Entry> m_entries; //!< The table, of a power of two size.
+    std::size_t m_size{0};        //!< The number of values stored.
+};
+
 /**
  * @ingroup object
  * @brief TypeId information manager
  *
- * Information records are stored in a vector.  Name and hash lookup
- * are performed by maps to the vector index.
+ * Information records are stored in a vector.  Name lookup, and the
+ * lookup of an Attribute by name in a type id, are performed through
+ * flat hash indexes of the vector; hash lookup through a map.
  *
  * @internal
  * <b>Hash Chaining</b>
@@ -112,7 +205,7 @@ class IidManager : public Singleton<IidManager>
      * @param [in] name The type id to find.
      * @returns The type id.  A type id of 0 means \pname{name} wasn't found.
      */
-    uint16_t GetUid(std::string name) const;
+    uint16_t GetUid(const std::string& name) const;
     /**
      * Get a type id by hash value.
      * @param [in] hash The type id to find.
@@ -228,7 +321,16 @@ class IidManager : public Singleton<IidManager>
      * @param [in] i Index into attribute array
      * @returns The information associated to attribute whose index is \pname{i}.
      */
-    TypeId::AttributeInformation GetAttribute(uint16_t uid, std::size_t i) const;
+    const TypeId::AttributeInformation& GetAttribute(uint16_t uid, std::size_t i) const;
+    /**
+     * Find an Attribute by name in a type id and its parents.
+     * @param [in] uid The id.
+     * @param [in] name The Attribute name.
+     * @returns The id of the type id declaring the Attribute, or 0 if
+     *          the Attribute is not found, and the index of the Attribute
+     *          in that type id.
+     */
+    std::pair<uint16_t, std::size_t> FindAttribute(uint16_t uid, const std::string& name) const;
     /**
      * Record a new TraceSource.
      * @param [in] uid The id.
@@ -291,6 +393,19 @@ class IidManager : public Singleton<IidManager>
      * @returns The hashed value of \pname{name}.
      */
     static TypeId::hash_t Hasher(const std::string name);
+    /**
+     * Hash a name for the indexes.
+     * @param [in] name The type id or Attribute name.
+     * @returns The hashed value of \pname{name}.
+     */
+    static uint64_t IndexHash(std::string_view name);
+    /**
+     * Hash an Attribute name of a type id for the Attribute index.
+     * @param [in] uid The id.
+     * @param [in] nameHash The IndexHash() of the Attribute name.
+     * @returns The hashed value of the pair.
+     */
+    static uint64_t IndexHash(uint16_t uid, uint64_t nameHash);
 
     /** The information record about a single type id. */
     struct IidInformation
@@ -336,10 +451,14 @@ class IidManager : public Singleton<IidManager>
     /** The container of all type id records. */
     std::vector<IidInformation> m_information;
 
-    /** Type of the by-name index. */
-    typedef std::map<std::string, uint16_t> namemap_t;
-    /** The by-name index. */
-    namemap_t m_namemap;
+    /** The by-name index, of the names and deprecated names. */
+    IidIndex m_nameIndex;
+
+    /**
+     * The Attribute index, by type id and Attribute name, of the index
+     * plus one of the Attribute in the attributes of the type id.
+     */
+    IidIndex m_attributeIndex;
 
     /** Type of the by-hash index. */
     typedef std::map<TypeId::hash_t, uint16_t> hashmap_t;
@@ -367,6 +486,20 @@ IidManager::Hasher(const std::string name)
     return hasher.clear().GetHash32(name);
 }
 
+// static
+uint64_t
+IidManager::IndexHash(std::string_view name)
+{
+    return std::hash<std::string_view>{}(name);
+}
+
+// static
+uint64_t
+IidManager::IndexHash(uint16_t uid, uint64_t nameHash)
+{
+    return nameHash ^ (uid * 0x9e3779b97f4a7c15ULL);
+}
+
 /**
  * @ingroup object
  * @internal
@@ -385,7 +518,7 @@ IidManager::AllocateUid(std::string name)
 {
     NS_LOG_FUNCTION(IID << name);
     // Type names are definitive: equal names are equal types
-    NS_ABORT_MSG_UNLESS(m_namemap.count(name) == 0,
+    NS_ABORT_MSG_UNLESS(GetUid(name) == 0,
                         "Trying to allocate twice the same uid: " << name);
 
     TypeId::hash_t hash = Hasher(name) & (~HashChainFlag);
@@ -448,8 +581,8 @@ IidManager::AllocateUid(std::string name)
     NS_ASSERT(tuid <= 0xffff);
     auto uid = static_cast<uint16_t>(tuid);
 
-    // Add to both maps:
-    m_namemap.insert({name, uid});
+    // Add to both indexes:
+    m_nameIndex.Insert(IndexHash(name), uid);
     m_hashmap.insert({hash, uid});
     NS_LOG_LOGIC(IIDL << uid);
     return uid;
@@ -472,10 +605,10 @@ IidManager::AddDeprecatedName(uint16_t uid, const std::string& name)
     IidInformation* info = LookupInformation(uid);
     NS_ASSERT_MSG(info->deprecatedName.empty(),
                   "Deprecated name already added: " << info->deprecatedName);
-    const auto [it, success] = m_namemap.insert({name, uid});
-    NS_ASSERT_MSG(success,
+    NS_ASSERT_MSG(GetUid(name) == 0,
                   "Deprecated name " << name << " insertion failed (possibly a duplicate?)");
     info->deprecatedName = name;
+    m_nameIndex.Insert(IndexHash(name), uid);
 }
 
 void
@@ -525,15 +658,13 @@ IidManager::AddConstructor(uint16_t uid, Callback<ObjectBase*> callback)
 }
 
 uint16_t
-IidManager::GetUid(std::string name) const
+IidManager::GetUid(const std::string& name) const
 {
     NS_LOG_FUNCTION(IID << name);
-    uint16_t uid = 0;
-    auto it = m_namemap.find(name);
-    if (it != m_namemap.end())
-    {
-        uid = it->second;
-    }
+    auto uid = static_cast<uint16_t>(m_nameIndex.Find(IndexHash(name), [&](uint32_t value) {
+        const IidInformation& information = m_information[value - 1];
+        return information.name == name || information.deprecatedName == name;
+    }));
     NS_LOG_LOGIC(IIDL << uid);
     return uid;
 }
@@ -650,29 +781,36 @@ bool
 IidManager::HasAttribute(uint16_t uid, std::string name)
 {
     NS_LOG_FUNCTION(IID << uid << name);
-    IidInformation* information = LookupInformation(uid);
+    bool found = FindAttribute(uid, name).first != 0;
+    NS_LOG_LOGIC(IIDL << found);
+    return found;
+}
+
+std::pair<uint16_t, std::size_t>
+IidManager::FindAttribute(uint16_t uid, const std::string& name) const
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+    uint64_t nameHash = IndexHash(name);
     while (true)
     {
-        for (auto i = information->attributes.begin(); i != information->attributes.end(); ++i)
+        IidInformation* information = LookupInformation(uid);
+        uint32_t i = m_attributeIndex.Find(IndexHash(uid, nameHash), [&](uint32_t value) {
+            return information->attributes[value - 1].name == name;
+        });
+        if (i != 0)
         {
-            if (i->name == name)
-            {
-                NS_LOG_LOGIC(IIDL << true);
-                return true;
-            }
+            NS_LOG_LOGIC(IIDL << uid << " " << i - 1);
+            return {uid, i - 1};
         }
-        IidInformation* parent = LookupInformation(information->parent);
-        if (parent == information)
+        if (information->parent == uid || information->parent == 0)
         {
-            // top of inheritance tree
-            NS_LOG_LOGIC(IIDL << false);
-            return false;
+            // top of inheritance tree, or a TypeId registered without SetParent()
+            NS_LOG_LOGIC(IIDL << 0);
+            return {0, 0};
         }
         // check parent
-        information = parent;
+        uid = information->parent;
     }
-    NS_LOG_LOGIC(IIDL << false);
-    return false;
 }
 
 void
@@ -711,6 +849,8 @@ IidManager::AddAttribute(uint16_t uid,
     info.supportLevel = supportLevel;
     info.supportMsg = supportMsg;
     information->attributes.push_back(info);
+    m_attributeIndex.Insert(IndexHash(uid, IndexHash(name)),
+                            static_cast<uint32_t>(information->attributes.size()));
     NS_LOG_LOGIC(IIDL << information->attributes.size() - 1);
 }
 
@@ -735,7 +875,7 @@ IidManager::GetAttributeN(uint16_t uid) const
     return size;
 }
 
-TypeId::AttributeInformation
+const TypeId::AttributeInformation&
 IidManager::GetAttribute(uint16_t uid, std::size_t i) const
 {
     NS_LOG_FUNCTION(IID << uid << i);
@@ -937,29 +1077,12 @@ TypeId::GetRegistered(uint16_t i)
 std::tuple<bool, TypeId, TypeId::AttributeInformation>
 TypeId::FindAttribute(const TypeId& tid, const std::string& name)
 {
-    TypeId currentTid = tid;
-    TypeId parentTid;
-    while (true)
+    auto [uid, i] = IidManager::Get()->FindAttribute(tid.m_tid, name);
+    if (uid == 0)
     {
-        for (std::size_t i = 0; i < currentTid.GetAttributeN(); ++i)
-        {
-            const AttributeInformation& attributeInfo = currentTid.GetAttribute(i);
-            if (attributeInfo.name == name)
-            {
-                return {true, currentTid, attributeInfo};
-            }
-        }
-
-        parentTid = currentTid.GetParent();
-
-        if (parentTid == currentTid)
-        {
-            break;
-        }
-
-        currentTid = parentTid;
+        return {false, TypeId(), AttributeInformation()};
     }
-    return {false, TypeId(), AttributeInformation()};
+    return {true, TypeId(uid), IidManager::Get()->GetAttribute(uid, i)};
 }
 
 bool
@@ -968,9 +1091,10 @@ TypeId::LookupAttributeByName(std::string name,
                               bool permissive) const
 {
     NS_LOG_FUNCTION(this << name << info);
-    auto [found, tid, attribute] = FindAttribute(*this, name);
-    if (found)
+    auto [uid, i] = IidManager::Get()->FindAttribute(m_tid, name);
+    if (uid != 0)
     {
+        const AttributeInformation& attribute = IidManager::Get()->GetAttribute(uid, i);
         if (attribute.supportLevel == SupportLevel::SUPPORTED)
         {
             *info = attribute;
@@ -851,6 +851,109 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * @ingroup config-tests
+ * Test for the connection of several paths at once.
+ */
+class ConnectManyConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ConnectManyConfigTestCase();
+
+    /** Destructor. */
+    ~ConnectManyConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback without context.
+     * @param oldValue The old value.
+     * @param newValue The new value.
+     */
+    void Trace(int16_t oldValue [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+    }
+
+    /**
+     * Trace callback with context path.
+     * @param path The context path.
+     * @param old The old value.
+     * @param newValue The new value.
+     */
+    void TraceWithPath(std::string path, int16_t old [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+        m_paths.push_back(path);
+    }
+
+  private:
+    void DoRun() override;
+
+    int16_t m_newValue;               //!< Flag to detect tracing result.
+    std::vector<std::string> m_paths; //!< The context paths.
+};
+
+ConnectManyConfigTestCase::ConnectManyConfigTestCase()
+    : TestCase("Check the connection of several paths sharing a prefix at once"),
+      m_newValue(0)
+{
+}
+
+void
+ConnectManyConfigTestCase::DoRun()
+{
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+
+    Ptr<ConfigTestObject> a0 = CreateObject<ConfigTestObject>();
+    Ptr<ConfigTestObject> a1 = CreateObject<ConfigTestObject>();
+    Ptr<ConfigTestObject> a2 = CreateObject<ConfigTestObject>();
+    root->AddNodeA(a0);
+    root->AddNodeA(a1);
+    root->AddNodeA(a2);
+    Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject>();
+    a1->SetNodeB(b);
+
+    //
+    // The two paths share the "/NodesA" prefix, and the second one is also
+    // connected to the objects matched by the first one.
+    //
+    auto cb = MakeCallback(&ConnectManyConfigTestCase::TraceWithPath, this);
+    Config::ConnectMany({{"/NodesA/*/Source", cb},
+                         {"/NodesA/1/NodeB/Source", cb},
+                         {"/NodesA/2/Source", cb}});
+
+    m_paths.clear();
+    a0->SetAttribute("Source", IntegerValue(1));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, 1, "Trace 0 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_paths.size(), 1, "Trace 0 fired more than once");
+    NS_TEST_ASSERT_MSG_EQ(m_paths[0], "/NodesA/0/Source", "Wrong context of trace 0");
+
+    m_paths.clear();
+    b->SetAttribute("Source", IntegerValue(2));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, 2, "Trace of NodeB did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_paths.size(), 1, "Trace of NodeB fired more than once");
+    NS_TEST_ASSERT_MSG_EQ(m_paths[0], "/NodesA/1/NodeB/Source", "Wrong context of NodeB");
+
+    m_paths.clear();
+    a2->SetAttribute("Source", IntegerValue(3));
+    NS_TEST_ASSERT_MSG_EQ(m_paths.size(), 2, "Trace 2 not fired once per connection");
+    NS_TEST_ASSERT_MSG_EQ(m_paths[0], "/NodesA/2/Source", "Wrong context of trace 2");
+    NS_TEST_ASSERT_MSG_EQ(m_paths[1], "/NodesA/2/Source", "Wrong context of trace 2");
+
+    Config::ConnectWithoutContextMany(
+        {{"/NodesA/1/Source", MakeCallback(&ConnectManyConfigTestCase::Trace, this)}});
+    m_paths.clear();
+    m_newValue = 0;
+    a1->SetAttribute("Source", IntegerValue(4));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, 4, "Trace 1 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_paths.size(), 1, "Trace 1 not fired with its context");
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * @ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -869,6 +972,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new ConnectManyConfigTestCase);
 }
 
 /**
@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup logging
+ * @ingroup logging-tests
+ * Binary log file test suite.
+ */
+
+/**
+ * @ingroup core-tests
+ * @defgroup logging-tests Logging tests
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LogBinaryTest");
+
+namespace tests
+{
+
+/**
+ * @ingroup logging-tests
+ * Check that a binary log file decodes to the text log.
+ */
+class LogBinaryTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    LogBinaryTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Log messages from a simulation event.
+     * @param [in] value A value to log.
+     */
+    void Log(int value);
+};
+
+LogBinaryTestCase::LogBinaryTestCase()
+    : TestCase("Check that a binary log file decodes to the text log")
+{
+}
+
+void
+LogBinaryTestCase::Log(int value)
+{
+    {
+        LogBinaryMessage message(g_log, "Log", LOG_INFO);
+        message.GetStream() << "value " << value;
+    }
+    {
+        LogBinaryMessage message(g_log, "Log", LOG_FUNCTION, true);
+        ParameterLogger(message.GetStream()) << value << "arg";
+    }
+    {
+        // a message logged while streaming another one
+        LogBinaryMessage outer(g_log, "Outer", LOG_WARN);
+        outer.GetStream() << "outer";
+        LogBinaryMessage(g_log, "Inner", LOG_DEBUG).GetStream() << "inner";
+    }
+    NS_LOG_INFO("macro " << value);
+}
+
+void
+LogBinaryTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("log-binary.bin");
+    LogComponentEnable("LogBinaryTest", LogLevel(LOG_LEVEL_ALL | LOG_PREFIX_ALL));
+    LogSetBinaryFile(filename);
+    NS_TEST_ASSERT_MSG_EQ(LogIsBinary(), true, "The binary log file is not open");
+    Simulator::Schedule(Seconds(1), &LogBinaryTestCase::Log, this, 42);
+    Simulator::ScheduleWithContext(3, Seconds(2), &LogBinaryTestCase::Log, this, 7);
+    Simulator::Run();
+    Simulator::Destroy();
+    LogSetBinaryFile("");
+    LogComponentDisable("LogBinaryTest", LogLevel(LOG_LEVEL_ALL | LOG_PREFIX_ALL));
+    NS_TEST_ASSERT_MSG_EQ(LogIsBinary(), false, "The binary log file is still open");
+
+    std::ostringstream expected;
+    for (auto [prefix, value] : {std::pair{"+1.000000000s -1 ", 42}, {"+2.000000000s 3 ", 7}})
+    {
+        expected << prefix << "LogBinaryTest:Log(): [INFO ] value " << value << "\n"
+                 << prefix << "LogBinaryTest:Log(" << value << ", \"arg\")\n"
+                 << prefix << "LogBinaryTest:Inner(): [DEBUG] inner\n"
+                 << prefix << "LogBinaryTest:Outer(): [WARN ] outer\n";
+#ifdef NS3_LOG_ENABLE
+        expected << prefix << "LogBinaryTest:Log(): [INFO ] macro " << value << "\n";
+#endif
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    std::ostringstream decoded;
+    NS_TEST_ASSERT_MSG_EQ(LogBinaryDecode(file, decoded), true, "Cannot decode the file");
+    NS_TEST_EXPECT_MSG_EQ(decoded.str(), expected.str(), "Wrong decoded log");
+
+    std::istringstream text("not a binary log file");
+    NS_TEST_EXPECT_MSG_EQ(LogBinaryDecode(text, decoded), false, "Decoded a text file");
+}
+
+/**
+ * @ingroup logging-tests
+ * Binary log file test suite.
+ */
+class LogBinaryTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    LogBinaryTestSuite();
+};
+
+LogBinaryTestSuite::LogBinaryTestSuite()
+    : TestSuite("log-binary")
+{
+    AddTestCase(new LogBinaryTestCase);
+}
+
+/**
+ * @ingroup logging-tests
+ * LogBinaryTestSuite instance variable.
+ */
+static LogBinaryTestSuite g_logBinaryTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
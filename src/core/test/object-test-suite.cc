@@ -453,6 +453,61 @@ AggregateObjectTestCase::DoRun()
     NS_TEST_ASSERT_MSG_NE(baseA, nullptr, "Unable to GetObject on released object");
 }
 
+/**
+ * @ingroup object-tests
+ * Test that the lookups of aggregates stay right when they are cached.
+ */
+class AggregateLookupCacheTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    AggregateLookupCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+AggregateLookupCacheTestCase::AggregateLookupCacheTestCase()
+    : TestCase("Check repeated GetObject lookups across aggregations")
+{
+}
+
+void
+AggregateLookupCacheTestCase::DoRun()
+{
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA>();
+    Ptr<BaseB> baseB = CreateObject<BaseB>();
+    derivedA->AggregateObject(baseB);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<BaseA>(),
+                              derivedA,
+                              "GetObject for a parent TypeId returns a different Ptr");
+        NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<BaseA>(BaseA::GetTypeId()),
+                              derivedA,
+                              "GetObject (tid) for a parent TypeId returns a different Ptr");
+        NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<DerivedB>(),
+                              nullptr,
+                              "Unexpectedly found a DerivedB");
+    }
+
+    //
+    // A lookup which failed must succeed once the Object is aggregated.
+    //
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+    baseB->AggregateObject(derivedB);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<DerivedB>(),
+                              derivedB,
+                              "Cannot GetObject for a newly aggregated DerivedB");
+        NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<DerivedA>(),
+                              derivedA,
+                              "Cannot GetObject (through derivedB) for DerivedA");
+    }
+}
+
 /**
  * @ingroup object-tests
  * Test we can aggregate Objects.
@@ -622,6 +677,7 @@ ObjectTestSuite::ObjectTestSuite()
 {
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
+    AddTestCase(new AggregateLookupCacheTestCase);
     AddTestCase(new UnidirectionalAggregateObjectTestCase);
     AddTestCase(new ObjectFactoryTestCase);
 }
@@ -13,6 +13,7 @@
 #include "ns3/double.h"
 #include "ns3/integer.h"
 #include "ns3/log.h"
+#include "ns3/object-factory.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/shuffle.h"
@@ -22,6 +23,8 @@
 
 #include <cmath>
 #include <ctime>
+#include <span>
+#include <vector>
 #include <gsl/gsl_cdf.h>
 #include <gsl/gsl_histogram.h>
 #include <gsl/gsl_randist.h>
@@ -2968,6 +2971,82 @@ ShuffleElementsTest::DoRun()
                           "Expected vector {4, 1, 9, 3, 2, 7}");
 }
 
+/**
+ * @ingroup rng-tests
+ * Test that GetValues() draws the same values as successive GetValue() calls.
+ */
+class GetValuesTestCase : public TestCase
+{
+  public:
+    // Constructor
+    GetValuesTestCase();
+
+  private:
+    // Inherited
+    void DoRun() override;
+
+    /**
+     * Compare the values of two random variables created by a factory,
+     * one drawn with GetValue() and one with GetValues().
+     *
+     * @param [in] factory The factory of the random variables.
+     */
+    void Compare(ObjectFactory factory);
+};
+
+GetValuesTestCase::GetValuesTestCase()
+    : TestCase("GetValues draws the same values as GetValue")
+{
+}
+
+void
+GetValuesTestCase::Compare(ObjectFactory factory)
+{
+    for (bool antithetic : {false, true})
+    {
+        factory.Set("Antithetic", BooleanValue(antithetic));
+        factory.Set("Stream", IntegerValue(7));
+        auto scalar = factory.Create<RandomVariableStream>();
+        auto batch = factory.Create<RandomVariableStream>();
+
+        std::vector<double> expected(1000);
+        for (auto& value : expected)
+        {
+            value = scalar->GetValue();
+        }
+        // batches of several sizes, including an empty one
+        std::vector<double> values(expected.size());
+        std::span<double> remaining(values);
+        for (std::size_t size : {1, 0, 2, 7, 100})
+        {
+            batch->GetValues(remaining.first(size));
+            remaining = remaining.subspan(size);
+        }
+        batch->GetValues(remaining);
+
+        NS_TEST_EXPECT_MSG_EQ((values == expected),
+                              true,
+                              "Different values for " << factory.GetTypeId().GetName()
+                                                      << " antithetic " << antithetic);
+        NS_TEST_EXPECT_MSG_EQ(batch->GetValue(),
+                              scalar->GetValue(),
+                              "Different next value for " << factory.GetTypeId().GetName());
+    }
+}
+
+void
+GetValuesTestCase::DoRun()
+{
+    Compare(ObjectFactory("ns3::UniformRandomVariable[Min=-3.5|Max=10]"));
+    Compare(ObjectFactory("ns3::ConstantRandomVariable[Constant=4.5]"));
+    Compare(ObjectFactory("ns3::ExponentialRandomVariable[Mean=2]"));
+    Compare(ObjectFactory("ns3::ExponentialRandomVariable[Mean=2|Bound=3]"));
+    Compare(ObjectFactory("ns3::ParetoRandomVariable[Scale=1|Shape=2|Bound=4]"));
+    Compare(ObjectFactory("ns3::WeibullRandomVariable[Scale=2|Shape=1.5|Bound=3]"));
+    Compare(ObjectFactory("ns3::NormalRandomVariable[Mean=1|Variance=4|Bound=3]"));
+    Compare(ObjectFactory("ns3::GammaRandomVariable[Alpha=2|Beta=3]"));
+}
+
 /**
  * @ingroup rng-tests
  * Test case for laplacian distribution random variable stream generator
@@ -3161,6 +3240,7 @@ RandomVariableSuite::RandomVariableSuite()
     AddTestCase(new BinomialTestCase);
     AddTestCase(new BinomialAntitheticTestCase);
     AddTestCase(new ShuffleElementsTest);
+    AddTestCase(new GetValuesTestCase);
     AddTestCase(new LaplacianTestCase);
     AddTestCase(new LargestExtremeValueTestCase);
 }
@@ -6,13 +6,29 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-profiler.h"
+#include "ns3/event-trace.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -647,6 +663,341 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that pooled events keep their bound state across reuse.
+ *
+ * Events of several size classes, including one too large to be pooled, are
+ * scheduled, cancelled and run repeatedly so that their memory is recycled.
+ * One event is also created on another thread and released on this one.
+ */
+class SimulatorEventPoolTestCase : public TestCase
+{
+  public:
+    SimulatorEventPoolTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Member event with several bound arguments.
+     * @param a First argument.
+     * @param b Second argument.
+     * @param c Third argument.
+     */
+    void Add(uint64_t a, uint64_t b, uint64_t c);
+
+    uint64_t m_sum; //!< Sum of the values seen by the events.
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase()
+    : TestCase("Check that pooled events keep their bound state across reuse")
+{
+}
+
+void
+SimulatorEventPoolTestCase::Add(uint64_t a, uint64_t b, uint64_t c)
+{
+    m_sum += a + b + c;
+}
+
+void
+SimulatorEventPoolTestCase::DoRun()
+{
+    auto add = &SimulatorEventPoolTestCase::Add;
+    m_sum = 0;
+    uint64_t expected = 0;
+    for (uint64_t round = 0; round < 4; round++)
+    {
+        for (uint64_t i = 0; i < 1000; i++)
+        {
+            std::array<uint64_t, 4> small{i, i, i, i};
+            std::array<uint64_t, 64> large{};
+            large.fill(round);
+            Simulator::Schedule(NanoSeconds(i), add, this, i, 1, 2);
+            Simulator::Schedule(NanoSeconds(i), [this, small]() {
+                m_sum += std::accumulate(small.begin(), small.end(), uint64_t{0});
+            });
+            Simulator::Schedule(NanoSeconds(i), [this, large]() {
+                m_sum += std::accumulate(large.begin(), large.end(), uint64_t{0});
+            });
+            EventId cancelled = Simulator::Schedule(NanoSeconds(i), add, this, 1, 1, 1);
+            Simulator::Cancel(cancelled);
+            expected += (i + 3) + 4 * i + 64 * round;
+        }
+        Simulator::Run();
+        NS_TEST_ASSERT_MSG_EQ(m_sum, expected, "Wrong sum after round " << round);
+    }
+
+    Ptr<EventImpl> remote;
+    std::thread t([&remote, this]() { remote = MakeEvent([this]() { m_sum++; }); });
+    t.join();
+    remote->Invoke();
+    remote = nullptr;
+    NS_TEST_EXPECT_MSG_EQ(m_sum, expected + 1, "Event created on another thread did not run");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check the event order of a Scheduler against a reference.
+ *
+ * Events are inserted with a mix of short and long delays, some with equal
+ * timestamps, and randomly removed or dequeued; every dequeued event must be
+ * the earliest one of a std::set holding the same events.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check event order of " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> uniform;
+    auto randInt = [&rng](uint64_t min, uint64_t max) {
+        return std::uniform_int_distribution<uint64_t>(min, max)(rng);
+    };
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+
+    auto cmp = [](const Scheduler::EventKey& a, const Scheduler::EventKey& b) { return a < b; };
+    std::set<Scheduler::EventKey, decltype(cmp)> reference(cmp);
+    std::vector<Scheduler::EventKey> pending;
+    uint64_t now = 0;
+    uint32_t uid = 0;
+
+    for (uint32_t step = 0; step < 20000; step++)
+    {
+        double op = uniform(rng);
+        if (op < 0.55 || reference.empty())
+        {
+            uint64_t delay;
+            double kind = uniform(rng);
+            if (kind < 0.2)
+            {
+                delay = 0;
+            }
+            else if (kind < 0.8)
+            {
+                delay = randInt(1, 100);
+            }
+            else
+            {
+                delay = randInt(1, 1000000);
+            }
+            Scheduler::EventKey key{now + delay, uid++, 0};
+            scheduler->Insert(Scheduler::Event{nullptr, key});
+            reference.insert(key);
+            pending.push_back(key);
+        }
+        else if (op < 0.65)
+        {
+            auto i = randInt(0, pending.size() - 1);
+            Scheduler::EventKey key = pending[i];
+            pending[i] = pending.back();
+            pending.pop_back();
+            if (reference.erase(key))
+            {
+                scheduler->Remove(Scheduler::Event{nullptr, key});
+            }
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(scheduler->PeekNext().key.m_uid,
+                                  reference.begin()->m_uid,
+                                  "Wrong next event at step " << step);
+            Scheduler::Event ev = scheduler->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid,
+                                  reference.begin()->m_uid,
+                                  "Wrong event removed at step " << step);
+            now = ev.key.m_ts;
+            reference.erase(reference.begin());
+        }
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), reference.empty(), "Wrong emptiness");
+    }
+
+    while (!reference.empty())
+    {
+        Scheduler::Event ev = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, reference.begin()->m_uid, "Wrong event drained");
+        reference.erase(reference.begin());
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler should be empty");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that DefaultSimulatorImpl records the event list operations.
+ */
+class SimulatorEventTraceTestCase : public TestCase
+{
+  public:
+    SimulatorEventTraceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Event which schedules a follow-up event. */
+    void Tick();
+};
+
+SimulatorEventTraceTestCase::SimulatorEventTraceTestCase()
+    : TestCase("Check that DefaultSimulatorImpl records the event list operations")
+{
+}
+
+void
+SimulatorEventTraceTestCase::Tick()
+{
+    Simulator::ScheduleWithContext(7, MicroSeconds(5), [] {});
+}
+
+void
+SimulatorEventTraceTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("simulator-event-trace.evtr");
+
+    Simulator::Destroy();
+    ObjectFactory factory("ns3::DefaultSimulatorImpl");
+    factory.Set("EventTraceFile", StringValue(filename));
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    Simulator::Schedule(MicroSeconds(10), &SimulatorEventTraceTestCase::Tick, this);
+    EventId removed = Simulator::Schedule(MicroSeconds(20), [] {});
+    EventId cancelled = Simulator::Schedule(MicroSeconds(30), [] {});
+    Simulator::Remove(removed);
+    Simulator::Cancel(cancelled);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    auto records = EventTraceReader::ReadAll(filename);
+    std::remove(filename.c_str());
+
+    NS_TEST_ASSERT_MSG_EQ(records.size(), 9, "Wrong number of records");
+    EventTraceOp ops[] = {EventTraceOp::INSERT,
+                          EventTraceOp::INSERT,
+                          EventTraceOp::INSERT,
+                          EventTraceOp::REMOVE,
+                          EventTraceOp::CANCEL,
+                          EventTraceOp::RUN,
+                          EventTraceOp::INSERT,
+                          EventTraceOp::RUN,
+                          EventTraceOp::RUN};
+    uint64_t ts[] = {10000, 20000, 30000, 20000, 30000, 10000, 15000, 15000, 30000};
+    for (std::size_t i = 0; i < records.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(static_cast<int>(records[i].op),
+                              static_cast<int>(ops[i]),
+                              "Wrong operation in record " << i);
+        NS_TEST_EXPECT_MSG_EQ(records[i].ts, ts[i], "Wrong timestamp in record " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(records[3].uid, records[1].uid, "Wrong event removed");
+    NS_TEST_EXPECT_MSG_EQ(records[4].uid, records[2].uid, "Wrong event cancelled");
+    NS_TEST_EXPECT_MSG_EQ(records[6].context, 7, "Wrong context");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that DefaultSimulatorImpl writes the time of each event handler.
+ */
+class SimulatorEventProfileTestCase : public TestCase
+{
+  public:
+    SimulatorEventProfileTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Event which schedules a follow-up event. */
+    void Tick();
+};
+
+SimulatorEventProfileTestCase::SimulatorEventProfileTestCase()
+    : TestCase("Check that DefaultSimulatorImpl writes the time of each event handler")
+{
+}
+
+void
+SimulatorEventProfileTestCase::Tick()
+{
+    Simulator::ScheduleWithContext(7, MicroSeconds(5), [] {});
+}
+
+void
+SimulatorEventProfileTestCase::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(
+        EventProfiler::GetHandlerName("ns3::MakeEvent<void (A::*)(int), A*, int>"
+                                      "(void (A::*)(int), A*, int)::EventMemberImpl"),
+        "void (A::*)(int)",
+        "Wrong method handler");
+    NS_TEST_EXPECT_MSG_EQ(EventProfiler::GetHandlerName("ns3::MakeEvent<A::B()::{lambda()#1}>"
+                                                        "(A::B()::{lambda()#1})::"
+                                                        "EventImplFunctional"),
+                          "A::B()::{lambda()#1}",
+                          "Wrong lambda handler");
+    NS_TEST_EXPECT_MSG_EQ(EventProfiler::GetHandlerName("A::Event"),
+                          "A::Event",
+                          "Wrong handler for an event not made by MakeEvent");
+
+    std::string filename = CreateTempDirFilename("simulator-event-profile.txt");
+
+    Simulator::Destroy();
+    ObjectFactory factory("ns3::DefaultSimulatorImpl");
+    factory.Set("ProfileFile", StringValue(filename));
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    Simulator::Schedule(MicroSeconds(10), &SimulatorEventProfileTestCase::Tick, this);
+    Simulator::Schedule(MicroSeconds(20), &SimulatorEventProfileTestCase::Tick, this);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // stacks: time
+    std::map<std::string, uint64_t> stacks;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        auto space = line.rfind(' ');
+        NS_TEST_ASSERT_MSG_NE(space, std::string::npos, "Malformed line " << line);
+        std::istringstream time(line.substr(space + 1));
+        uint64_t ns = 0;
+        time >> ns;
+        stacks[line.substr(0, space)] = ns;
+    }
+    file.close();
+    std::remove(filename.c_str());
+
+    NS_TEST_ASSERT_MSG_EQ(stacks.size(), 2, "Wrong number of stacks");
+    std::string tick = "void (SimulatorEventProfileTestCase::*)();no context";
+    std::string lambda = "SimulatorEventProfileTestCase::Tick()::{lambda()#1};node 7";
+    NS_TEST_EXPECT_MSG_EQ(stacks.count(tick), 1, "No stack for Tick");
+    NS_TEST_EXPECT_MSG_EQ(stacks.count(lambda), 1, "No stack for the lambda");
+    NS_TEST_EXPECT_MSG_GT(stacks[tick], 0, "No time for Tick");
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -670,6 +1021,22 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        for (const auto& schedulerType : {"ns3::ListScheduler",
+                                          "ns3::MapScheduler",
+                                          "ns3::HeapScheduler",
+                                          "ns3::CalendarScheduler",
+                                          "ns3::PriorityQueueScheduler",
+                                          "ns3::LadderScheduler"})
+        {
+            factory.SetTypeId(schedulerType);
+            AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        }
+        AddTestCase(new SimulatorEventPoolTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorEventTraceTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorEventProfileTestCase, TestCase::Duration::QUICK);
     }
 };
 
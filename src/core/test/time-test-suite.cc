@@ -13,8 +13,10 @@
 #include "ns3/test.h"
 
 #include <array>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -523,6 +525,93 @@ TimeInputOutputTestCase::DoRun()
     CheckAs(t * 1e+8, "+9.961925y");
 }
 
+/**
+ * @ingroup core-tests
+ * @brief Check that the integer fast paths of Time give the same results
+ * as the int64x64_t arithmetic.
+ */
+class TimeFastPathTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Constructor for TimeFastPathTestCase.
+     */
+    TimeFastPathTestCase();
+
+  private:
+    /**
+     * @brief DoRun for TimeFastPathTestCase.
+     */
+    void DoRun() override;
+};
+
+TimeFastPathTestCase::TimeFastPathTestCase()
+    : TestCase("Checks the integer fast paths of the Time conversions and scaling")
+{
+}
+
+void
+TimeFastPathTestCase::DoRun()
+{
+    const std::array<Time::Unit, 7> units{Time::D,
+                                          Time::MIN,
+                                          Time::S,
+                                          Time::MS,
+                                          Time::US,
+                                          Time::NS,
+                                          Time::PS};
+    const std::array<double, 9> values{1, -3, 2.5, 0.1, 1e6, -7e9, 123456789, 1e15, 1e300};
+    const std::array<Time, 6> times{NanoSeconds(1),
+                                    NanoSeconds(-9),
+                                    MicroSeconds(7),
+                                    Seconds(1.5),
+                                    Time(std::numeric_limits<int64_t>::max()),
+                                    Time(std::numeric_limits<int64_t>::min() + 1)};
+    const std::array<double, 7> scales{2, -3, 0.5, 1e3, 1.5, 4e9, 7};
+
+    for (auto unit : units)
+    {
+        for (auto value : values)
+        {
+            double steps = Time::FromInteger(1, unit).GetTimeStep();
+            if (std::fabs(value) > 1e18 || std::fabs(value) * steps > 1e18)
+            {
+                // beyond the range of Time
+                continue;
+            }
+            NS_TEST_EXPECT_MSG_EQ(Time::FromDouble(value, unit),
+                                  Time::From(int64x64_t(value), unit),
+                                  "FromDouble(" << value << ", " << unit << ")");
+        }
+        for (auto time : times)
+        {
+            if (unit == Time::PS && std::abs(time.GetTimeStep()) > 1000000000)
+            {
+                continue;
+            }
+            NS_TEST_EXPECT_MSG_EQ(time.ToDouble(unit),
+                                  time.To(unit).GetDouble(),
+                                  "ToDouble(" << unit << ") of " << time.GetTimeStep());
+        }
+    }
+    for (auto time : times)
+    {
+        for (auto scale : scales)
+        {
+            if (std::fabs(time.GetTimeStep() * scale) > 1e18)
+            {
+                continue;
+            }
+            NS_TEST_EXPECT_MSG_EQ(time * scale,
+                                  time * int64x64_t(scale),
+                                  time.GetTimeStep() << " * " << scale);
+            NS_TEST_EXPECT_MSG_EQ(time / scale,
+                                  time / int64x64_t(scale),
+                                  time.GetTimeStep() << " / " << scale);
+        }
+    }
+}
+
 /**
  * @ingroup core-tests
  * @brief   Time test Suite.  Runs the appropriate test cases for time
@@ -535,6 +624,7 @@ static class TimeTestSuite : public TestSuite
     {
         AddTestCase(new TimeWithSignTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new TimeInputOutputTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new TimeFastPathTestCase(), TestCase::Duration::QUICK);
         // This should be last, since it changes the resolution
         AddTestCase(new TimeSimpleTestCase(), TestCase::Duration::QUICK);
     }
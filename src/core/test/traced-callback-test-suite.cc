@@ -122,6 +122,104 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * @ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check that NS_TRACE and NS_TRACE_ALWAYS only
+ * evaluate their arguments when a Callback is connected, that NS_TRACE alone
+ * is compiled out when tracing is disabled, and that a Callback can be
+ * connected while the TracedCallback is firing.
+ */
+class NsTraceTestCase : public TestCase
+{
+  public:
+    NsTraceTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback connecting CbCount to the trace.
+     * @param a First parameter.
+     * @param b Second parameter.
+     */
+    void CbConnect(uint8_t a, double b);
+
+    /**
+     * Callback counting its calls.
+     * @param a First parameter.
+     * @param b Second parameter.
+     */
+    void CbCount(uint8_t a, double b);
+
+    TracedCallback<uint8_t, double> m_trace; //!< The traced callback
+    uint32_t m_count;                        //!< Number of calls of CbCount
+};
+
+NsTraceTestCase::NsTraceTestCase()
+    : TestCase("Check NS_TRACE, NS_TRACE_ALWAYS and the connections made while firing")
+{
+}
+
+void
+NsTraceTestCase::CbConnect(uint8_t /* a */, double /* b */)
+{
+    m_trace.ConnectWithoutContext(MakeCallback(&NsTraceTestCase::CbCount, this));
+}
+
+void
+NsTraceTestCase::CbCount(uint8_t /* a */, double /* b */)
+{
+    m_count++;
+}
+
+void
+NsTraceTestCase::DoRun()
+{
+    uint32_t evaluated = 0;
+    auto argument = [&evaluated]() {
+        evaluated++;
+        return 1;
+    };
+
+    NS_TEST_ASSERT_MSG_EQ(m_trace.IsEmpty(), true, "No callback expected");
+    NS_TRACE(m_trace, argument(), 2);
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 0, "Argument evaluated without any callback");
+
+    //
+    // The callback connected by CbConnect is appended to the chain while it
+    // is being invoked, and is called in the same invocation.
+    //
+    m_count = 0;
+    m_trace.ConnectWithoutContext(MakeCallback(&NsTraceTestCase::CbConnect, this));
+    m_trace(1, 2);
+    NS_TEST_ASSERT_MSG_EQ(m_count, 1, "Callback connected while firing not called");
+    m_trace.DisconnectWithoutContext(MakeCallback(&NsTraceTestCase::CbConnect, this));
+    m_trace(1, 2);
+    NS_TEST_ASSERT_MSG_EQ(m_count, 2, "Callback CbCount not called");
+
+    NS_TRACE(m_trace, argument(), 2);
+#ifndef NS3_TRACING_DISABLE
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 1, "Argument not evaluated");
+    NS_TEST_ASSERT_MSG_EQ(m_count, 3, "Callback CbCount not called by NS_TRACE");
+#else
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 0, "NS_TRACE not compiled out");
+    NS_TEST_ASSERT_MSG_EQ(m_count, 2, "Callback CbCount called by NS_TRACE");
+#endif
+
+    //
+    // NS_TRACE_ALWAYS is kept when tracing is disabled.
+    //
+    evaluated = 0;
+    m_count = 0;
+    NS_TRACE_ALWAYS(m_trace, argument(), 2);
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 1, "Argument not evaluated");
+    NS_TEST_ASSERT_MSG_EQ(m_count, 1, "Callback CbCount not called by NS_TRACE_ALWAYS");
+    m_trace.DisconnectWithoutContext(MakeCallback(&NsTraceTestCase::CbCount, this));
+    NS_TRACE_ALWAYS(m_trace, argument(), 2);
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 1, "Argument evaluated without any callback");
+}
+
 /**
  * @ingroup tracedcallback-tests
  *
@@ -137,6 +235,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new NsTraceTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
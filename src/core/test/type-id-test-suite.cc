@@ -336,6 +336,66 @@ DeprecatedAttributeTestCase::DoRun()
               << std::endl;
 }
 
+/**
+ * @ingroup typeid-tests
+ *
+ * Check the lookups by name of all the TypeIds and Attributes against
+ * a walk of the registered TypeIds.
+ */
+class LookupByNameTestCase : public TestCase
+{
+  public:
+    LookupByNameTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LookupByNameTestCase::LookupByNameTestCase()
+    : TestCase("Check the lookups of TypeIds and Attributes by name")
+{
+}
+
+void
+LookupByNameTestCase::DoRun()
+{
+    TypeId found;
+    NS_TEST_ASSERT_MSG_EQ(TypeId::LookupByNameFailSafe("ns3::NoSuchType", &found),
+                          false,
+                          "Found an unregistered TypeId");
+
+    for (uint16_t i = 0; i < TypeId::GetRegisteredN(); ++i)
+    {
+        TypeId tid = TypeId::GetRegistered(i);
+        NS_TEST_ASSERT_MSG_EQ(TypeId::LookupByName(tid.GetName()), tid, "Lookup of " << tid);
+
+        TypeId::AttributeInformation info;
+        NS_TEST_ASSERT_MSG_EQ(tid.LookupAttributeByName("NoSuchAttribute", &info, true),
+                              false,
+                              "Found an unregistered Attribute in " << tid);
+
+        // Every Attribute of the TypeId and its parents is found, in the
+        // TypeId declaring it (an Attribute name cannot be registered twice)
+        for (TypeId cur = tid;; cur = cur.GetParent())
+        {
+            for (std::size_t j = 0; j < cur.GetAttributeN(); ++j)
+            {
+                const std::string& name = cur.GetAttribute(j).name;
+                auto [ok, owner, attribute] = TypeId::FindAttribute(tid, name);
+                NS_TEST_ASSERT_MSG_EQ(ok, true, "Attribute " << name << " not found in " << tid);
+                NS_TEST_ASSERT_MSG_EQ(owner, cur, "Wrong owner of " << name << " in " << tid);
+                NS_TEST_ASSERT_MSG_EQ(attribute.checker,
+                                      cur.GetAttribute(j).checker,
+                                      "Wrong Attribute " << name << " in " << tid);
+            }
+            if (cur.GetParent() == cur || cur.GetParent().GetUid() == 0)
+            {
+                break;
+            }
+        }
+    }
+}
+
 /**
  * @ingroup typeid-tests
  *
@@ -352,7 +412,7 @@ class LookupTimeTestCase : public TestCase
     void DoSetup() override;
     /**
      * Report the performance test results.
-     * @param how How the TypeId is searched (name or hash).
+     * @param how How the TypeId is searched (name or hash), or "attribute".
      * @param delta The time required for the lookup.
      */
     void Report(const std::string how, const uint32_t delta) const;
@@ -401,6 +461,18 @@ LookupTimeTestCase::DoRun()
     }
     stop = clock();
     Report("hash", stop - start);
+
+    start = clock();
+    for (uint32_t j = 0; j < REPETITIONS; ++j)
+    {
+        for (uint16_t i = 0; i < nids; ++i)
+        {
+            const TypeId tid = TypeId::GetRegistered(i);
+            const auto found [[maybe_unused]] = TypeId::FindAttribute(tid, "NoSuchAttribute");
+        }
+    }
+    stop = clock();
+    Report("attribute", stop - start);
 }
 
 void
@@ -448,6 +520,7 @@ TypeIdTestSuite::TypeIdTestSuite()
     AddTestCase(new UniqueTypeIdTestCase, Duration::QUICK);
     AddTestCase(new CollisionTestCase, Duration::QUICK);
     AddTestCase(new DeprecatedAttributeTestCase, Duration::QUICK);
+    AddTestCase(new LookupByNameTestCase, Duration::QUICK);
 }
 
 /// Static variable for test initialization.
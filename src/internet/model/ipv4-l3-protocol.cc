@@ -571,14 +571,14 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
 
     if (ipv4Interface->IsUp())
     {
-        m_rxTrace(packet, this, interface);
+        NS_TRACE(m_rxTrace, packet, this, interface);
     }
     else
     {
         NS_LOG_LOGIC("Dropping received packet -- interface is down");
         Ipv4Header ipHeader;
         packet->RemoveHeader(ipHeader);
-        m_dropTrace(ipHeader, packet, DROP_INTERFACE_DOWN, this, interface);
+        NS_TRACE_ALWAYS(m_dropTrace, ipHeader, packet, DROP_INTERFACE_DOWN, this, interface);
         return;
     }
 
@@ -598,7 +598,7 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
     if (!ipHeader.IsChecksumOk())
     {
         NS_LOG_LOGIC("Dropping received packet -- checksum not ok");
-        m_dropTrace(ipHeader, packet, DROP_BAD_CHECKSUM, this, interface);
+        NS_TRACE_ALWAYS(m_dropTrace, ipHeader, packet, DROP_BAD_CHECKSUM, this, interface);
         return;
     }
 
@@ -634,7 +634,7 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
     if (m_enableDpd && ipHeader.GetDestination().IsMulticast() && UpdateDuplicate(packet, ipHeader))
     {
         NS_LOG_LOGIC("Dropping received packet -- duplicate.");
-        m_dropTrace(ipHeader, packet, DROP_DUPLICATE, this, interface);
+        NS_TRACE_ALWAYS(m_dropTrace, ipHeader, packet, DROP_DUPLICATE, this, interface);
         return;
     }
 
@@ -642,7 +642,7 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
     if (!m_routingProtocol->RouteInput(packet, ipHeader, device, m_ucb, m_mcb, m_lcb, m_ecb))
     {
         NS_LOG_WARN("No route found for forwarding packet.  Drop.");
-        m_dropTrace(ipHeader, packet, DROP_NO_ROUTE, this, interface);
+        NS_TRACE_ALWAYS(m_dropTrace, ipHeader, packet, DROP_NO_ROUTE, this, interface);
     }
 }
 
@@ -765,7 +765,7 @@ Ipv4L3Protocol::Send(Ptr<Packet> packet,
     {
         NS_LOG_LOGIC("Ipv4L3Protocol::Send case 1b:  passed in with route and valid gateway");
         int32_t interface = GetInterfaceForDevice(route->GetOutputDevice());
-        m_sendOutgoingTrace(ipHeader, packet, interface);
+        NS_TRACE_ALWAYS(m_sendOutgoingTrace, ipHeader, packet, interface);
         if (m_enableDpd && ipHeader.GetDestination().IsMulticast())
         {
             UpdateDuplicate(packet, ipHeader);
@@ -860,7 +860,7 @@ Ipv4L3Protocol::Send(Ptr<Packet> packet,
     else
     {
         NS_LOG_WARN("No route to host.  Drop.");
-        m_dropTrace(ipHeader, packet, DROP_NO_ROUTE, this, 0);
+        NS_TRACE_ALWAYS(m_dropTrace, ipHeader, packet, DROP_NO_ROUTE, this, 0);
         DecreaseIdentification(source, destination, protocol);
     }
 }
@@ -931,7 +931,7 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
     if (!route)
     {
         NS_LOG_WARN("No route to host.  Drop.");
-        m_dropTrace(ipHeader, packet, DROP_NO_ROUTE, this, 0);
+        NS_TRACE_ALWAYS(m_dropTrace, ipHeader, packet, DROP_NO_ROUTE, this, 0);
         return;
     }
     Ptr<NetDevice> outDev = route->GetOutputDevice();
@@ -997,7 +997,7 @@ Ipv4L3Protocol::IpMulticastForward(Ptr<Ipv4MulticastRoute> mrtentry,
         if (ipHeader.GetTtl() <= 1)
         {
             NS_LOG_WARN("TTL exceeded.  Drop.");
-            m_dropTrace(header, packet, DROP_TTL_EXPIRED, this, interface);
+            NS_TRACE_ALWAYS(m_dropTrace, header, packet, DROP_TTL_EXPIRED, this, interface);
             return;
         }
         ipHeader.SetTtl(header.GetTtl() - 1);
@@ -1008,7 +1008,7 @@ Ipv4L3Protocol::IpMulticastForward(Ptr<Ipv4MulticastRoute> mrtentry,
         rtentry->SetGateway(Ipv4Address::GetAny());
         rtentry->SetOutputDevice(GetNetDevice(interface));
 
-        m_multicastForwardTrace(ipHeader, packet, interface);
+        NS_TRACE(m_multicastForwardTrace, ipHeader, packet, interface);
         SendRealOut(rtentry, packet, ipHeader);
     }
 }
@@ -1032,7 +1032,7 @@ Ipv4L3Protocol::IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv
             icmp->SendTimeExceededTtl(ipHeader, packet, false);
         }
         NS_LOG_WARN("TTL exceeded.  Drop.");
-        m_dropTrace(header, packet, DROP_TTL_EXPIRED, this, interface);
+        NS_TRACE_ALWAYS(m_dropTrace, header, packet, DROP_TTL_EXPIRED, this, interface);
         return;
     }
     ipHeader.SetTtl(ipHeader.GetTtl() - 1);
@@ -1047,7 +1047,7 @@ Ipv4L3Protocol::IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv
         packet->AddPacketTag(priorityTag);
     }
 
-    m_unicastForwardTrace(ipHeader, packet, interface);
+    NS_TRACE_ALWAYS(m_unicastForwardTrace, ipHeader, packet, interface);
     SendRealOut(rtentry, packet, ipHeader);
 }
 
@@ -1072,7 +1072,7 @@ Ipv4L3Protocol::LocalDeliver(Ptr<const Packet> packet, const Ipv4Header& ip, uin
         ipHeader.SetPayloadSize(p->GetSize());
     }
 
-    m_localDeliverTrace(ipHeader, p, iif);
+    NS_TRACE_ALWAYS(m_localDeliverTrace, ipHeader, p, iif);
 
     Ptr<Ipv4Interface> ipv4Interface = GetInterface(iif);
 
@@ -1408,7 +1408,7 @@ Ipv4L3Protocol::RouteInputError(Ptr<const Packet> p,
     NS_LOG_FUNCTION(this << p << ipHeader << sockErrno);
     NS_LOG_LOGIC("Route input failure-- dropping packet to " << ipHeader << " with errno "
                                                              << sockErrno);
-    m_dropTrace(ipHeader, p, DROP_ROUTE_ERROR, this, 0);
+    NS_TRACE_ALWAYS(m_dropTrace, ipHeader, p, DROP_ROUTE_ERROR, this, 0);
 
     // \todo Send an ICMP no route.
 }
@@ -1706,7 +1706,7 @@ Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader,
         Ptr<Icmpv4L4Protocol> icmp = GetIcmp();
         icmp->SendTimeExceededTtl(ipHeader, packet, true);
     }
-    m_dropTrace(ipHeader, packet, DROP_FRAGMENT_TIMEOUT, this, iif);
+    NS_TRACE_ALWAYS(m_dropTrace, ipHeader, packet, DROP_FRAGMENT_TIMEOUT, this, iif);
 
     // clear the buffers
     it->second = nullptr;
@@ -0,0 +1,460 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "distributed-partition-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <numeric>
+
+/**
+ * @file
+ * @ingroup mpi
+ * Implementation of class ns3::DistributedPartitionHelper.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("DistributedPartitionHelper");
+
+namespace
+{
+
+/** Rank of a cluster not assigned yet. */
+constexpr uint32_t UNASSIGNED = std::numeric_limits<uint32_t>::max();
+/** Maximum number of refinement passes. */
+constexpr uint32_t REFINE_PASSES = 16;
+
+} // namespace
+
+DistributedPartitionHelper::DistributedPartitionHelper()
+    : m_imbalance(0.1),
+      m_ranks(0),
+      m_lookahead(Time::Max()),
+      m_cutLinks(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+DistributedPartitionHelper::IndexOf(Ptr<Node> node)
+{
+    auto [it, inserted] = m_index.emplace(node->GetId(), m_nodes.size());
+    if (inserted)
+    {
+        m_nodes.push_back(node);
+        m_weights.push_back(1);
+    }
+    return it->second;
+}
+
+void
+DistributedPartitionHelper::AddNodes(const NodeContainer& nodes)
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        IndexOf(*i);
+    }
+}
+
+void
+DistributedPartitionHelper::AddLink(Ptr<Node> a, Ptr<Node> b, Time delay)
+{
+    NS_LOG_FUNCTION(this << a << b << delay);
+    m_links.push_back({IndexOf(a), IndexOf(b), delay.GetTimeStep()});
+}
+
+void
+DistributedPartitionHelper::AddSharedChannel(const NodeContainer& nodes)
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<uint32_t> shared;
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        shared.push_back(IndexOf(*i));
+    }
+    m_shared.push_back(std::move(shared));
+}
+
+void
+DistributedPartitionHelper::AddWirelessNodes(const NodeContainer& nodes, double speed)
+{
+    NS_LOG_FUNCTION(this << speed);
+    NS_ABORT_MSG_IF(speed <= 0, "The propagation speed must be positive");
+    WirelessSet set;
+    set.speed = speed;
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        NS_ABORT_MSG_IF(!(*i)->GetObject<MobilityModel>(),
+                        "Wireless node " << (*i)->GetId() << " has no MobilityModel");
+        set.nodes.push_back(IndexOf(*i));
+    }
+    m_wireless.push_back(std::move(set));
+}
+
+void
+DistributedPartitionHelper::SetWeight(Ptr<Node> node, uint32_t weight)
+{
+    NS_LOG_FUNCTION(this << node << weight);
+    m_weights[IndexOf(node)] = weight;
+}
+
+void
+DistributedPartitionHelper::SetImbalance(double imbalance)
+{
+    NS_LOG_FUNCTION(this << imbalance);
+    NS_ABORT_MSG_IF(imbalance < 0, "The imbalance can not be negative");
+    m_imbalance = imbalance;
+}
+
+uint32_t
+DistributedPartitionHelper::Find(std::vector<uint32_t>& root, uint32_t i)
+{
+    while (root[i] != i)
+    {
+        root[i] = root[root[i]];
+        i = root[i];
+    }
+    return i;
+}
+
+std::vector<uint32_t>
+DistributedPartitionHelper::Cluster(const std::vector<Link>& links, int64_t delay) const
+{
+    std::vector<uint32_t> root(m_nodes.size());
+    std::iota(root.begin(), root.end(), 0);
+    for (const auto& shared : m_shared)
+    {
+        for (std::size_t i = 1; i < shared.size(); i++)
+        {
+            root[Find(root, shared[i])] = Find(root, shared[0]);
+        }
+    }
+    for (const auto& link : links)
+    {
+        if (link.delay < delay)
+        {
+            root[Find(root, link.b)] = Find(root, link.a);
+        }
+    }
+
+    std::vector<uint32_t> cluster(m_nodes.size(), UNASSIGNED);
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < m_nodes.size(); i++)
+    {
+        uint32_t r = Find(root, i);
+        if (cluster[r] == UNASSIGNED)
+        {
+            cluster[r] = n++;
+        }
+        cluster[i] = cluster[r];
+    }
+    return cluster;
+}
+
+uint64_t
+DistributedPartitionHelper::Pack(const std::vector<uint64_t>& weights,
+                                 std::vector<uint32_t>& part) const
+{
+    std::vector<uint32_t> order(weights.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&weights](uint32_t x, uint32_t y) {
+        return weights[x] > weights[y];
+    });
+    std::vector<uint64_t> load(m_ranks, 0);
+    part.assign(weights.size(), 0);
+    for (auto c : order)
+    {
+        auto lightest = std::min_element(load.begin(), load.end());
+        part[c] = static_cast<uint32_t>(lightest - load.begin());
+        *lightest += weights[c];
+    }
+    return *std::max_element(load.begin(), load.end());
+}
+
+void
+DistributedPartitionHelper::Partition(uint32_t ranks)
+{
+    NS_LOG_FUNCTION(this << ranks);
+    NS_ABORT_MSG_IF(ranks == 0, "Can not partition into 0 ranks");
+    m_ranks = ranks;
+
+    std::vector<Link> links = m_links;
+    for (const auto& set : m_wireless)
+    {
+        for (std::size_t i = 0; i < set.nodes.size(); i++)
+        {
+            auto a = m_nodes[set.nodes[i]]->GetObject<MobilityModel>();
+            for (std::size_t j = i + 1; j < set.nodes.size(); j++)
+            {
+                auto b = m_nodes[set.nodes[j]]->GetObject<MobilityModel>();
+                Time delay = Seconds(a->GetDistanceFrom(b) / set.speed);
+                links.push_back({set.nodes[i], set.nodes[j], delay.GetTimeStep()});
+            }
+        }
+    }
+
+    uint64_t total = std::accumulate(m_weights.begin(), m_weights.end(), uint64_t{0});
+    uint64_t heaviest =
+        m_weights.empty() ? 0 : *std::max_element(m_weights.begin(), m_weights.end());
+    auto cap = std::max(heaviest,
+                        static_cast<uint64_t>(std::ceil(total * (1 + m_imbalance) / ranks)));
+
+    auto clusterWeights = [this](const std::vector<uint32_t>& cluster) {
+        std::vector<uint64_t> weights;
+        for (uint32_t i = 0; i < cluster.size(); i++)
+        {
+            if (cluster[i] >= weights.size())
+            {
+                weights.resize(cluster[i] + 1, 0);
+            }
+            weights[cluster[i]] += m_weights[i];
+        }
+        return weights;
+    };
+
+    // Find the largest lookahead: the links shorter than the candidate are
+    // merged, and the clusters must still fit in the ranks.
+    std::vector<int64_t> candidates;
+    for (const auto& link : links)
+    {
+        candidates.push_back(link.delay);
+    }
+    candidates.push_back(std::numeric_limits<int64_t>::max());
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<uint32_t> part;
+    auto feasible = [&](int64_t delay) {
+        return Pack(clusterWeights(Cluster(links, delay)), part) <= cap;
+    };
+    std::size_t lo = 0;
+    std::size_t hi = candidates.size();
+    if (!feasible(candidates[0]))
+    {
+        NS_LOG_WARN("The shared channels do not fit in " << ranks << " ranks with imbalance "
+                                                         << m_imbalance);
+        hi = 1;
+    }
+    while (hi - lo > 1)
+    {
+        std::size_t mid = (lo + hi) / 2;
+        if (feasible(candidates[mid]))
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    std::vector<uint32_t> cluster = Cluster(links, candidates[lo]);
+    std::vector<uint64_t> weights = clusterWeights(cluster);
+    auto nClusters = static_cast<uint32_t>(weights.size());
+
+    // links between the clusters, with their multiplicity
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    for (const auto& link : links)
+    {
+        uint32_t a = cluster[link.a];
+        uint32_t b = cluster[link.b];
+        if (a != b)
+        {
+            edges.emplace_back(a, b);
+            edges.emplace_back(b, a);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> adjacent(nClusters);
+    for (std::size_t i = 0; i < edges.size();)
+    {
+        std::size_t j = i;
+        while (j < edges.size() && edges[j] == edges[i])
+        {
+            j++;
+        }
+        adjacent[edges[i].first].emplace_back(edges[i].second, j - i);
+        i = j;
+    }
+
+    // grow each rank from the first unassigned cluster, along the links
+    std::vector<uint32_t> rankOf(nClusters, UNASSIGNED);
+    std::vector<uint64_t> load(ranks, 0);
+    uint64_t remaining = total;
+    for (uint32_t r = 0; r < ranks; r++)
+    {
+        bool last = r == ranks - 1;
+        uint64_t target = remaining / (ranks - r);
+        std::deque<uint32_t> queue;
+        uint32_t seed = 0;
+        while (load[r] < target || last)
+        {
+            if (queue.empty())
+            {
+                while (seed < nClusters && (rankOf[seed] != UNASSIGNED ||
+                                            (!last && load[r] + weights[seed] > cap)))
+                {
+                    seed++;
+                }
+                if (seed == nClusters)
+                {
+                    break;
+                }
+                queue.push_back(seed);
+            }
+            uint32_t c = queue.front();
+            queue.pop_front();
+            if (rankOf[c] != UNASSIGNED || (!last && load[r] + weights[c] > cap))
+            {
+                continue;
+            }
+            rankOf[c] = r;
+            load[r] += weights[c];
+            for (const auto& [neighbour, count] : adjacent[c])
+            {
+                if (rankOf[neighbour] == UNASSIGNED)
+                {
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+        remaining -= load[r];
+    }
+    if (*std::max_element(load.begin(), load.end()) > cap)
+    {
+        NS_LOG_LOGIC("Growing the ranks exceeds the imbalance, packing the clusters");
+        Pack(weights, rankOf);
+        std::fill(load.begin(), load.end(), 0);
+        for (uint32_t c = 0; c < nClusters; c++)
+        {
+            load[rankOf[c]] += weights[c];
+        }
+    }
+
+    // move clusters to the rank they have the most links with
+    std::vector<int64_t> toRank(ranks, 0);
+    for (uint32_t pass = 0; pass < REFINE_PASSES; pass++)
+    {
+        bool moved = false;
+        for (uint32_t c = 0; c < nClusters; c++)
+        {
+            std::fill(toRank.begin(), toRank.end(), 0);
+            for (const auto& [neighbour, count] : adjacent[c])
+            {
+                toRank[rankOf[neighbour]] += count;
+            }
+            uint32_t from = rankOf[c];
+            uint32_t best = from;
+            for (uint32_t r = 0; r < ranks; r++)
+            {
+                if (r != from && load[r] + weights[c] <= cap &&
+                    toRank[r] > toRank[best])
+                {
+                    best = r;
+                }
+            }
+            if (best != from)
+            {
+                load[from] -= weights[c];
+                load[best] += weights[c];
+                rankOf[c] = best;
+                moved = true;
+            }
+        }
+        if (!moved)
+        {
+            break;
+        }
+    }
+
+    m_rankOf.resize(m_nodes.size());
+    for (uint32_t i = 0; i < m_nodes.size(); i++)
+    {
+        m_rankOf[i] = rankOf[cluster[i]];
+    }
+    m_rankWeight = load;
+    m_lookahead = Time::Max();
+    m_cutLinks = 0;
+    for (const auto& link : links)
+    {
+        if (m_rankOf[link.a] != m_rankOf[link.b])
+        {
+            m_cutLinks++;
+            m_lookahead = std::min(m_lookahead, TimeStep(link.delay));
+        }
+    }
+    NS_LOG_INFO(m_nodes.size() << " nodes in " << nClusters << " clusters, " << m_cutLinks
+                               << " links between ranks, lookahead " << m_lookahead);
+}
+
+void
+DistributedPartitionHelper::Assign() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_rankOf.size() != m_nodes.size(), "Partition() must be called first");
+    for (uint32_t i = 0; i < m_nodes.size(); i++)
+    {
+        m_nodes[i]->SetAttribute("SystemId", UintegerValue(m_rankOf[i]));
+    }
+}
+
+uint32_t
+DistributedPartitionHelper::GetSystemId(Ptr<Node> node) const
+{
+    auto it = m_index.find(node->GetId());
+    NS_ABORT_MSG_IF(it == m_index.end() || it->second >= m_rankOf.size(),
+                    "Node " << node->GetId() << " has not been partitioned");
+    return m_rankOf[it->second];
+}
+
+Time
+DistributedPartitionHelper::GetLookahead() const
+{
+    return m_lookahead;
+}
+
+uint32_t
+DistributedPartitionHelper::GetCutLinks() const
+{
+    return m_cutLinks;
+}
+
+uint64_t
+DistributedPartitionHelper::GetWeight(uint32_t rank) const
+{
+    NS_ABORT_MSG_IF(rank >= m_rankWeight.size(), "No rank " << rank);
+    return m_rankWeight[rank];
+}
+
+void
+DistributedPartitionHelper::Print(std::ostream& os) const
+{
+    os << m_nodes.size() << " nodes in " << m_ranks << " ranks, weights";
+    for (auto weight : m_rankWeight)
+    {
+        os << " " << weight;
+    }
+    os << ", " << m_cutLinks << " links between ranks, lookahead ";
+    if (m_lookahead == Time::Max())
+    {
+        os << "unbounded";
+    }
+    else
+    {
+        os << m_lookahead.As(Time::US);
+    }
+    os << std::endl;
+}
+
+} // namespace ns3
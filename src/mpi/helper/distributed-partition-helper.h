@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mpi
+ * Declaration of class ns3::DistributedPartitionHelper.
+ */
+
+#ifndef DISTRIBUTED_PARTITION_HELPER_H
+#define DISTRIBUTED_PARTITION_HELPER_H
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+#include <map>
+#include <ostream>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup mpi
+ *
+ * @brief Split the nodes of a distributed simulation into ranks.
+ *
+ * The helper is given the topology the simulation is about to build: the
+ * point-to-point links and their delays, the shared media (such as CSMA
+ * segments) whose nodes must stay on the same rank, and in mobility-aware
+ * mode the wireless nodes, whose pairwise delays are derived from the
+ * positions of their MobilityModel.  Partition() then computes a balanced
+ * k-way partition which maximizes the lookahead, the smallest delay of the
+ * links between two ranks, and, for that lookahead, minimizes the number
+ * of links between ranks.  Assign() sets the SystemId of the nodes, so it
+ * must be called before the devices and channels are installed, which
+ * look at the SystemId to create remote channels.
+ *
+ * @code
+ *   DistributedPartitionHelper partitioner;
+ *   partitioner.AddLink(a, b, MilliSeconds(5));
+ *   partitioner.AddSharedChannel(lan);
+ *   partitioner.Partition(MpiInterface::GetSize());
+ *   partitioner.Assign();
+ *   NS_LOG_INFO("lookahead " << partitioner.GetLookahead());
+ * @endcode
+ *
+ * The lookahead is found by contracting every link shorter than a
+ * candidate lookahead, and checking that the resulting clusters can still
+ * be packed into the ranks within the allowed imbalance; the largest such
+ * candidate is kept.  The clusters are then assigned to the ranks by
+ * growing each rank from a seed along the links, and refined by moving
+ * clusters between ranks while this removes links between ranks.
+ *
+ * The pairwise delays of the wireless nodes make the partitioning
+ * quadratic in their number.  They are computed from the positions when
+ * Partition() is called; with mobile nodes, the lookahead only holds while
+ * the nodes of different ranks stay as far apart.
+ */
+class DistributedPartitionHelper
+{
+  public:
+    /** Constructor. */
+    DistributedPartitionHelper();
+
+    /**
+     * Add nodes to partition, even if they have no link.
+     *
+     * @param [in] nodes The nodes.
+     */
+    void AddNodes(const NodeContainer& nodes);
+    /**
+     * Add a point-to-point link, which may connect two ranks.
+     *
+     * @param [in] a One end of the link.
+     * @param [in] b The other end of the link.
+     * @param [in] delay The propagation delay of the link.
+     */
+    void AddLink(Ptr<Node> a, Ptr<Node> b, Time delay);
+    /**
+     * Add a shared medium, such as a CSMA segment, whose nodes must all be
+     * on the same rank.
+     *
+     * @param [in] nodes The nodes attached to the medium.
+     */
+    void AddSharedChannel(const NodeContainer& nodes);
+    /**
+     * Add the nodes of a wireless channel.  Any two of them are linked,
+     * with the propagation delay between their positions.
+     *
+     * @param [in] nodes The nodes, which must have a MobilityModel.
+     * @param [in] speed The propagation speed, in m/s.
+     */
+    void AddWirelessNodes(const NodeContainer& nodes, double speed = 299792458.0);
+    /**
+     * Set the weight of a node, such as its expected number of events.
+     * The default weight is 1.
+     *
+     * @param [in] node The node.
+     * @param [in] weight The weight.
+     */
+    void SetWeight(Ptr<Node> node, uint32_t weight);
+    /**
+     * Set the allowed imbalance: no rank may weigh more than
+     * (1 + imbalance) times the average.  The default is 0.1.
+     *
+     * @param [in] imbalance The allowed imbalance.
+     */
+    void SetImbalance(double imbalance);
+
+    /**
+     * Compute the partition.
+     *
+     * @param [in] ranks The number of ranks.
+     */
+    void Partition(uint32_t ranks);
+    /**
+     * Set the SystemId attribute of the nodes to their rank.
+     */
+    void Assign() const;
+
+    /**
+     * @param [in] node A node.
+     * @returns The rank of the node.
+     */
+    uint32_t GetSystemId(Ptr<Node> node) const;
+    /**
+     * @returns The smallest delay of the links between two ranks, or
+     *          Time::Max() if no link connects two ranks.
+     */
+    Time GetLookahead() const;
+    /**
+     * @returns The number of links between two ranks.
+     */
+    uint32_t GetCutLinks() const;
+    /**
+     * @param [in] rank A rank.
+     * @returns The total weight of the nodes of the rank.
+     */
+    uint64_t GetWeight(uint32_t rank) const;
+    /**
+     * Print the partition: weight of each rank, links between ranks and lookahead.
+     *
+     * @param [in] os The output stream.
+     */
+    void Print(std::ostream& os) const;
+
+  private:
+    /** A link between two nodes. */
+    struct Link
+    {
+        uint32_t a;    //!< Index of one end.
+        uint32_t b;    //!< Index of the other end.
+        int64_t delay; //!< Delay, in time steps.
+    };
+
+    /** A set of wireless nodes. */
+    struct WirelessSet
+    {
+        std::vector<uint32_t> nodes; //!< Node indices.
+        double speed;                //!< Propagation speed, in m/s.
+    };
+
+    /**
+     * @param [in] node A node.
+     * @returns The index of the node, added if new.
+     */
+    uint32_t IndexOf(Ptr<Node> node);
+    /**
+     * @param [in] root The root of each node in a union-find forest, updated.
+     * @param [in] i A node index.
+     * @returns The root of i.
+     */
+    static uint32_t Find(std::vector<uint32_t>& root, uint32_t i);
+    /**
+     * Merge the nodes of the shared media, and of the links shorter than a delay.
+     *
+     * @param [in] links The links.
+     * @param [in] delay Links strictly shorter than this are merged.
+     * @returns The cluster of each node, numbered from 0.
+     */
+    std::vector<uint32_t> Cluster(const std::vector<Link>& links, int64_t delay) const;
+    /**
+     * Pack weighted clusters into the ranks, heaviest first, each in the
+     * lightest rank.
+     *
+     * @param [in] weights The cluster weights.
+     * @param [out] part The rank of each cluster.
+     * @returns The weight of the heaviest rank.
+     */
+    uint64_t Pack(const std::vector<uint64_t>& weights, std::vector<uint32_t>& part) const;
+
+    std::vector<Ptr<Node>> m_nodes;              //!< The nodes.
+    std::map<uint32_t, uint32_t> m_index;        //!< Index of each node, by node id.
+    std::vector<uint32_t> m_weights;             //!< Weight of each node.
+    std::vector<Link> m_links;                   //!< The point-to-point links.
+    std::vector<std::vector<uint32_t>> m_shared; //!< The shared media.
+    std::vector<WirelessSet> m_wireless;         //!< The wireless channels.
+    double m_imbalance;                          //!< The allowed imbalance.
+
+    uint32_t m_ranks;                   //!< The number of ranks.
+    std::vector<uint32_t> m_rankOf;     //!< Rank of each node.
+    Time m_lookahead;                   //!< Smallest delay between two ranks.
+    uint32_t m_cutLinks;                //!< Number of links between two ranks.
+    std::vector<uint64_t> m_rankWeight; //!< Weight of each rank.
+};
+
+} // namespace ns3
+
+#endif /* DISTRIBUTED_PARTITION_HELPER_H */
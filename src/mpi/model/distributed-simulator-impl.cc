@@ -171,14 +171,15 @@ DistributedSimulatorImpl::CalculateLookAhead()
             for (uint32_t i = 0; i < (*iter)->GetNDevices(); ++i)
             {
                 Ptr<NetDevice> localNetDevice = (*iter)->GetDevice(i);
-                // only works for p2p links currently
-                if (!localNetDevice->IsPointToPoint())
+                Ptr<Channel> channel = localNetDevice->GetChannel();
+                if (!channel)
                 {
                     continue;
                 }
-                Ptr<Channel> channel = localNetDevice->GetChannel();
-                if (!channel)
+                // other channels spanning several tasks give their own lookahead
+                if (!localNetDevice->IsPointToPoint())
                 {
+                    AddSharedChannel(channel);
                     continue;
                 }
 
@@ -273,6 +274,29 @@ DistributedSimulatorImpl::BoundLookAhead(const Time lookAhead)
     }
 }
 
+void
+DistributedSimulatorImpl::AddSharedChannel(Ptr<Channel> channel)
+{
+    NS_LOG_FUNCTION(this << channel);
+
+    bool remote = false;
+    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    {
+        Ptr<NetDevice> device = channel->GetDevice(i);
+        if (device && device->GetNode()->GetSystemId() != MpiInterface::GetSystemId())
+        {
+            remote = true;
+            break;
+        }
+    }
+    TimeValue lookAhead;
+    if (remote && channel->GetAttributeFailSafe("Lookahead", lookAhead) &&
+        lookAhead.Get() < m_lookAhead)
+    {
+        m_lookAhead = lookAhead.Get();
+    }
+}
+
 void
 DistributedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
 {
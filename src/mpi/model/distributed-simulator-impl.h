@@ -24,6 +24,8 @@
 namespace ns3
 {
 
+class Channel;
+
 /**
  * @ingroup mpi
  *
@@ -150,12 +152,20 @@ class DistributedSimulatorImpl : public SimulatorImpl
     /**
      * Calculate lookahead constraint based on network latency.
      *
-     * The smallest cross-rank PointToPoint channel delay imposes
+     * The smallest cross-rank PointToPoint channel delay, and the
+     * Lookahead attribute of the other cross-rank channels, impose
      * a constraint on the conservative PDES time window.  The
      * user may impose additional constraints on lookahead
      * using the ConstrainLookAhead() method.
      */
     void CalculateLookAhead();
+    /**
+     * Constrain the lookahead by a channel which is not point-to-point,
+     * if it has devices on other ranks and a Lookahead attribute.
+     *
+     * @param [in] channel The channel.
+     */
+    void AddSharedChannel(Ptr<Channel> channel);
     /**
      * Check if this rank is finished.  It's finished when there are
      * no more events or stop has been requested.
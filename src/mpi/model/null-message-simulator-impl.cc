@@ -139,14 +139,15 @@ NullMessageSimulatorImpl::CalculateLookAhead()
             for (uint32_t i = 0; i < (*iter)->GetNDevices(); ++i)
             {
                 Ptr<NetDevice> localNetDevice = (*iter)->GetDevice(i);
-                // only works for p2p links currently
-                if (!localNetDevice->IsPointToPoint())
+                Ptr<Channel> channel = localNetDevice->GetChannel();
+                if (!channel)
                 {
                     continue;
                 }
-                Ptr<Channel> channel = localNetDevice->GetChannel();
-                if (!channel)
+                // other channels spanning several tasks give their own lookahead
+                if (!localNetDevice->IsPointToPoint())
                 {
+                    AddSharedChannel(channel);
                     continue;
                 }
 
@@ -193,6 +194,40 @@ NullMessageSimulatorImpl::CalculateLookAhead()
     m_safeTime = Time(0);
 }
 
+void
+NullMessageSimulatorImpl::AddSharedChannel(Ptr<Channel> channel)
+{
+    NS_LOG_FUNCTION(this << channel);
+
+    TimeValue lookAhead;
+    bool hasLookAhead = false;
+    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    {
+        Ptr<NetDevice> device = channel->GetDevice(i);
+        if (!device || device->GetNode()->GetSystemId() == MpiInterface::GetSystemId())
+        {
+            continue;
+        }
+        if (!hasLookAhead)
+        {
+            if (!channel->GetAttributeFailSafe("Lookahead", lookAhead))
+            {
+                return;
+            }
+            hasLookAhead = true;
+        }
+
+        uint32_t remoteSystemId = device->GetNode()->GetSystemId();
+        Ptr<RemoteChannelBundle> remoteChannelBundle =
+            RemoteChannelBundleManager::Find(remoteSystemId);
+        if (!remoteChannelBundle)
+        {
+            remoteChannelBundle = RemoteChannelBundleManager::Add(remoteSystemId);
+        }
+        remoteChannelBundle->AddChannel(channel, lookAhead.Get());
+    }
+}
+
 void
 NullMessageSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
 {
@@ -27,6 +27,7 @@
 namespace ns3
 {
 
+class Channel;
 class NullMessageEvent;
 class NullMessageMpiInterface;
 class RemoteChannelBundle;
@@ -103,6 +104,15 @@ class NullMessageSimulatorImpl : public SimulatorImpl
      */
     void CalculateLookAhead();
 
+    /**
+     * Add a channel which is not point-to-point to the remote channel
+     * bundles of the other MPI tasks with devices on it, if it has a
+     * Lookahead attribute.
+     *
+     * @param channel The channel.
+     */
+    void AddSharedChannel(Ptr<Channel> channel);
+
     /**
      * Process the next event on the queue.
      */
@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/distributed-partition-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+
+/**
+ * @file
+ * @ingroup mpi-tests
+ * DistributedPartitionHelper test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup mpi-tests
+ *
+ * @brief Check that two clusters joined by a long link are split along that link.
+ */
+class DistributedPartitionClustersTestCase : public TestCase
+{
+  public:
+    DistributedPartitionClustersTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+DistributedPartitionClustersTestCase::DistributedPartitionClustersTestCase()
+    : TestCase("Check that the longest links are cut")
+{
+}
+
+void
+DistributedPartitionClustersTestCase::DoRun()
+{
+    // two rings of 4 nodes, joined by two links, one of which is longer
+    NodeContainer nodes(8);
+    DistributedPartitionHelper partitioner;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        partitioner.AddLink(nodes.Get(i), nodes.Get((i + 1) % 4), MilliSeconds(1));
+        partitioner.AddLink(nodes.Get(4 + i), nodes.Get(4 + (i + 1) % 4), MilliSeconds(1));
+    }
+    partitioner.AddLink(nodes.Get(1), nodes.Get(6), MilliSeconds(10));
+    partitioner.AddLink(nodes.Get(3), nodes.Get(4), MilliSeconds(20));
+
+    partitioner.Partition(2);
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetLookahead(), MilliSeconds(10), "Wrong lookahead");
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetCutLinks(), 2, "Wrong number of links between ranks");
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetWeight(0), 4, "Unbalanced ranks");
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetWeight(1), 4, "Unbalanced ranks");
+    for (uint32_t i = 1; i < 4; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(partitioner.GetSystemId(nodes.Get(i)),
+                              partitioner.GetSystemId(nodes.Get(0)),
+                              "Node " << i << " split from its ring");
+        NS_TEST_EXPECT_MSG_EQ(partitioner.GetSystemId(nodes.Get(4 + i)),
+                              partitioner.GetSystemId(nodes.Get(4)),
+                              "Node " << 4 + i << " split from its ring");
+    }
+
+    partitioner.Assign();
+    NS_TEST_EXPECT_MSG_NE(nodes.Get(0)->GetSystemId(),
+                          nodes.Get(4)->GetSystemId(),
+                          "System ids not assigned");
+
+    // with a single rank nothing is cut
+    partitioner.Partition(1);
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetCutLinks(), 0, "Links cut with a single rank");
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetLookahead(), Time::Max(), "Bounded lookahead");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mpi-tests
+ *
+ * @brief Check that a line is cut at its longest link, and that shared
+ * channels are kept on one rank.
+ */
+class DistributedPartitionLineTestCase : public TestCase
+{
+  public:
+    DistributedPartitionLineTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+DistributedPartitionLineTestCase::DistributedPartitionLineTestCase()
+    : TestCase("Check that shared channels are not split")
+{
+}
+
+void
+DistributedPartitionLineTestCase::DoRun()
+{
+    NodeContainer nodes(8);
+    DistributedPartitionHelper partitioner;
+    for (uint32_t i = 0; i + 1 < 8; i++)
+    {
+        partitioner.AddLink(nodes.Get(i), nodes.Get(i + 1), MilliSeconds(i == 3 ? 5 : 1));
+    }
+    partitioner.Partition(2);
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetLookahead(), MilliSeconds(5), "Wrong lookahead");
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetCutLinks(), 1, "Wrong number of links between ranks");
+
+    // a LAN across the longest link moves the cut
+    partitioner.AddSharedChannel(NodeContainer(nodes.Get(3), nodes.Get(4)));
+    partitioner.SetImbalance(0.25);
+    partitioner.Partition(2);
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetSystemId(nodes.Get(3)),
+                          partitioner.GetSystemId(nodes.Get(4)),
+                          "Shared channel split");
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetLookahead(), MilliSeconds(1), "Wrong lookahead");
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetCutLinks(), 1, "Wrong number of links between ranks");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(std::max(partitioner.GetWeight(0), partitioner.GetWeight(1)),
+                                5,
+                                "Unbalanced ranks");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mpi-tests
+ *
+ * @brief Check that wireless nodes are split by position.
+ */
+class DistributedPartitionWirelessTestCase : public TestCase
+{
+  public:
+    DistributedPartitionWirelessTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+DistributedPartitionWirelessTestCase::DistributedPartitionWirelessTestCase()
+    : TestCase("Check that wireless nodes are split by position")
+{
+}
+
+void
+DistributedPartitionWirelessTestCase::DoRun()
+{
+    // two groups of 3 nodes, 10 m apart within a group, 3 km between the groups
+    NodeContainer nodes(6);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector((i % 2) * 3000.0, (i / 2) * 10.0, 0));
+        nodes.Get(i)->AggregateObject(mobility);
+    }
+    DistributedPartitionHelper partitioner;
+    partitioner.AddWirelessNodes(nodes, 3e8);
+    partitioner.Partition(2);
+
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetLookahead(), MicroSeconds(10), "Wrong lookahead");
+    NS_TEST_EXPECT_MSG_EQ(partitioner.GetCutLinks(), 9, "Wrong number of links between ranks");
+    for (uint32_t i = 2; i < 6; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(partitioner.GetSystemId(nodes.Get(i)),
+                              partitioner.GetSystemId(nodes.Get(i % 2)),
+                              "Node " << i << " split from its group");
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mpi-tests
+ *
+ * @brief DistributedPartitionHelper Test Suite.
+ */
+class DistributedPartitionHelperTestSuite : public TestSuite
+{
+  public:
+    DistributedPartitionHelperTestSuite()
+        : TestSuite("distributed-partition-helper", Type::UNIT)
+    {
+        AddTestCase(new DistributedPartitionClustersTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new DistributedPartitionLineTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new DistributedPartitionWirelessTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+/** Static variable for test initialization. */
+static DistributedPartitionHelperTestSuite g_distributedPartitionHelperTestSuite;
@@ -0,0 +1,747 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/assert.h"
+#include "ns3/boolean.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+/**
+ * @file
+ * @ingroup mtp
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition* MultithreadedSimulatorImpl::g_current =
+    nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads, and partitions of the nodes. "
+                          "0 for one per hardware thread.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Lookahead",
+                          "A lower bound of the delay of any event scheduled from a node "
+                          "for a node of another partition. 0 to compute it from the channels "
+                          "when the simulation starts.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_userLookahead),
+                          MakeTimeChecker(Time(0)))
+            .AddAttribute("SplitWirelessChannels",
+                          "Allow the nodes of a channel other than a point-to-point, CSMA or "
+                          "simple channel to run on different threads. Such a channel reads the "
+                          "mobility and propagation loss models of the receivers from the thread "
+                          "of the sender, which is only safe if these models are not updated "
+                          "when read and draw no random numbers.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&MultithreadedSimulatorImpl::m_splitWireless),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::Partition::Partition()
+    : m_currentTs(0),
+      m_currentUid(EventId::UID::INVALID),
+      m_currentContext(Simulator::NO_CONTEXT),
+      m_uid(EventId::UID::VALID),
+      m_index(0),
+      m_nEvents(0)
+{
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_maxThreads(0),
+      m_splitWireless(false),
+      m_windowEnd(0),
+      m_parallel(false),
+      m_done(false),
+      m_windowRunning(false),
+      m_stop(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    auto clear = [](Partition& p) {
+        for (auto& slot : p.m_inbox)
+        {
+            for (auto& ev : slot)
+            {
+                ev.impl->Unref();
+            }
+            slot.clear();
+        }
+        while (p.m_events && !p.m_events->IsEmpty())
+        {
+            Scheduler::Event next = p.m_events->RemoveNext();
+            next.impl->Unref();
+        }
+        p.m_events = nullptr;
+    };
+    clear(m_global);
+    for (auto& p : m_partitions)
+    {
+        clear(p);
+    }
+    m_partitions.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ASSERT_MSG(!m_parallel, "Can not change the scheduler during a window");
+    m_schedulerFactory = schedulerFactory;
+    auto replace = [&schedulerFactory](Partition& p) {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (p.m_events)
+        {
+            while (!p.m_events->IsEmpty())
+            {
+                scheduler->Insert(p.m_events->RemoveNext());
+            }
+        }
+        p.m_events = scheduler;
+    };
+    replace(m_global);
+    for (auto& p : m_partitions)
+    {
+        replace(p);
+    }
+}
+
+MultithreadedSimulatorImpl::Partition&
+MultithreadedSimulatorImpl::CurrentPartition() const
+{
+    return g_current ? *g_current : const_cast<Partition&>(m_global);
+}
+
+MultithreadedSimulatorImpl::Partition&
+MultithreadedSimulatorImpl::PartitionOf(uint32_t context) const
+{
+    if (context < m_partitionOf.size())
+    {
+        return const_cast<Partition&>(m_partitions[m_partitionOf[context]]);
+    }
+    return const_cast<Partition&>(m_global);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert(Partition& partition, Scheduler::Event ev)
+{
+    ev.key.m_uid = partition.m_uid++;
+    partition.m_events->Insert(ev);
+    return ev.key.m_uid;
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t nNodes = NodeList::GetNNodes();
+    uint32_t nThreads = m_maxThreads ? m_maxThreads : std::thread::hardware_concurrency();
+    uint32_t n = std::clamp<uint32_t>(nThreads, 1, std::max<uint32_t>(nNodes, 1));
+
+    for (;;)
+    {
+        n = AssignPartitions(n);
+        m_lookahead = m_userLookahead.IsStrictlyPositive() ? m_userLookahead : CalculateLookahead();
+        if (n == 1 || m_lookahead.IsStrictlyPositive())
+        {
+            break;
+        }
+        NS_LOG_WARN("No lookahead between the partitions, running on a single thread; "
+                    "set the Lookahead attribute to run in parallel");
+        n = 1;
+    }
+    NS_LOG_INFO(n << " partitions of " << nNodes << " nodes, lookahead " << m_lookahead);
+
+    m_partitions = std::vector<Partition>(n);
+    m_global.m_inbox.resize(n);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Partition& p = m_partitions[i];
+        p.m_events = m_schedulerFactory.Create<Scheduler>();
+        p.m_index = i;
+        p.m_uid = m_global.m_uid;
+        p.m_currentTs = m_global.m_currentTs;
+        p.m_inbox.resize(n);
+    }
+
+    // move the events of the nodes scheduled so far, keeping their uids
+    Ptr<Scheduler> staged = m_global.m_events;
+    m_global.m_events = m_schedulerFactory.Create<Scheduler>();
+    while (!staged->IsEmpty())
+    {
+        Scheduler::Event ev = staged->RemoveNext();
+        PartitionOf(ev.key.m_context).m_events->Insert(ev);
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::AssignPartitions(uint32_t n)
+{
+    NS_LOG_FUNCTION(this << n);
+    uint32_t nNodes = NodeList::GetNNodes();
+
+    // the nodes which must run on the same thread, as trees rooted at their smallest id
+    std::vector<uint32_t> root(nNodes);
+    std::iota(root.begin(), root.end(), 0);
+    auto find = [&root](uint32_t i) {
+        while (root[i] != i)
+        {
+            root[i] = root[root[i]];
+            i = root[i];
+        }
+        return i;
+    };
+    for (auto it = ChannelList::Begin(); it != ChannelList::End() && !m_splitWireless; ++it)
+    {
+        Ptr<Channel> channel = *it;
+        TimeValue delay;
+        if (channel->GetNDevices() < 2 || channel->GetAttributeFailSafe("Delay", delay))
+        {
+            continue;
+        }
+        uint32_t first = find(channel->GetDevice(0)->GetNode()->GetId());
+        for (std::size_t i = 1; i < channel->GetNDevices(); i++)
+        {
+            uint32_t other = find(channel->GetDevice(i)->GetNode()->GetId());
+            root[std::max(first, other)] = std::min(first, other);
+            first = std::min(first, other);
+        }
+    }
+    std::vector<uint32_t> size(nNodes, 0);
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        size[find(i)]++;
+    }
+
+    // fill the partitions in the order of the node ids, as evenly as the groups allow;
+    // without groups, partition i gets the i-th block of contiguous node ids
+    m_partitionOf.assign(nNodes, 0);
+    uint32_t placed = 0;
+    uint32_t used = 0;
+    uint32_t lastSlot = 0;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        uint32_t r = find(i);
+        if (r == i)
+        {
+            auto slot = static_cast<uint32_t>(uint64_t{placed} * n / nNodes);
+            if (used == 0 || slot != lastSlot)
+            {
+                used++;
+                lastSlot = slot;
+            }
+            m_partitionOf[i] = used - 1;
+            placed += size[i];
+        }
+        else
+        {
+            m_partitionOf[i] = m_partitionOf[r];
+        }
+    }
+    return std::max<uint32_t>(used, 1);
+}
+
+Time
+MultithreadedSimulatorImpl::CalculateLookahead() const
+{
+    NS_LOG_FUNCTION(this);
+    Time lookahead = Time::Max();
+    for (auto it = ChannelList::Begin(); it != ChannelList::End(); ++it)
+    {
+        Ptr<Channel> channel = *it;
+        bool crossing = false;
+        for (std::size_t i = 1; i < channel->GetNDevices() && !crossing; i++)
+        {
+            crossing = m_partitionOf[channel->GetDevice(i)->GetNode()->GetId()] !=
+                       m_partitionOf[channel->GetDevice(0)->GetNode()->GetId()];
+        }
+        if (crossing)
+        {
+            lookahead = std::min(lookahead, GetMinimumDelay(channel));
+        }
+    }
+    return lookahead;
+}
+
+Time
+MultithreadedSimulatorImpl::GetMinimumDelay(Ptr<Channel> channel) const
+{
+    TimeValue delay;
+    if (channel->GetAttributeFailSafe("Delay", delay))
+    {
+        return delay.Get();
+    }
+
+    PointerValue model;
+    if (!channel->GetAttributeFailSafe("PropagationDelayModel", model))
+    {
+        NS_LOG_WARN("Can not bound the delay of channel " << channel->GetId());
+        return Time(0);
+    }
+    auto constantSpeed = model.Get<ConstantSpeedPropagationDelayModel>();
+    if (!constantSpeed)
+    {
+        NS_LOG_WARN("Can not bound the propagation delay of channel " << channel->GetId());
+        return Time(0);
+    }
+    double minDistance = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < channel->GetNDevices(); i++)
+    {
+        Ptr<Node> a = channel->GetDevice(i)->GetNode();
+        Ptr<MobilityModel> ma = a->GetObject<MobilityModel>();
+        for (std::size_t j = i + 1; j < channel->GetNDevices(); j++)
+        {
+            Ptr<Node> b = channel->GetDevice(j)->GetNode();
+            if (m_partitionOf[a->GetId()] == m_partitionOf[b->GetId()])
+            {
+                continue;
+            }
+            Ptr<MobilityModel> mb = b->GetObject<MobilityModel>();
+            if (!ma || !mb)
+            {
+                return Time(0);
+            }
+            minDistance = std::min(minDistance, ma->GetDistanceFrom(mb));
+        }
+    }
+    return std::isinf(minDistance) ? Time::Max() : Seconds(minDistance / constantSpeed->GetSpeed());
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveEvents(Partition& partition)
+{
+    for (auto& slot : partition.m_inbox)
+    {
+        for (auto& ev : slot)
+        {
+            Insert(partition, ev);
+        }
+        slot.clear();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(Partition& partition)
+{
+    Scheduler::Event next = partition.m_events->RemoveNext();
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= partition.m_currentTs);
+    partition.m_nEvents.fetch_add(1, std::memory_order_relaxed);
+
+    partition.m_currentTs = next.key.m_ts;
+    partition.m_currentContext = next.key.m_context;
+    partition.m_currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::RunPartition(uint32_t index)
+{
+    Partition& p = m_partitions[index];
+    g_current = &p;
+    for (;;)
+    {
+        ReceiveEvents(p);
+        // the completion step runs the global events and sets m_windowEnd
+        m_barrier->arrive_and_wait();
+        if (m_done)
+        {
+            break;
+        }
+        while (!p.m_events->IsEmpty() && p.m_events->PeekNext().key.m_ts < m_windowEnd)
+        {
+            ProcessOneEvent(p);
+        }
+        // wait for the other partitions to fill the inboxes
+        m_barrier->arrive_and_wait();
+    }
+    g_current = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::EndPhase()
+{
+    if (m_windowRunning)
+    {
+        m_windowRunning = false;
+        m_parallel = false;
+        return;
+    }
+    NextWindow();
+    m_windowRunning = !m_done;
+}
+
+void
+MultithreadedSimulatorImpl::NextWindow()
+{
+    Partition* previous = g_current;
+    g_current = &m_global;
+    for (;;)
+    {
+        ReceiveEvents(m_global);
+        uint64_t tp = std::numeric_limits<uint64_t>::max();
+        for (auto& p : m_partitions)
+        {
+            if (!p.m_events->IsEmpty())
+            {
+                tp = std::min(tp, p.m_events->PeekNext().key.m_ts);
+            }
+        }
+        bool globalEmpty = m_global.m_events->IsEmpty();
+        uint64_t tg = globalEmpty ? std::numeric_limits<uint64_t>::max()
+                                  : m_global.m_events->PeekNext().key.m_ts;
+        if (m_stop || (globalEmpty && tp == std::numeric_limits<uint64_t>::max()))
+        {
+            m_done = true;
+            break;
+        }
+        if (!globalEmpty && tg <= tp)
+        {
+            ProcessOneEvent(m_global);
+            continue;
+        }
+        auto lookahead = static_cast<uint64_t>(m_lookahead.GetTimeStep());
+        uint64_t end = tp > std::numeric_limits<uint64_t>::max() - lookahead
+                           ? std::numeric_limits<uint64_t>::max()
+                           : tp + lookahead;
+        m_windowEnd = std::min(tg, end);
+        m_parallel = m_partitions.size() > 1;
+        break;
+    }
+    g_current = previous;
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_partitions.empty())
+    {
+        CreatePartitions();
+    }
+    m_stop = false;
+    m_done = false;
+    m_windowRunning = false;
+
+    auto n = static_cast<std::ptrdiff_t>(m_partitions.size());
+    m_barrier = std::make_unique<std::barrier<WindowCompletion>>(n, WindowCompletion{this});
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < m_partitions.size(); i++)
+    {
+        threads.emplace_back(&MultithreadedSimulatorImpl::RunPartition, this, i);
+    }
+    RunPartition(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    m_barrier.reset();
+
+    // each partition keeps the time of its last event: after a Stop() it may have
+    // events left between its own time and that of the others
+    for (auto& p : m_partitions)
+    {
+        m_global.m_currentTs = std::max(m_global.m_currentTs, p.m_currentTs);
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    bool empty = m_global.m_events->IsEmpty();
+    for (auto& p : m_partitions)
+    {
+        empty = empty && p.m_events->IsEmpty();
+    }
+    return empty;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    Partition& p = CurrentPartition();
+    Time tAbsolute = delay + TimeStep(p.m_currentTs);
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = static_cast<uint64_t>(tAbsolute.GetTimeStep());
+    ev.key.m_context = p.m_currentContext;
+    uint32_t uid = Insert(p, ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    Partition& current = CurrentPartition();
+    Partition& target = PartitionOf(context);
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = static_cast<uint64_t>((delay + TimeStep(current.m_currentTs)).GetTimeStep());
+    ev.key.m_context = context;
+    if (&target == &current || !m_parallel)
+    {
+        Insert(target, ev);
+        return;
+    }
+    if (ev.key.m_ts < m_windowEnd && &target == &m_global)
+    {
+        NS_FATAL_ERROR("Event without a node context at "
+                       << TimeStep(ev.key.m_ts) << " scheduled from context "
+                       << current.m_currentContext << " within the window ending at "
+                       << TimeStep(m_windowEnd)
+                       << "; the events of no node run between the windows, schedule it "
+                          "with a node context or at least "
+                       << TimeStep(m_windowEnd - current.m_currentTs) << " ahead");
+    }
+    if (ev.key.m_ts < m_windowEnd)
+    {
+        NS_FATAL_ERROR("Event for context " << context << " at " << TimeStep(ev.key.m_ts)
+                                            << " scheduled within the window ending at "
+                                            << TimeStep(m_windowEnd) << "; the lookahead "
+                                            << m_lookahead << " is too large");
+    }
+    target.m_inbox[current.m_index].push_back(ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    std::unique_lock lock{m_destroyMutex};
+    EventId id(Ptr<EventImpl>(event, false),
+               CurrentPartition().m_currentTs,
+               0xffffffff,
+               EventId::UID::DESTROY);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(CurrentPartition().m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs() - CurrentPartition().m_currentTs);
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        std::unique_lock lock{m_destroyMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Partition& owner = PartitionOf(id.GetContext());
+    if (m_parallel && &owner != &CurrentPartition())
+    {
+        NS_ASSERT_MSG(&owner == &m_global,
+                      "Can not remove an event of another partition during a window");
+        // the global partition does not run during a window; leave the
+        // event in its list, it is skipped when due
+        id.PeekEventImpl()->Cancel();
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    owner.m_events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        std::unique_lock lock{m_destroyMutex};
+        return std::find(m_destroyEvents.begin(), m_destroyEvents.end(), id) ==
+               m_destroyEvents.end();
+    }
+    const Partition& owner = PartitionOf(id.GetContext());
+    NS_ASSERT_MSG(!m_parallel || &owner == &CurrentPartition() || &owner == &m_global,
+                  "Can not query an event of another partition during a window");
+    return id.PeekEventImpl() == nullptr || id.GetTs() < owner.m_currentTs ||
+           (id.GetTs() == owner.m_currentTs && id.GetUid() <= owner.m_currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return CurrentPartition().m_currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = m_global.m_nEvents.load(std::memory_order_relaxed);
+    for (auto& p : m_partitions)
+    {
+        count += p.m_nEvents.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount() const
+{
+    return static_cast<uint32_t>(m_partitions.size());
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return m_lookahead;
+}
+
+} // namespace ns3
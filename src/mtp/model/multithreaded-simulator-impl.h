@@ -0,0 +1,287 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <barrier>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mtp
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+namespace ns3
+{
+
+class Channel;
+
+/**
+ * @defgroup mtp Multithreaded Simulation
+ *
+ * Conservative parallel simulation on a shared memory machine.
+ */
+
+/**
+ * @ingroup mtp
+ *
+ * @brief Simulator implementation running the nodes on several threads.
+ *
+ * When Run() is first called, the nodes are split into as many partitions
+ * as there are threads (see the MaxThreads attribute), in contiguous blocks
+ * of node ids.  A wireless channel reads the mobility and propagation loss
+ * models of the receivers on the thread of the sender, so the nodes of a
+ * channel other than a point-to-point, CSMA or simple channel are kept in
+ * the same partition, unless the SplitWirelessChannels attribute is set.
+ * Each partition has its own event list and runs on its own thread; an
+ * event belongs to the partition of the node its context designates.
+ * Events whose context is not a node, such as those scheduled from the
+ * main program with Simulator::Schedule(), belong to a global partition,
+ * which runs while all the other partitions wait.
+ *
+ * The partitions are synchronized conservatively in time windows.  The
+ * lookahead is the smallest delay of the channels which connect nodes of
+ * different partitions: the Delay attribute of point-to-point, CSMA and
+ * simple channels, or, with SplitWirelessChannels, the propagation delay
+ * between the closest nodes of a wireless channel with a
+ * ConstantSpeedPropagationDelayModel.  If the earliest pending event is at
+ * time t, every partition runs its events earlier than t + lookahead in
+ * parallel; an event scheduled for another partition during the window is
+ * necessarily later than the window, and is appended to an inbox of the
+ * receiving partition.  Each inbox has one slot per sending partition,
+ * written by that partition only, so that no lock is needed; the receiving
+ * partition moves its inbox into its event list at the start of the next
+ * window, in the order of the senders, which keeps the simulation
+ * deterministic for a given number of threads.
+ *
+ * An event scheduled for another partition within the current window
+ * means that the lookahead is not a lower bound of the delays between the
+ * partitions, and aborts the simulation; so does an event without a node
+ * context scheduled from a node within the current window.  The
+ * propagation delays of a wireless channel are measured on the positions
+ * at the start of the simulation; when nodes move, set the Lookahead
+ * attribute to a delay the channel can not go below.
+ *
+ * Simulator::Stop() called from a node takes effect at the end of the
+ * current window.  Each partition keeps the time of its last event, so
+ * that a later Run() resumes every partition where it stopped.
+ *
+ * The models must not share mutable state between nodes, except through
+ * events.  ns-3 must be built with NS3_MTP, which makes the reference
+ * counts and the packet buffers safe to share between threads.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Get the number of partitions, which is set when Run() is first called.
+     *
+     * @returns The number of partitions, or 0 before Run().
+     */
+    uint32_t GetPartitionCount() const;
+    /**
+     * Get the lookahead, which is set when Run() is first called.
+     *
+     * @returns The lookahead, Time::Max() if no channel connects two partitions.
+     */
+    Time GetLookahead() const;
+
+  private:
+    void DoDispose() override;
+
+    /** The events of a set of nodes, and the state of their thread. */
+    struct alignas(64) Partition
+    {
+        /** Constructor. */
+        Partition();
+
+        Ptr<Scheduler> m_events;         //!< The event list.
+        uint64_t m_currentTs;            //!< Timestamp of the current event.
+        uint32_t m_currentUid;           //!< Uid of the current event.
+        uint32_t m_currentContext;       //!< Context of the current event.
+        uint32_t m_uid;                  //!< Next event uid.
+        uint32_t m_index;                //!< Index of the partition.
+        std::atomic<uint64_t> m_nEvents; //!< Number of events run.
+        /**
+         * Events scheduled by the other partitions during the current window,
+         * indexed by the sending partition.
+         */
+        std::vector<std::vector<Scheduler::Event>> m_inbox;
+    };
+
+    /** Barrier completion step. */
+    struct WindowCompletion
+    {
+        MultithreadedSimulatorImpl* m_impl; //!< The simulator.
+
+        /** End the current phase. */
+        void operator()() noexcept
+        {
+            m_impl->EndPhase();
+        }
+    };
+
+    /**
+     * @returns The partition of the calling thread.
+     */
+    Partition& CurrentPartition() const;
+    /**
+     * @param [in] context An event context.
+     * @returns The partition which runs the events of this context.
+     */
+    Partition& PartitionOf(uint32_t context) const;
+    /**
+     * Split the nodes into partitions, compute the lookahead and move the
+     * events scheduled so far to their partitions.
+     */
+    void CreatePartitions();
+    /**
+     * Set m_partitionOf, splitting the nodes in at most \pname{n}
+     * partitions.  The nodes of a channel which reads the state of the
+     * receivers when sending, i.e. any channel without a Delay attribute
+     * such as the wireless channels, are kept in the same partition,
+     * unless the SplitWirelessChannels attribute is set.
+     *
+     * @param [in] n The maximum number of partitions.
+     * @returns The number of partitions.
+     */
+    uint32_t AssignPartitions(uint32_t n);
+    /**
+     * @returns The smallest delay of the channels which connect two
+     *          partitions, Time(0) if it can not be bounded, or
+     *          Time::Max() if no channel connects two partitions.
+     */
+    Time CalculateLookahead() const;
+    /**
+     * @param [in] channel A channel connecting at least two partitions.
+     * @returns The smallest delay between two partitions through this
+     *          channel, or Time(0) if it can not be bounded.
+     */
+    Time GetMinimumDelay(Ptr<Channel> channel) const;
+    /**
+     * Insert an event in the event list of a partition.
+     *
+     * @param [in] partition The partition.
+     * @param [in] ev The event; its uid is set from the partition.
+     * @returns The event uid.
+     */
+    uint32_t Insert(Partition& partition, Scheduler::Event ev);
+    /**
+     * Move the inbox of a partition into its event list.
+     *
+     * @param [in] partition The partition.
+     */
+    void ReceiveEvents(Partition& partition);
+    /**
+     * Run the next event of a partition.
+     *
+     * @param [in] partition The partition.
+     */
+    void ProcessOneEvent(Partition& partition);
+    /**
+     * Thread body: run the windows of a partition until the simulation stops.
+     *
+     * @param [in] index The index of the partition.
+     */
+    void RunPartition(uint32_t index);
+    /**
+     * Called by the last thread to reach the barrier.  The threads meet
+     * twice per window: when the window is over, so that the inboxes are
+     * complete, and when the inboxes have been received, so that the next
+     * window can be set up by NextWindow().
+     */
+    void EndPhase();
+    /**
+     * Run the global events due before any partition event, then set the
+     * end of the next window, or m_done.  Called while all partitions wait.
+     */
+    void NextWindow();
+
+    /** The partition of the calling thread, or nullptr outside of Run(). */
+    static thread_local Partition* g_current;
+
+    /** Events of no node, and all events before Run() is first called. */
+    Partition m_global;
+    /** The partitions of nodes, empty before Run() is first called. */
+    std::vector<Partition> m_partitions;
+    /** Partition of each node, indexed by node id. */
+    std::vector<uint32_t> m_partitionOf;
+    /** Scheduler factory, for the event list of each partition. */
+    ObjectFactory m_schedulerFactory;
+    /** Maximum number of threads, 0 for one per hardware thread. */
+    uint32_t m_maxThreads;
+    /** Lookahead set by the user, or 0 to compute it. */
+    Time m_userLookahead;
+    /** Whether the nodes of a wireless channel may run on different threads. */
+    bool m_splitWireless;
+    /** The lookahead in use. */
+    Time m_lookahead;
+
+    /** Synchronizes the threads at the end of each window. */
+    std::unique_ptr<std::barrier<WindowCompletion>> m_barrier;
+    /** Partition events earlier than this timestamp run in the current window. */
+    uint64_t m_windowEnd;
+    /** True while the partitions run a window. */
+    bool m_parallel;
+    /** Set by NextWindow() when the simulation is over. */
+    bool m_done;
+    /** True from the set up of a window until all partitions ran it. */
+    bool m_windowRunning;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+
+    /** The event list of events to be run at the end of the simulation. */
+    std::list<EventId> m_destroyEvents;
+    /** Protects m_destroyEvents, which any thread may update. */
+    mutable std::mutex m_destroyMutex;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,379 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mtp-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+/**
+ * @ingroup mtp
+ * @defgroup mtp-tests Multithreaded simulation module tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Run a ring of nodes forwarding packets to their neighbour, with
+ * the default and the multithreaded SimulatorImpl, and compare the receptions.
+ */
+class MtpRingTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param [in] threads The number of threads of the multithreaded run.
+     */
+    MtpRingTestCase(uint32_t threads);
+
+  private:
+    void DoRun() override;
+
+    /** A reception: time, packet size, receiving device. */
+    using Rx = std::tuple<int64_t, uint32_t, uint32_t>;
+
+    /** Outcome of a run. */
+    struct Result
+    {
+        std::vector<std::vector<Rx>> rx; //!< The receptions, indexed by node.
+        uint64_t events;                 //!< The number of events run.
+        Time end;                        //!< The simulation time at the end.
+    };
+
+    /**
+     * Run the ring.
+     *
+     * @param [in] impl The simulator implementation.
+     * @returns The receptions and event count.
+     */
+    Result RunRing(Ptr<SimulatorImpl> impl);
+
+    /**
+     * Device receive callback: forward the packet, one byte larger, to the next node.
+     *
+     * @param [in] device The receiving device.
+     * @param [in] packet The packet.
+     * @param [in] protocol The protocol.
+     * @param [in] from The sender address.
+     * @returns true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /**
+     * Send a packet to the next node.
+     *
+     * @param [in] node The sending node.
+     * @param [in] size The packet size.
+     */
+    void Send(uint32_t node, uint32_t size);
+
+    static constexpr uint32_t N_NODES = 8;   //!< The number of nodes.
+    static constexpr uint32_t MAX_SIZE = 64; //!< Packets are not forwarded past this size.
+
+    uint32_t m_threads;                       //!< The number of threads.
+    std::vector<Ptr<SimpleNetDevice>> m_next; //!< Device to the next node, by node.
+    std::vector<std::vector<Rx>> m_rx;        //!< The receptions, indexed by node.
+};
+
+MtpRingTestCase::MtpRingTestCase(uint32_t threads)
+    : TestCase("Check that a ring of nodes runs the same on " + std::to_string(threads) +
+               " threads"),
+      m_threads(threads)
+{
+}
+
+void
+MtpRingTestCase::Send(uint32_t node, uint32_t size)
+{
+    m_next[node]->Send(Create<Packet>(size), Mac48Address::GetBroadcast(), 0x800);
+}
+
+bool
+MtpRingTestCase::Receive(Ptr<NetDevice> device,
+                         Ptr<const Packet> packet,
+                         uint16_t protocol,
+                         const Address& from)
+{
+    uint32_t node = device->GetNode()->GetId();
+    m_rx[node].emplace_back(Simulator::Now().GetTimeStep(),
+                            packet->GetSize(),
+                            device->GetIfIndex());
+    if (packet->GetSize() < MAX_SIZE)
+    {
+        Send(node, packet->GetSize() + 1);
+    }
+    return true;
+}
+
+MtpRingTestCase::Result
+MtpRingTestCase::RunRing(Ptr<SimulatorImpl> impl)
+{
+    Simulator::Destroy();
+    Simulator::SetImplementation(impl);
+
+    NodeContainer nodes(N_NODES);
+    m_next.clear();
+    m_rx.assign(N_NODES, {});
+    for (uint32_t i = 0; i < N_NODES; i++)
+    {
+        auto channel = CreateObject<SimpleChannel>();
+        channel->SetAttribute("Delay", TimeValue(MilliSeconds(1)));
+        auto tx = CreateObject<SimpleNetDevice>();
+        auto rx = CreateObject<SimpleNetDevice>();
+        tx->SetChannel(channel);
+        rx->SetChannel(channel);
+        tx->SetAddress(Mac48Address::Allocate());
+        rx->SetAddress(Mac48Address::Allocate());
+        nodes.Get(i)->AddDevice(tx);
+        nodes.Get((i + 1) % N_NODES)->AddDevice(rx);
+        rx->SetReceiveCallback(MakeCallback(&MtpRingTestCase::Receive, this));
+        tx->SetReceiveCallback(MakeCallback(&MtpRingTestCase::Receive, this));
+        m_next.push_back(tx);
+    }
+
+    for (uint32_t i = 0; i < N_NODES; i++)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(100 * i),
+                                       &MtpRingTestCase::Send,
+                                       this,
+                                       i,
+                                       1);
+    }
+    // a global event injecting more packets while the ring runs
+    Simulator::Schedule(MicroSeconds(5500), [this] {
+        Simulator::ScheduleWithContext(3, Time(0), &MtpRingTestCase::Send, this, 3, 10);
+    });
+    Simulator::Run();
+
+    Result result{m_rx, Simulator::GetEventCount(), Simulator::Now()};
+    for (auto& rx : result.rx)
+    {
+        std::sort(rx.begin(), rx.end());
+    }
+    m_next.clear();
+    Simulator::Destroy();
+    return result;
+}
+
+void
+MtpRingTestCase::DoRun()
+{
+    Result reference = RunRing(CreateObject<DefaultSimulatorImpl>());
+
+    ObjectFactory factory("ns3::MultithreadedSimulatorImpl");
+    factory.Set("MaxThreads", UintegerValue(m_threads));
+    auto impl = factory.Create<MultithreadedSimulatorImpl>();
+    Result result = RunRing(impl);
+
+    NS_TEST_ASSERT_MSG_EQ(impl->GetPartitionCount(), m_threads, "Wrong number of partitions");
+    if (m_threads > 1)
+    {
+        NS_TEST_EXPECT_MSG_EQ(impl->GetLookahead(), MilliSeconds(1), "Wrong lookahead");
+    }
+    NS_TEST_EXPECT_MSG_EQ(result.events, reference.events, "Different number of events");
+    NS_TEST_EXPECT_MSG_EQ(result.end, reference.end, "Different end time");
+    for (uint32_t i = 0; i < N_NODES; i++)
+    {
+        NS_TEST_EXPECT_MSG_GT(result.rx[i].size(), 0, "No reception at node " << i);
+        NS_TEST_EXPECT_MSG_EQ((result.rx[i] == reference.rx[i]),
+                              true,
+                              "Different receptions at node " << i);
+    }
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Check that Simulator::Stop() stops all the partitions at the same time.
+ */
+class MtpStopTestCase : public TestCase
+{
+  public:
+    MtpStopTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Count an event of a node, and schedule the next one.
+     *
+     * @param [in] node The node.
+     */
+    void Tick(uint32_t node);
+
+    uint64_t m_ticks[2]; //!< Number of events, indexed by node.
+};
+
+MtpStopTestCase::MtpStopTestCase()
+    : TestCase("Check that Simulator::Stop() stops the multithreaded simulation"),
+      m_ticks{0, 0}
+{
+}
+
+void
+MtpStopTestCase::Tick(uint32_t node)
+{
+    m_ticks[node]++;
+    Simulator::Schedule(MicroSeconds(10), &MtpStopTestCase::Tick, this, node);
+}
+
+void
+MtpStopTestCase::DoRun()
+{
+    Simulator::Destroy();
+    ObjectFactory factory("ns3::MultithreadedSimulatorImpl");
+    factory.Set("MaxThreads", UintegerValue(2));
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    NodeContainer nodes(2);
+    Simulator::ScheduleWithContext(0, Time(0), &MtpStopTestCase::Tick, this, 0);
+    Simulator::ScheduleWithContext(1, Time(0), &MtpStopTestCase::Tick, this, 1);
+    Simulator::Stop(MicroSeconds(1005));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MicroSeconds(1005), "Wrong stop time");
+    NS_TEST_EXPECT_MSG_EQ(m_ticks[0], 101, "Wrong number of events at node 0");
+    NS_TEST_EXPECT_MSG_EQ(m_ticks[1], 101, "Wrong number of events at node 1");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Check that Simulator::Stop() called from a node ends the window,
+ * and that a later Run() resumes each partition at its own time.
+ */
+class MtpStopResumeTestCase : public TestCase
+{
+  public:
+    MtpStopResumeTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Count an event of a node, stop the simulation at the 50th event of
+     * node 0, and schedule the next one.
+     *
+     * @param [in] node The node.
+     * @param [in] period The time to the next event.
+     */
+    void Tick(uint32_t node, Time period);
+
+    uint64_t m_ticks[2]; //!< Number of events, indexed by node.
+    Time m_last[2];      //!< Time of the last event, indexed by node.
+    bool m_backwards[2]; //!< Whether the time of a node went back.
+};
+
+MtpStopResumeTestCase::MtpStopResumeTestCase()
+    : TestCase("Check that the multithreaded simulation resumes after a Stop() from a node"),
+      m_ticks{0, 0},
+      m_backwards{false, false}
+{
+}
+
+void
+MtpStopResumeTestCase::Tick(uint32_t node, Time period)
+{
+    m_backwards[node] = m_backwards[node] || Simulator::Now() < m_last[node];
+    m_last[node] = Simulator::Now();
+    if (++m_ticks[node] == 50 && node == 0)
+    {
+        Simulator::Stop();
+    }
+    Simulator::Schedule(period, &MtpStopResumeTestCase::Tick, this, node, period);
+}
+
+void
+MtpStopResumeTestCase::DoRun()
+{
+    Simulator::Destroy();
+    ObjectFactory factory("ns3::MultithreadedSimulatorImpl");
+    factory.Set("MaxThreads", UintegerValue(2));
+    Simulator::SetImplementation(factory.Create<SimulatorImpl>());
+
+    // a channel between the nodes, for a lookahead of 1 ms
+    NodeContainer nodes(2);
+    auto channel = CreateObject<SimpleChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(1)));
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        auto device = CreateObject<SimpleNetDevice>();
+        device->SetChannel(channel);
+        device->SetAddress(Mac48Address::Allocate());
+        nodes.Get(i)->AddDevice(device);
+    }
+
+    // node 0 stops the simulation at 490 us, node 1 is far behind it
+    Simulator::ScheduleWithContext(0,
+                                   Time(0),
+                                   &MtpStopResumeTestCase::Tick,
+                                   this,
+                                   0,
+                                   MicroSeconds(10));
+    Simulator::ScheduleWithContext(1,
+                                   Time(0),
+                                   &MtpStopResumeTestCase::Tick,
+                                   this,
+                                   1,
+                                   MicroSeconds(300));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MicroSeconds(990), "Wrong end of the first window");
+    NS_TEST_EXPECT_MSG_EQ(m_ticks[0], 100, "Wrong number of events at node 0");
+    NS_TEST_EXPECT_MSG_EQ(m_ticks[1], 4, "Wrong number of events at node 1");
+
+    Simulator::Stop(MicroSeconds(1010));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MicroSeconds(2000), "Wrong stop time");
+    NS_TEST_EXPECT_MSG_EQ(m_ticks[0], 200, "Wrong number of events at node 0");
+    NS_TEST_EXPECT_MSG_EQ(m_ticks[1], 7, "Wrong number of events at node 1");
+    NS_TEST_EXPECT_MSG_EQ(m_backwards[0] || m_backwards[1], false, "Time went back");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief The multithreaded simulation Test Suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite()
+        : TestSuite("mtp", Type::UNIT)
+    {
+        AddTestCase(new MtpRingTestCase(1), TestCase::Duration::QUICK);
+        AddTestCase(new MtpRingTestCase(2), TestCase::Duration::QUICK);
+        AddTestCase(new MtpRingTestCase(4), TestCase::Duration::QUICK);
+        AddTestCase(new MtpStopTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new MtpStopResumeTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
@@ -7,6 +7,8 @@
  */
 #include "buffer.h"
 
+#include "packet-allocator.h"
+
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
@@ -43,139 +45,46 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
-#ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
- */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
-{
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
-    {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
-        {
-            Buffer::Deallocate(*i);
-        }
-        delete g_freeList;
-        g_freeList = DESTROYED;
-    }
-}
-
-void
-Buffer::Recycle(Buffer::Data* data)
-{
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
-    {
-        Buffer::Deallocate(data);
-    }
-    else
-    {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
-    }
-}
+#endif
 
-Buffer::Data*
-Buffer::Create(uint32_t dataSize)
-{
-    NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
-    {
-        g_freeList = new Buffer::FreeList();
-    }
-    else if (IS_INITIALIZED(g_freeList))
-    {
-        while (!g_freeList->empty())
-        {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
-        }
-    }
-    Buffer::Data* data = Buffer::Allocate(dataSize);
-    NS_ASSERT(data->m_count == 1);
-    return data;
-}
-#else  /* BUFFER_FREE_LIST */
-void
-Buffer::Recycle(Buffer::Data* data)
-{
-    NS_LOG_FUNCTION(data);
-    NS_ASSERT(data->m_count == 0);
-    Deallocate(data);
-}
+constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
 
 Buffer::Data*
 Buffer::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
-    return Allocate(size);
-}
-#endif /* BUFFER_FREE_LIST */
-
-constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
-
-Buffer::Data*
-Buffer::Allocate(uint32_t reqSize)
-{
-    NS_LOG_FUNCTION(reqSize);
-    if (reqSize == 0)
+    if (size == 0)
     {
-        reqSize = 1;
+        size = 1;
     }
-    NS_ASSERT(reqSize >= 1);
-    reqSize += ALLOC_OVER_PROVISION;
-    uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
-    auto b = new uint8_t[size];
-    auto data = reinterpret_cast<Buffer::Data*>(b);
-    data->m_size = reqSize;
+    NS_ASSERT(size >= 1);
+    size += ALLOC_OVER_PROVISION;
+    uint32_t blockSize = PacketAllocator::GetBlockSize(size - 1 + sizeof(Buffer::Data));
+    auto data = static_cast<Buffer::Data*>(PacketAllocator::Allocate(blockSize));
+    data->m_size = blockSize + 1 - sizeof(Buffer::Data);
     data->m_count = 1;
+    data->m_bytes = data->m_data;
+    data->m_release = nullptr;
     return data;
 }
 
 void
-Buffer::Deallocate(Buffer::Data* data)
+Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    auto buf = reinterpret_cast<uint8_t*>(data);
-    delete[] buf;
+    if (data->m_release)
+    {
+        (*data->m_release)(data->m_bytes);
+        delete data->m_release;
+        PacketAllocator::Deallocate(data, sizeof(Buffer::Data));
+        return;
+    }
+    PacketAllocator::Deallocate(data, data->m_size - 1 + sizeof(Buffer::Data));
 }
 
 Buffer::Buffer()
@@ -199,6 +108,26 @@ Buffer::Buffer(uint32_t dataSize, bool initialize)
     }
 }
 
+Buffer::Buffer(uint8_t* bytes, uint32_t size, const Callback<void, uint8_t*>& release)
+{
+    NS_LOG_FUNCTION(this << static_cast<void*>(bytes) << size);
+    auto data = static_cast<Buffer::Data*>(PacketAllocator::Allocate(sizeof(Buffer::Data)));
+    data->m_count = 1;
+    data->m_size = size;
+    data->m_bytes = bytes;
+    data->m_release = new Callback<void, uint8_t*>(release);
+    m_data = data;
+    /* the adopted bytes are all data: keep an empty zero area at the start */
+    m_start = 0;
+    m_maxZeroAreaStart = 0;
+    m_zeroAreaStart = 0;
+    m_zeroAreaEnd = 0;
+    m_end = size;
+    m_data->m_dirtyStart = m_start;
+    m_data->m_dirtyEnd = m_end;
+    NS_ASSERT(CheckInternalState());
+}
+
 bool
 Buffer::CheckInternalState() const
 {
@@ -255,8 +184,7 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -278,8 +206,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
@@ -304,7 +231,14 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // a copy held by another thread may grow the shared data concurrently
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
+    // never write the adopted bytes
+    isDirty = isDirty || m_data->m_release;
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -321,9 +255,8 @@ Buffer::AddAtStart(uint32_t start)
     {
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
-        memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        memcpy(newData->m_bytes + start, m_data->m_bytes + m_start, GetInternalSize());
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -350,7 +283,14 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    // a copy held by another thread may grow the shared data concurrently
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
+    // never write the adopted bytes
+    isDirty = isDirty || m_data->m_release;
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -367,9 +307,8 @@ Buffer::AddAtEnd(uint32_t end)
     {
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
-        memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        memcpy(newData->m_bytes, m_data->m_bytes + m_start, GetInternalSize());
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -391,6 +330,38 @@ Buffer::AddAtEnd(uint32_t end)
     NS_ASSERT(CheckInternalState());
 }
 
+void
+Buffer::Reserve(uint32_t start, uint32_t end)
+{
+    NS_LOG_FUNCTION(this << start << end);
+    NS_ASSERT(CheckInternalState());
+    if (m_data->m_count == 1 && !m_data->m_release && m_start >= start &&
+        GetInternalEnd() + end <= m_data->m_size)
+    {
+        return;
+    }
+    uint32_t newSize = start + GetInternalSize() + end;
+    Buffer::Data* newData = Buffer::Create(newSize);
+    memcpy(newData->m_bytes + start, m_data->m_bytes + m_start, GetInternalSize());
+    if (--m_data->m_count == 0)
+    {
+        Buffer::Recycle(m_data);
+    }
+    m_data = newData;
+
+    int32_t delta = start - m_start;
+    m_start += delta;
+    m_zeroAreaStart += delta;
+    m_zeroAreaEnd += delta;
+    m_end += delta;
+
+    // update dirty area
+    m_data->m_dirtyStart = m_start;
+    m_data->m_dirtyEnd = m_end;
+    LOG_INTERNAL_STATE("reserve start=" << start << ", end=" << end << ", ");
+    NS_ASSERT(CheckInternalState());
+}
+
 void
 Buffer::AddAtEnd(const Buffer& o)
 {
@@ -538,12 +509,12 @@ Buffer::CreateFullCopy() const
         tmp.Begin().WriteU8(0, m_zeroAreaEnd - m_zeroAreaStart);
         uint32_t dataStart = m_zeroAreaStart - m_start;
         tmp.AddAtStart(dataStart);
-        tmp.Begin().Write(m_data->m_data + m_start, dataStart);
+        tmp.Begin().Write(m_data->m_bytes + m_start, dataStart);
         uint32_t dataEnd = m_end - m_zeroAreaEnd;
         tmp.AddAtEnd(dataEnd);
         Buffer::Iterator i = tmp.End();
         i.Prev(dataEnd);
-        i.Write(m_data->m_data + m_zeroAreaStart, dataEnd);
+        i.Write(m_data->m_bytes + m_zeroAreaStart, dataEnd);
         NS_ASSERT(tmp.CheckInternalState());
         return tmp;
     }
@@ -603,7 +574,7 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    memcpy(p, m_data->m_data + m_start, dataStartLength);
+    memcpy(p, m_data->m_bytes + m_start, dataStartLength);
     p += (((dataStartLength + 3) & (~3)) / 4); // Advance p, insuring 4 byte boundary
 
     // Add the length of the actual end data
@@ -625,7 +596,7 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    memcpy(p, m_data->m_data + m_zeroAreaStart, dataEndLength);
+    memcpy(p, m_data->m_bytes + m_zeroAreaStart, dataEndLength);
     // The following line is unnecessary.
     // p += (((dataEndLength + 3) & (~3))/4); // Advance p, insuring 4 byte boundary
 
@@ -695,7 +666,7 @@ Buffer::PeekData() const
     NS_ASSERT(CheckInternalState());
     TransformIntoRealBuffer();
     NS_ASSERT(CheckInternalState());
-    return m_data->m_data + m_start;
+    return m_data->m_bytes + m_start;
 }
 
 void
@@ -705,7 +676,7 @@ Buffer::CopyData(std::ostream* os, uint32_t size) const
     if (size > 0)
     {
         uint32_t tmpsize = std::min(m_zeroAreaStart - m_start, size);
-        os->write((const char*)(m_data->m_data + m_start), tmpsize);
+        os->write((const char*)(m_data->m_bytes + m_start), tmpsize);
         if (size > tmpsize)
         {
             size -= m_zeroAreaStart - m_start;
@@ -721,7 +692,7 @@ Buffer::CopyData(std::ostream* os, uint32_t size) const
             {
                 size -= tmpsize;
                 tmpsize = std::min(m_end - m_zeroAreaEnd, size);
-                os->write((const char*)(m_data->m_data + m_zeroAreaStart), tmpsize);
+                os->write((const char*)(m_data->m_bytes + m_zeroAreaStart), tmpsize);
             }
         }
     }
@@ -735,7 +706,7 @@ Buffer::CopyData(uint8_t* buffer, uint32_t size) const
     if (size > 0)
     {
         uint32_t tmpsize = std::min(m_zeroAreaStart - m_start, size);
-        memcpy(buffer, (const char*)(m_data->m_data + m_start), tmpsize);
+        memcpy(buffer, (const char*)(m_data->m_bytes + m_start), tmpsize);
         buffer += tmpsize;
         size -= tmpsize;
         if (size > 0)
@@ -753,7 +724,7 @@ Buffer::CopyData(uint8_t* buffer, uint32_t size) const
             if (size > 0)
             {
                 tmpsize = std::min(m_end - m_zeroAreaEnd, size);
-                memcpy(buffer, (const char*)(m_data->m_data + m_zeroAreaStart), tmpsize);
+                memcpy(buffer, (const char*)(m_data->m_bytes + m_zeroAreaStart), tmpsize);
                 size -= tmpsize;
             }
         }
@@ -9,12 +9,15 @@
 #define BUFFER_H
 
 #include "ns3/assert.h"
+#include "ns3/callback.h"
 
 #include <ostream>
 #include <stdint.h>
 #include <vector>
 
-#define BUFFER_FREE_LIST 1
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 namespace ns3
 {
@@ -522,6 +525,18 @@ class Buffer
      * pointing to this Buffer.
      */
     void AddAtEnd(uint32_t end);
+    /**
+     * @param start size to reserve before the Buffer
+     * @param end size to reserve after the Buffer
+     *
+     * Make sure that the next calls to AddAtStart() for up to start
+     * bytes and to AddAtEnd() for up to end bytes do not copy the
+     * content of the Buffer. This copies the Buffer once if its
+     * storage is too small or is shared with another Buffer.
+     * Any call to this method invalidates any Iterator
+     * pointing to this Buffer.
+     */
+    void Reserve(uint32_t start, uint32_t end);
 
     /**
      * @param o the buffer to append to the end of this buffer.
@@ -643,6 +658,22 @@ class Buffer
      * @param initialize initialize the buffer with zeroes.
      */
     Buffer(uint32_t dataSize, bool initialize);
+    /**
+     * @brief Constructor
+     *
+     * The buffer adopts size bytes allocated by the caller instead of
+     * copying them: they must stay valid until release is invoked with
+     * the bytes pointer, when the last Buffer referencing them is
+     * destroyed. Like the copies of any Buffer, the copies of this
+     * Buffer share these bytes until one of them adds bytes at its
+     * start or end: it then gets a copy of its own, and the adopted
+     * bytes are never written.
+     *
+     * @param bytes the bytes to adopt
+     * @param size the number of bytes
+     * @param release the callback releasing the bytes
+     */
+    Buffer(uint8_t* bytes, uint32_t size, const Callback<void, uint8_t*>& release);
     ~Buffer();
 
   private:
@@ -666,21 +697,35 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
-         * the size of the m_data field below.
+         * the size of the m_bytes field below.
          */
         uint32_t m_size;
         /**
-         * offset from the start of the m_data field below to the
+         * offset from the start of the m_bytes field below to the
          * start of the area in which user bytes were written.
          */
         uint32_t m_dirtyStart;
         /**
-         * offset from the start of the m_data field below to the
+         * offset from the start of the m_bytes field below to the
          * end of the area in which user bytes were written.
          */
         uint32_t m_dirtyEnd;
+        /**
+         * The bytes of this buffer: m_data below, or the bytes adopted
+         * from the user.
+         */
+        uint8_t* m_bytes;
+        /**
+         * The callback releasing the adopted bytes, or nullptr if the
+         * bytes are m_data below.
+         */
+        Callback<void, uint8_t*>* m_release;
         /**
          * The real data buffer holds _at least_ one byte.
          * Its real size is stored in the m_size field.
@@ -740,17 +785,6 @@ class Buffer
      * @returns a pointer to the created buffer storage
      */
     static Buffer::Data* Create(uint32_t size);
-    /**
-     * @brief Allocate a buffer data storage
-     * @param reqSize the storage size to create
-     * @returns a pointer to the allocated buffer storage
-     */
-    static Buffer::Data* Allocate(uint32_t reqSize);
-    /**
-     * @brief Deallocate the buffer memory
-     * @param data the buffer data storage
-     */
-    static void Deallocate(Buffer::Data* data);
 
     Data* m_data; //!< the buffer data storage
 
@@ -770,43 +804,32 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
+#ifdef NS3_MTP
+    static thread_local uint32_t g_recommendedStart;
+#else
     static uint32_t g_recommendedStart;
+#endif
 
     /**
      * offset to the start of the virtual zero area from the start
-     * of m_data->m_data
+     * of m_data->m_bytes
      */
     uint32_t m_zeroAreaStart;
     /**
      * offset to the end of the virtual zero area from the start
-     * of m_data->m_data
+     * of m_data->m_bytes
      */
     uint32_t m_zeroAreaEnd;
     /**
      * offset to the start of the data referenced by this Buffer
-     * instance from the start of m_data->m_data
+     * instance from the start of m_data->m_bytes
      */
     uint32_t m_start;
     /**
      * offset to the end of the data referenced by this Buffer
-     * instance from the start of m_data->m_data
+     * instance from the start of m_data->m_bytes
      */
     uint32_t m_end;
-
-#ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
-
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
-
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
 };
 
 } // namespace ns3
@@ -847,7 +870,7 @@ Buffer::Iterator::Construct(const Buffer* buffer)
     m_zeroEnd = buffer->m_zeroAreaEnd;
     m_dataStart = buffer->m_start;
     m_dataEnd = buffer->m_end;
-    m_data = buffer->m_data->m_data;
+    m_data = buffer->m_data->m_bytes;
 }
 
 void
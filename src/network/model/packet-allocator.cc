@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-allocator.h"
+
+#include "ns3/log.h"
+
+#include <array>
+#include <bit>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketAllocator");
+
+namespace
+{
+
+constexpr uint32_t MIN_SHIFT = 5;                                //!< The smallest class, 32 bytes
+constexpr uint32_t MAX_SHIFT = 16;                               //!< The largest class, 64 KiB
+constexpr uint32_t MAX_SIZE = 1 << MAX_SHIFT;                    //!< The largest class size
+constexpr uint32_t N_CLASSES = 2 * (MAX_SHIFT - MIN_SHIFT) + 1; //!< The number of classes
+constexpr uint64_t MAX_FREE_BYTES = 4 << 20;                     //!< The size of a full free list
+
+/**
+ * @param size the size of a block, at most MAX_SIZE
+ * @returns the index of the smallest class holding the block
+ */
+uint32_t
+GetClass(uint32_t size)
+{
+    if (size <= (1 << MIN_SHIFT))
+    {
+        return 0;
+    }
+    // 2^(shift - 1) < size <= 2^shift, which is class 2 * (shift - MIN_SHIFT),
+    // and 1.5 * 2^(shift - 1) is the class before.
+    uint32_t shift = std::bit_width(size - 1);
+    uint32_t cls = 2 * (shift - MIN_SHIFT);
+    return size <= (3U << (shift - 2)) ? cls - 1 : cls;
+}
+
+/**
+ * @param cls the index of a class
+ * @returns the size of the blocks of the class
+ */
+uint32_t
+GetClassSize(uint32_t cls)
+{
+    return (cls % 2 == 0 ? 2U : 3U) << (MIN_SHIFT - 1 + cls / 2);
+}
+
+/// The free blocks of a class, linked through their first bytes.
+struct FreeList
+{
+    void* head = nullptr; //!< the first free block
+    uint64_t bytes = 0;   //!< the size of the free blocks
+};
+
+/// The free lists of all the classes.
+struct Cache
+{
+    std::array<FreeList, N_CLASSES> lists{}; //!< the free lists, by class
+    ~Cache();
+};
+
+#ifdef NS3_MTP
+/// A counter of the statistics.
+using Counter = std::atomic<uint64_t>;
+thread_local Cache g_cache;           //!< the free lists of this thread
+thread_local bool g_destroyed{false}; //!< whether g_cache is destroyed
+#else
+/// A counter of the statistics.
+using Counter = uint64_t;
+Cache g_cache;           //!< the free lists
+bool g_destroyed{false}; //!< whether g_cache is destroyed
+#endif
+
+Counter g_allocations{0};   //!< the number of blocks allocated
+Counter g_hits{0};          //!< the number of blocks reused from a free list
+Counter g_bytesResident{0}; //!< the bytes of the blocks in use or in a free list
+Counter g_bytesFree{0};     //!< the bytes of the blocks in a free list
+
+Cache::~Cache()
+{
+    for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+    {
+        while (lists[cls].head)
+        {
+            auto block = static_cast<uint8_t*>(lists[cls].head);
+            lists[cls].head = *reinterpret_cast<void**>(block);
+            g_bytesResident -= GetClassSize(cls);
+            g_bytesFree -= GetClassSize(cls);
+            delete[] block;
+        }
+    }
+    // the blocks freed by the destructors of the remaining packets
+    // are deleted directly.
+    g_destroyed = true;
+}
+
+} // namespace
+
+double
+PacketAllocator::Stats::GetHitRate() const
+{
+    return allocations == 0 ? 0 : static_cast<double>(hits) / allocations;
+}
+
+uint32_t
+PacketAllocator::GetBlockSize(uint32_t size)
+{
+    return size > MAX_SIZE ? size : GetClassSize(GetClass(size));
+}
+
+void*
+PacketAllocator::Allocate(uint32_t size)
+{
+    NS_LOG_FUNCTION(size);
+    g_allocations++;
+    if (size > MAX_SIZE)
+    {
+        g_bytesResident += size;
+        return new uint8_t[size];
+    }
+    uint32_t cls = GetClass(size);
+    uint32_t blockSize = GetClassSize(cls);
+    if (!g_destroyed && g_cache.lists[cls].head)
+    {
+        FreeList& list = g_cache.lists[cls];
+        void* block = list.head;
+        list.head = *static_cast<void**>(block);
+        list.bytes -= blockSize;
+        g_bytesFree -= blockSize;
+        g_hits++;
+        return block;
+    }
+    g_bytesResident += blockSize;
+    return new uint8_t[blockSize];
+}
+
+void
+PacketAllocator::Deallocate(void* block, uint32_t size)
+{
+    NS_LOG_FUNCTION(block << size);
+    if (size > MAX_SIZE)
+    {
+        g_bytesResident -= size;
+        delete[] static_cast<uint8_t*>(block);
+        return;
+    }
+    uint32_t cls = GetClass(size);
+    uint32_t blockSize = GetClassSize(cls);
+    if (!g_destroyed && g_cache.lists[cls].bytes + blockSize <= MAX_FREE_BYTES)
+    {
+        FreeList& list = g_cache.lists[cls];
+        *static_cast<void**>(block) = list.head;
+        list.head = block;
+        list.bytes += blockSize;
+        g_bytesFree += blockSize;
+        return;
+    }
+    g_bytesResident -= blockSize;
+    delete[] static_cast<uint8_t*>(block);
+}
+
+PacketAllocator::Stats
+PacketAllocator::GetStats()
+{
+    return {g_allocations, g_hits, g_bytesResident, g_bytesFree};
+}
+
+} // namespace ns3
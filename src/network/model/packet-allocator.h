@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PACKET_ALLOCATOR_H
+#define PACKET_ALLOCATOR_H
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ *
+ * @brief Allocate the storage of the packets.
+ *
+ * The buffers, metadata and byte tags of the packets are allocated and
+ * freed at a high rate. This allocator rounds the block sizes up to a
+ * few size classes, from 32 bytes to 64 KiB, two per power of two, and
+ * keeps the freed blocks of each class in a free list from which the
+ * next allocations of the class are served. Larger blocks are allocated
+ * directly.
+ *
+ * Multithreaded simulations keep a set of free lists per thread, so
+ * that allocating does not need any lock: a block can be freed by
+ * another thread than the one which allocated it.
+ */
+class PacketAllocator
+{
+  public:
+    /**
+     * The statistics of the allocator. The blocks are counted with the
+     * size of their class.
+     */
+    struct Stats
+    {
+        uint64_t allocations;   //!< the number of blocks allocated
+        uint64_t hits;          //!< the number of blocks reused from a free list
+        uint64_t bytesResident; //!< the bytes of the blocks in use or in a free list
+        uint64_t bytesFree;     //!< the bytes of the blocks in a free list
+
+        /**
+         * @returns the fraction of the allocations served from a free list
+         */
+        double GetHitRate() const;
+    };
+
+    /**
+     * @param size the size requested
+     * @returns the size of the blocks allocated for this size, which
+     * can all be used
+     */
+    static uint32_t GetBlockSize(uint32_t size);
+
+    /**
+     * @param size the size of the block
+     * @returns a block of GetBlockSize(size) bytes
+     */
+    static void* Allocate(uint32_t size);
+
+    /**
+     * @param block a block returned by Allocate()
+     * @param size the size given to Allocate(), or the size of the block
+     */
+    static void Deallocate(void* block, uint32_t size);
+
+    /**
+     * @returns the statistics of the allocator. Multithreaded
+     * simulations sum them over all the threads.
+     */
+    static Stats GetStats();
+};
+
+} // namespace ns3
+
+#endif /* PACKET_ALLOCATOR_H */
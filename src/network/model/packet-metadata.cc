@@ -9,12 +9,14 @@
 
 #include "buffer.h"
 #include "header.h"
+#include "packet-allocator.h"
 #include "trailer.h"
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <list>
 #include <utility>
 
@@ -23,22 +25,20 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
+/// The number of operations of the longest log, after which the items are built
+static constexpr uint32_t MAX_LOG_OPS = 128;
+
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+bool PacketMetadata::m_enableLazy = false;
 bool PacketMetadata::m_metadataSkipped = false;
+#ifdef NS3_MTP
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
+#else
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        PacketMetadata::Deallocate(*i);
-    }
-    PacketMetadata::m_enable = false;
-}
+#endif
 
 void
 PacketMetadata::Enable()
@@ -62,6 +62,21 @@ PacketMetadata::EnableChecking()
     m_enableChecking = true;
 }
 
+void
+PacketMetadata::EnableLazy()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Enable();
+    m_enableLazy = true;
+}
+
+void
+PacketMetadata::DisableLazy()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enableLazy = false;
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -69,8 +84,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -93,8 +107,7 @@ PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
-    if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+    if (m_data->m_size >= m_used + size && (m_head == 0xffff || !IsDirty()))
     {
         /* enough room, not dirty. */
     }
@@ -105,6 +118,102 @@ PacketMetadata::Reserve(uint32_t size)
     }
 }
 
+bool
+PacketMetadata::IsDirty() const
+{
+#ifdef NS3_MTP
+    // a copy held by another thread may append to the shared data concurrently
+    return m_data->m_count != 1;
+#else
+    return m_data->m_count != 1 && m_used != m_data->m_dirtyEnd;
+#endif
+}
+
+bool
+PacketMetadata::IsLog() const
+{
+    return m_data->m_isLog;
+}
+
+bool
+PacketMetadata::AppendOp(LogOpType type, uint32_t typeUid, uint32_t size, uint16_t chunkUid)
+{
+    NS_LOG_FUNCTION(this << +type << typeUid << size << chunkUid);
+    if (!IsLog())
+    {
+        return false;
+    }
+    if (m_used + sizeof(LogOp) > MAX_LOG_OPS * sizeof(LogOp))
+    {
+        // compact the long logs, such as those of the packets
+        // forwarded over many hops.
+        Materialize();
+        return false;
+    }
+    if (m_data->m_size < m_used + sizeof(LogOp) || IsDirty())
+    {
+        PacketMetadata::Data* newData = PacketMetadata::Create(m_used + sizeof(LogOp));
+        memcpy(newData->m_data, m_data->m_data, m_used);
+        newData->m_isLog = true;
+        if (--m_data->m_count == 0)
+        {
+            PacketMetadata::Recycle(m_data);
+        }
+        m_data = newData;
+    }
+    LogOp op;
+    op.typeUid = typeUid;
+    op.size = size;
+    op.chunkUid = chunkUid;
+    op.type = type;
+    memcpy(&m_data->m_data[m_used], &op, sizeof(op));
+    m_used += sizeof(op);
+    m_data->m_dirtyEnd = m_used;
+    return true;
+}
+
+void
+PacketMetadata::Materialize() const
+{
+    if (!IsLog())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    PacketMetadata items(m_packetUid, 0);
+    items.m_data->m_isLog = false;
+    for (uint32_t offset = 0; offset < m_used; offset += sizeof(LogOp))
+    {
+        LogOp op;
+        memcpy(&op, &m_data->m_data[offset], sizeof(op));
+        switch (op.type)
+        {
+        case ADD_HEADER:
+            items.AddHeaderItem(op.typeUid, op.size, op.chunkUid);
+            break;
+        case REMOVE_HEADER:
+            items.DoRemoveHeader(op.typeUid, op.size);
+            break;
+        case ADD_TRAILER:
+            items.AddTrailerItem(op.typeUid, op.size, op.chunkUid);
+            break;
+        case REMOVE_TRAILER:
+            items.DoRemoveTrailer(op.typeUid, op.size);
+            break;
+        case REMOVE_AT_START:
+            items.RemoveAtStart(op.size);
+            break;
+        case REMOVE_AT_END:
+            items.RemoveAtEnd(op.size);
+            break;
+        default:
+            NS_ASSERT(false);
+        }
+    }
+    // the value of the metadata is unchanged: only its representation is.
+    *const_cast<PacketMetadata*>(this) = items;
+}
+
 bool
 PacketMetadata::IsSharedPointerOk(uint16_t pointer) const
 {
@@ -371,8 +480,7 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || (m_head != 0xffff && IsDirty()))
     {
         ReserveCopy(n);
     }
@@ -408,8 +516,7 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
-    if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+    if (m_used + n > m_data->m_size || (m_head != 0xffff && IsDirty()))
     {
         ReserveCopy(n);
     }
@@ -491,6 +598,7 @@ PacketMetadata::ReplaceTail(PacketMetadata::SmallItem* item,
 
     // create a copy of the packet without its tail.
     PacketMetadata h(m_packetUid, 0);
+    h.m_data->m_isLog = false;
     uint16_t current = m_head;
     while (current != 0xffff && current != m_tail)
     {
@@ -559,68 +667,24 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
-    while (!m_freeList.empty())
-    {
-        PacketMetadata::Data* data = m_freeList.back();
-        m_freeList.pop_back();
-        if (data->m_size >= size)
-        {
-            NS_LOG_LOGIC("create found size=" << data->m_size);
-            data->m_count = 1;
-            return data;
-        }
-        NS_LOG_LOGIC("create dealloc size=" << data->m_size);
-        PacketMetadata::Deallocate(data);
-    }
-    NS_LOG_LOGIC("create alloc size=" << m_maxSize);
-    return PacketMetadata::Allocate(m_maxSize);
-}
-
-void
-PacketMetadata::Recycle(PacketMetadata::Data* data)
-{
-    NS_LOG_FUNCTION(data);
-    if (!m_enable)
-    {
-        PacketMetadata::Deallocate(data);
-        return;
-    }
-    NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
-    NS_ASSERT(data->m_count == 0);
-    if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
-    {
-        PacketMetadata::Deallocate(data);
-    }
-    else
-    {
-        m_freeList.push_back(data);
-    }
-}
-
-PacketMetadata::Data*
-PacketMetadata::Allocate(uint32_t n)
-{
-    NS_LOG_FUNCTION(n);
-    uint32_t size = sizeof(Data);
-    if (n <= PACKET_METADATA_DATA_M_DATA_SIZE)
-    {
-        n = PACKET_METADATA_DATA_M_DATA_SIZE;
-    }
-    size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
-    data->m_size = n;
+    uint32_t n = std::max<uint32_t>(m_maxSize, PACKET_METADATA_DATA_M_DATA_SIZE);
+    uint32_t blockSize =
+        PacketAllocator::GetBlockSize(sizeof(Data) + n - PACKET_METADATA_DATA_M_DATA_SIZE);
+    auto data = static_cast<PacketMetadata::Data*>(PacketAllocator::Allocate(blockSize));
+    data->m_size = blockSize - sizeof(Data) + PACKET_METADATA_DATA_M_DATA_SIZE;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
+    data->m_isLog = false;
     return data;
 }
 
 void
-PacketMetadata::Deallocate(PacketMetadata::Data* data)
+PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    NS_ASSERT(data->m_count == 0);
+    PacketAllocator::Deallocate(data,
+                                sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 PacketMetadata
@@ -651,14 +715,24 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    uint16_t chunkUid = m_chunkUid;
+    m_chunkUid++;
+    if (!AppendOp(ADD_HEADER, uid, size, chunkUid))
+    {
+        AddHeaderItem(uid, size, chunkUid);
+    }
+}
 
+void
+PacketMetadata::AddHeaderItem(uint32_t uid, uint32_t size, uint16_t chunkUid)
+{
+    NS_LOG_FUNCTION(this << uid << size << chunkUid);
     PacketMetadata::SmallItem item;
     item.next = m_head;
     item.prev = 0xffff;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = chunkUid;
     uint16_t written = AddSmall(&item);
     UpdateHead(written);
 }
@@ -673,6 +747,16 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (!AppendOp(REMOVE_HEADER, uid, size))
+    {
+        DoRemoveHeader(uid, size);
+    }
+}
+
+void
+PacketMetadata::DoRemoveHeader(uint32_t uid, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << uid << size);
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_head, &item, &extraItem);
@@ -718,16 +802,27 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    uint16_t chunkUid = m_chunkUid;
+    m_chunkUid++;
+    if (!AppendOp(ADD_TRAILER, uid, size, chunkUid))
+    {
+        AddTrailerItem(uid, size, chunkUid);
+    }
+    NS_ASSERT(IsStateOk());
+}
+
+void
+PacketMetadata::AddTrailerItem(uint32_t uid, uint32_t size, uint16_t chunkUid)
+{
+    NS_LOG_FUNCTION(this << uid << size << chunkUid);
     PacketMetadata::SmallItem item;
     item.next = 0xffff;
     item.prev = m_tail;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = chunkUid;
     uint16_t written = AddSmall(&item);
     UpdateTail(written);
-    NS_ASSERT(IsStateOk());
 }
 
 void
@@ -740,6 +835,16 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (!AppendOp(REMOVE_TRAILER, uid, size))
+    {
+        DoRemoveTrailer(uid, size);
+    }
+}
+
+void
+PacketMetadata::DoRemoveTrailer(uint32_t uid, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << uid << size);
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_tail, &item, &extraItem);
@@ -784,6 +889,9 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
         m_metadataSkipped = true;
         return;
     }
+    // Appending the items of a packet is not logged.
+    Materialize();
+    o.Materialize();
     if (m_tail == 0xffff)
     {
         // We have no items so 'AddAtEnd' is
@@ -872,6 +980,10 @@ PacketMetadata::RemoveAtStart(uint32_t start)
         return;
     }
     NS_ASSERT(m_data != nullptr);
+    if (AppendOp(REMOVE_AT_START, 0, start))
+    {
+        return;
+    }
     uint32_t leftToRemove = start;
     uint16_t current = m_head;
     while (current != 0xffff && leftToRemove > 0)
@@ -898,6 +1010,7 @@ PacketMetadata::RemoveAtStart(uint32_t start)
         {
             // fragment the list item.
             PacketMetadata fragment(m_packetUid, 0);
+            fragment.m_data->m_isLog = false;
             extraItem.fragmentStart += leftToRemove;
             leftToRemove = 0;
             uint16_t written = fragment.AddBig(0xffff, fragment.m_tail, &item, &extraItem);
@@ -933,6 +1046,10 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
         return;
     }
     NS_ASSERT(m_data != nullptr);
+    if (AppendOp(REMOVE_AT_END, 0, end))
+    {
+        return;
+    }
 
     uint32_t leftToRemove = end;
     uint16_t current = m_tail;
@@ -960,6 +1077,7 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
         {
             // fragment the list item.
             PacketMetadata fragment(m_packetUid, 0);
+            fragment.m_data->m_isLog = false;
             NS_ASSERT(extraItem.fragmentEnd > leftToRemove);
             extraItem.fragmentEnd -= leftToRemove;
             leftToRemove = 0;
@@ -1020,6 +1138,7 @@ PacketMetadata::ItemIterator
 PacketMetadata::BeginItem(Buffer buffer) const
 {
     NS_LOG_FUNCTION(this << &buffer);
+    Materialize();
     return ItemIterator(this, buffer);
 }
 
@@ -1116,6 +1235,7 @@ PacketMetadata::GetSerializedSize() const
         return totalSize;
     }
 
+    Materialize();
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t current = m_head;
@@ -1148,6 +1268,7 @@ uint32_t
 PacketMetadata::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
     NS_LOG_FUNCTION(this << &buffer << maxSize);
+    Materialize();
     uint8_t* start = buffer;
 
     buffer = AddToRawU64(m_packetUid, start, buffer, maxSize);
@@ -1254,6 +1375,7 @@ uint32_t
 PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &buffer << size);
+    Materialize();
     const uint8_t* start = buffer;
     uint32_t desSize = size - 4;
 
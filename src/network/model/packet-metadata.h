@@ -18,6 +18,10 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -65,6 +69,12 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * Most packets are never printed, so the metadata can also be kept
+ * lazily (see PacketMetadata::EnableLazy): the operations performed on
+ * the packet are then appended to a log of fixed-size records stored
+ * in the same shared byte buffer, and the linked list of items is
+ * built by replaying this log only when the items are first read.
  */
 class PacketMetadata
 {
@@ -158,6 +168,21 @@ class PacketMetadata
      * @brief Enable the packet metadata checking
      */
     static void EnableChecking();
+    /**
+     * @brief Keep the metadata created from now on as a log of the
+     * operations performed on the packet, and build the items of a packet
+     * only when they are first read, to make the metadata of the packets
+     * which are never printed cheaper. This also enables the metadata.
+     *
+     * The metadata checking is not compatible with this mode: when it is
+     * enabled, the items are still built eagerly.
+     */
+    static void EnableLazy();
+    /**
+     * @brief Build the items of the metadata created from now on eagerly,
+     * which is the default.
+     */
+    static void DisableLazy();
 
     /**
      * @brief Constructor
@@ -415,11 +440,17 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /** size (in bytes) of m_data buffer below */
         uint32_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
         uint16_t m_dirtyEnd;
+        /** true if m_data holds a log of operations rather than a list of items */
+        bool m_isLog;
         /** variable-sized buffer of bytes */
         uint8_t m_data[PACKET_METADATA_DATA_M_DATA_SIZE];
     };
@@ -498,16 +529,6 @@ class PacketMetadata
         uint64_t packetUid;
     };
 
-    /**
-     * @brief Class to hold all the metadata
-     */
-    class DataFreeList : public std::vector<Data*>
-    {
-      public:
-        ~DataFreeList();
-    };
-
-    friend DataFreeList::~DataFreeList();
     /// Friend class
     friend class ItemIterator;
 
@@ -595,6 +616,13 @@ class PacketMetadata
      * @param n space to reserve
      */
     inline void Reserve(uint32_t n);
+
+    /**
+     * @brief Check if new items can not be written in place
+     * @returns true if m_data is shared with another PacketMetadata which
+     *          may have written past m_used
+     */
+    bool IsDirty() const;
     /**
      * @brief Reserve space and make a metadata copy
      * @param n space to reserve
@@ -623,6 +651,79 @@ class PacketMetadata
      * @param size header serialized size
      */
     void DoAddHeader(uint32_t uid, uint32_t size);
+    /**
+     * @brief Add the item of an header
+     * @param uid header's uid to add
+     * @param size header serialized size
+     * @param chunkUid the uid of the header
+     */
+    void AddHeaderItem(uint32_t uid, uint32_t size, uint16_t chunkUid);
+    /**
+     * @brief Add the item of a trailer
+     * @param uid trailer's uid to add
+     * @param size trailer serialized size
+     * @param chunkUid the uid of the trailer
+     */
+    void AddTrailerItem(uint32_t uid, uint32_t size, uint16_t chunkUid);
+    /**
+     * @brief Remove the item of an header
+     * @param uid header's uid to remove
+     * @param size header serialized size
+     */
+    void DoRemoveHeader(uint32_t uid, uint32_t size);
+    /**
+     * @brief Remove the item of a trailer
+     * @param uid trailer's uid to remove
+     * @param size trailer serialized size
+     */
+    void DoRemoveTrailer(uint32_t uid, uint32_t size);
+
+    /// The type of an operation of the log
+    enum LogOpType : uint8_t
+    {
+        ADD_HEADER,      //!< AddHeader
+        REMOVE_HEADER,   //!< RemoveHeader
+        ADD_TRAILER,     //!< AddTrailer
+        REMOVE_TRAILER,  //!< RemoveTrailer
+        REMOVE_AT_START, //!< RemoveAtStart
+        REMOVE_AT_END    //!< RemoveAtEnd
+    };
+
+    /**
+     * @brief An operation of the log, copied as is in the byte buffer
+     */
+    struct LogOp
+    {
+        uint32_t typeUid;  //!< the uid of the header or trailer
+        uint32_t size;     //!< the size of the header or trailer, or the size removed
+        uint16_t chunkUid; //!< the uid of the header or trailer added
+        uint8_t type;      //!< the LogOpType
+    };
+
+    /**
+     * @brief Check if the metadata is a log of operations
+     * @returns true if the items are not built yet
+     */
+    bool IsLog() const;
+    /**
+     * @brief Append an operation to the log
+     * @param type the type of the operation
+     * @param typeUid the uid of the header or trailer
+     * @param size the size of the header or trailer, or the size removed
+     * @param chunkUid the uid of the header or trailer added
+     * @returns true if the operation was logged, false if the metadata
+     *          holds items, which the caller must then update.
+     */
+    bool AppendOp(LogOpType type, uint32_t typeUid, uint32_t size, uint16_t chunkUid = 0);
+    /**
+     * @brief Build the items by replaying the log, if the metadata is
+     * a log.
+     *
+     * This does not change the value of the metadata, only its
+     * representation, hence this method is const.
+     */
+    void Materialize() const;
+
     /**
      * @brief Check if the metadata state is ok
      * @returns true if the internal state is ok
@@ -652,21 +753,10 @@ class PacketMetadata
      * @returns a pointer to the created buffer storage
      */
     static PacketMetadata::Data* Create(uint32_t size);
-    /**
-     * @brief Allocate a buffer data storage
-     * @param n the storage size to create
-     * @returns a pointer to the allocated buffer storage
-     */
-    static PacketMetadata::Data* Allocate(uint32_t n);
-    /**
-     * @brief Deallocate the buffer memory
-     * @param data the buffer data storage
-     */
-    static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
+    static bool m_enableLazy;     //!< Keep the new packet metadata as a log
 
     /**
      * Set to true when adding metadata to a packet is skipped because
@@ -675,8 +765,13 @@ class PacketMetadata
      */
     static bool m_metadataSkipped;
 
+#ifdef NS3_MTP
+    static thread_local uint32_t m_maxSize;  //!< maximum metadata size
+    static thread_local uint16_t m_chunkUid; //!< Chunk Uid
+#else
     static uint32_t m_maxSize;  //!< maximum metadata size
     static uint16_t m_chunkUid; //!< Chunk Uid
+#endif
 
     Data* m_data; //!< Metadata storage
     /*
@@ -703,6 +798,7 @@ PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
       m_packetUid(uid)
 {
     memset(m_data->m_data, 0xff, 4);
+    m_data->m_isLog = m_enableLazy && !m_enableChecking;
     if (size > 0)
     {
         DoAddHeader(0, size);
@@ -728,8 +824,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
@@ -747,8 +842,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -41,6 +41,25 @@ PacketTagList::CreateTagData(size_t dataSize)
     return tag;
 }
 
+#ifdef NS3_MTP
+void
+PacketTagList::DeepCopy(const PacketTagList& o)
+{
+    NS_ASSERT(m_next == nullptr);
+    TagData** prevNext = &m_next;
+    for (const TagData* cur = o.m_next; cur != nullptr; cur = cur->next)
+    {
+        TagData* copy = CreateTagData(cur->size);
+        copy->tid = cur->tid;
+        copy->count = 1;
+        memcpy(copy->data, cur->data, copy->size);
+        *prevNext = copy;
+        prevNext = &copy->next;
+    }
+    *prevNext = nullptr;
+}
+#endif
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -148,6 +148,8 @@ class PacketTagList
      *
      * This makes a light-weight copy by #RemoveAll, then
      * pointing to the same \ref TagData as \pname{o}.
+     * With NS3_MTP the tags are copied instead, so that lists held by
+     * different threads never share a \ref TagData.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -242,6 +244,15 @@ class PacketTagList
      */
     static TagData* CreateTagData(size_t dataSize);
 
+#ifdef NS3_MTP
+    /**
+     * Copy the tags of another, empty or not, list.  This list must be empty.
+     *
+     * @param [in] o The PacketTagList to copy.
+     */
+    void DeepCopy(const PacketTagList& o);
+#endif
+
     /**
      * Typedef of method function pointer for copy-on-write operations
      *
@@ -313,10 +324,15 @@ PacketTagList::PacketTagList()
 PacketTagList::PacketTagList(const PacketTagList& o)
     : m_next(o.m_next)
 {
+#ifdef NS3_MTP
+    m_next = nullptr;
+    DeepCopy(o);
+#else
     if (m_next != nullptr)
     {
         m_next->count++;
     }
+#endif
 }
 
 PacketTagList&
@@ -328,11 +344,15 @@ PacketTagList::operator=(const PacketTagList& o)
         return *this;
     }
     RemoveAll();
+#ifdef NS3_MTP
+    DeepCopy(o);
+#else
     m_next = o.m_next;
     if (m_next != nullptr)
     {
         m_next->count++;
     }
+#endif
     return *this;
 }
 
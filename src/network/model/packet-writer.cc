@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-writer.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketWriter");
+
+PacketWriter::PacketWriter(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_buffer.Reserve(HEADROOM, size + TAILROOM);
+    m_buffer.AddAtEnd(size);
+}
+
+Buffer::Iterator
+PacketWriter::Begin()
+{
+    NS_LOG_FUNCTION(this);
+    return m_buffer.Begin();
+}
+
+Ptr<Packet>
+PacketWriter::GetPacket() const
+{
+    NS_LOG_FUNCTION(this);
+    // call the constructor directly rather than through Create
+    // because it is private.
+    return Ptr<Packet>(new Packet(m_buffer), false);
+}
+
+} // namespace ns3
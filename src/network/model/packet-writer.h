@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PACKET_WRITER_H
+#define PACKET_WRITER_H
+
+#include "buffer.h"
+#include "packet.h"
+
+#include "ns3/ptr.h"
+
+#include <stdint.h>
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ *
+ * @brief Serialize a payload directly into the buffer of a new Packet.
+ *
+ * Packet(const uint8_t*, uint32_t) copies a payload serialized
+ * elsewhere, and the buffer of the new packet then has no room for the
+ * headers, so that adding the first header copies the payload again.
+ * A PacketWriter reserves room for the payload and for the headers and
+ * trailers of a usual protocol stack, and lets the payload be written
+ * in place:
+ *
+ * @code
+ * PacketWriter writer(size);
+ * Buffer::Iterator i = writer.Begin();
+ * i.WriteHtonU32(sequence);
+ * ...
+ * Ptr<Packet> packet = writer.GetPacket();
+ * @endcode
+ */
+class PacketWriter
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param size the size of the payload
+     */
+    PacketWriter(uint32_t size);
+
+    /**
+     * @returns an iterator to the start of the payload
+     */
+    Buffer::Iterator Begin();
+
+    /**
+     * Create the packet. The payload must be written before.
+     *
+     * @returns a new packet, with a new uid, holding the payload
+     */
+    Ptr<Packet> GetPacket() const;
+
+    /// The room reserved for the headers, enough for 802.11, IPv6 and TCP.
+    static constexpr uint32_t HEADROOM = 128;
+    /// The room reserved for the trailers.
+    static constexpr uint32_t TAILROOM = 16;
+
+  private:
+    Buffer m_buffer; //!< the payload
+};
+
+} // namespace ns3
+
+#endif /* PACKET_WRITER_H */
@@ -19,7 +19,11 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -135,10 +139,9 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -175,10 +178,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -202,15 +204,53 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
 }
 
+Packet::Packet(uint8_t* buffer, uint32_t size, const Callback<void, uint8_t*>& release)
+    : Packet(Buffer(buffer, size, release))
+{
+}
+
+/**
+ * Create a Buffer which adopts the bytes of a vector.
+ *
+ * @param bytes the bytes
+ * @returns the Buffer
+ */
+static Buffer
+AdoptBytes(std::vector<uint8_t>&& bytes)
+{
+    auto data = new std::vector<uint8_t>(std::move(bytes));
+    return Buffer(data->data(), data->size(), [data](uint8_t*) { delete data; });
+}
+
+Packet::Packet(std::vector<uint8_t>&& bytes)
+    : Packet(AdoptBytes(std::move(bytes)))
+{
+}
+
+Packet::Packet(const Buffer& buffer)
+    : m_buffer(buffer),
+      m_byteTagList(),
+      m_packetTagList(),
+      /* The upper 32 bits of the packet id in
+       * metadata is for the system id. For non-
+       * distributed simulations, this is simply
+       * zero.  The lower 32 bits are for the
+       * global UID
+       */
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++,
+                 buffer.GetSize()),
+      m_nixVector(nullptr)
+{
+}
+
 Packet::Packet(const Buffer& buffer,
                const ByteTagList& byteTagList,
                const PacketTagList& packetTagList,
@@ -588,6 +628,13 @@ Packet::EnablePrinting()
     PacketMetadata::Enable();
 }
 
+void
+Packet::EnableLazyPrinting()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    PacketMetadata::EnableLazy();
+}
+
 void
 Packet::EnableChecking()
 {
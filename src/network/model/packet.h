@@ -23,6 +23,11 @@
 #include "ns3/ptr.h"
 
 #include <stdint.h>
+#include <vector>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 namespace ns3
 {
@@ -279,6 +284,28 @@ class Packet : public SimpleRefCount<Packet>
      * @param size the size of the input buffer.
      */
     Packet(const uint8_t* buffer, uint32_t size);
+    /**
+     * @brief Create a packet with a payload made of these bytes.
+     *
+     * The input data is not copied: the packet and its copies share
+     * the bytes until a header or trailer is added, and the bytes are
+     * never written. They must stay valid until release is invoked with
+     * the buffer pointer, once the last packet sharing them is destroyed.
+     *
+     * @param buffer the data to adopt as the payload.
+     * @param size the size of the input buffer.
+     * @param release the callback releasing the data.
+     */
+    Packet(uint8_t* buffer, uint32_t size, const Callback<void, uint8_t*>& release);
+    /**
+     * @brief Create a packet with a payload made of these bytes.
+     *
+     * The bytes are moved into the packet instead of being copied,
+     * see Packet(uint8_t*, uint32_t, const Callback<void, uint8_t*>&).
+     *
+     * @param bytes the data to adopt as the payload.
+     */
+    Packet(std::vector<uint8_t>&& bytes);
     /**
      * @brief Create a new packet which contains a fragment of the original
      * packet.
@@ -514,6 +541,16 @@ class Packet : public SimpleRefCount<Packet>
      * simulation setup and before any packet is created.
      */
     static void EnablePrinting();
+    /**
+     * @brief Enable printing packets metadata, built lazily.
+     *
+     * Like EnablePrinting, but the metadata of a packet is kept as a log
+     * of the operations performed on it, and the headers and trailers
+     * it describes are only worked out when the packet is printed or
+     * iterated over. This makes the metadata much cheaper for the
+     * packets which are never printed.
+     */
+    static void EnableLazyPrinting();
     /**
      * @brief Enable packets metadata checking.
      *
@@ -767,6 +804,11 @@ class Packet : public SimpleRefCount<Packet>
            const ByteTagList& byteTagList,
            const PacketTagList& packetTagList,
            const PacketMetadata& metadata);
+    /**
+     * @brief Create a packet with a payload made of this buffer, and a new uid.
+     * @param buffer the packet buffer
+     */
+    Packet(const Buffer& buffer);
 
     /**
      * @brief Deserializes a packet.
@@ -784,7 +826,13 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
+
+    friend class PacketWriter;
 };
 
 /**
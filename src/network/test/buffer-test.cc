@@ -382,6 +382,36 @@ BufferTest::DoRun()
     val2 <<= 8;
     val2 |= i.ReadU8();
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
+
+    // the reserved room is used in place
+    buffer = Buffer();
+    buffer.Reserve(16, 32);
+    const uint8_t* reserved = buffer.PeekData();
+    buffer.AddAtEnd(32);
+    buffer.AddAtStart(16);
+    NS_TEST_ASSERT_MSG_EQ((buffer.PeekData() + 16 == reserved), true, "Reserved room not used");
+
+    // adopted bytes are shared, never written, and released once
+    uint8_t adopted[] = {0x11, 0x22, 0x33};
+    int released = 0;
+    buffer = Buffer(adopted, 3, [&released](uint8_t*) { released++; });
+    NS_TEST_ASSERT_MSG_EQ((buffer.PeekData() == adopted), true, "Adopted bytes copied");
+    other = buffer;
+    other.AddAtStart(1);
+    other.Begin().WriteU8(0x00);
+    other.AddAtEnd(1);
+    i = other.End();
+    i.Prev();
+    i.WriteU8(0x44);
+    ENSURE_WRITTEN_BYTES(other, 5, 0x00, 0x11, 0x22, 0x33, 0x44);
+    ENSURE_WRITTEN_BYTES(buffer, 3, 0x11, 0x22, 0x33);
+    NS_TEST_ASSERT_MSG_EQ((buffer.PeekData() == adopted), true, "Adopted bytes copied");
+    Buffer fragment = buffer.CreateFragment(1, 2);
+    buffer = Buffer();
+    NS_TEST_ASSERT_MSG_EQ(released, 0, "Adopted bytes released while in use");
+    ENSURE_WRITTEN_BYTES(fragment, 2, 0x22, 0x33);
+    fragment = Buffer();
+    NS_TEST_ASSERT_MSG_EQ(released, 1, "Adopted bytes not released once");
 }
 
 /**
@@ -315,7 +315,11 @@ HistoryTrailer<N>::Deserialize(Buffer::Iterator start)
 class PacketMetadataTest : public TestCase
 {
   public:
-    PacketMetadataTest();
+    /**
+     * Constructor
+     * @param lazy whether the metadata is built lazily
+     */
+    PacketMetadataTest(bool lazy);
     ~PacketMetadataTest() override;
     /**
      * Checks the packet header and trailer history
@@ -333,10 +337,13 @@ class PacketMetadataTest : public TestCase
      * @return The packet with the header added.
      */
     Ptr<Packet> DoAddHeader(Ptr<Packet> p);
+
+    bool m_lazy; //!< whether the metadata is built lazily
 };
 
-PacketMetadataTest::PacketMetadataTest()
-    : TestCase("Packet metadata")
+PacketMetadataTest::PacketMetadataTest(bool lazy)
+    : TestCase(lazy ? "Packet metadata, built lazily" : "Packet metadata"),
+      m_lazy(lazy)
 {
 }
 
@@ -469,6 +476,10 @@ void
 PacketMetadataTest::DoRun()
 {
     PacketMetadata::Enable();
+    if (m_lazy)
+    {
+        PacketMetadata::EnableLazy();
+    }
 
     Ptr<Packet> p = Create<Packet>(0);
     Ptr<Packet> p1 = Create<Packet>(0);
@@ -868,6 +879,21 @@ PacketMetadataTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(msg,
                           std::string("hello world"),
                           "Could not find original data in received packet");
+
+    // a long history, which the lazy metadata compacts.
+    p = Create<Packet>(10);
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        ADD_HEADER(p, 2);
+        REM_HEADER(p, 2);
+    }
+    ADD_HEADER(p, 3);
+    CHECK_HISTORY(p, 2, 3, 10);
+
+    if (m_lazy)
+    {
+        PacketMetadata::DisableLazy();
+    }
 }
 
 /**
@@ -885,7 +911,8 @@ class PacketMetadataTestSuite : public TestSuite
 PacketMetadataTestSuite::PacketMetadataTestSuite()
     : TestSuite("packet-metadata", Type::UNIT)
 {
-    AddTestCase(new PacketMetadataTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(false), TestCase::Duration::QUICK);
+    AddTestCase(new PacketMetadataTest(true), TestCase::Duration::QUICK);
 }
 
 static PacketMetadataTestSuite g_packetMetadataTest; //!< Static variable for test initialization
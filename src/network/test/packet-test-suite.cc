@@ -5,7 +5,9 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/packet-allocator.h"
 #include "ns3/packet-tag-list.h"
+#include "ns3/packet-writer.h"
 #include "ns3/packet.h"
 #include "ns3/test.h"
 
@@ -15,6 +17,7 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -1257,6 +1260,120 @@ PacketTagListTest::DoRun()
     }
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packets created without copying their payload.
+ */
+class PacketAdoptTest : public TestCase
+{
+  public:
+    PacketAdoptTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAdoptTest::PacketAdoptTest()
+    : TestCase("Packets adopting their payload or writing it in place")
+{
+}
+
+void
+PacketAdoptTest::DoRun()
+{
+    std::vector<uint8_t> bytes{1, 2, 3, 4, 5, 6, 7, 8};
+    const uint8_t* data = bytes.data();
+    Ptr<Packet> p = Create<Packet>(std::move(bytes));
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 8, "Bad adopted payload size");
+    Ptr<Packet> copy = p->Copy();
+    copy->AddHeader(ATestHeader<2>());
+    copy->RemoveAtEnd(4);
+
+    std::vector<uint8_t> out(8);
+    p->CopyData(out.data(), 8);
+    NS_TEST_EXPECT_MSG_EQ((out == std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8}),
+                          true,
+                          "Adopted payload changed by a copy");
+    NS_TEST_EXPECT_MSG_EQ(data[0], 1, "Adopted payload written by a copy");
+    NS_TEST_EXPECT_MSG_EQ(copy->GetSize(), 6, "Bad copy size");
+    copy->CopyData(out.data(), 6);
+    NS_TEST_EXPECT_MSG_EQ((out == std::vector<uint8_t>{2, 2, 1, 2, 3, 4, 7, 8}),
+                          true,
+                          "Bad copy content");
+    NS_TEST_EXPECT_MSG_NE(p->GetUid(), Create<Packet>()->GetUid(), "Adopting packet without uid");
+
+    PacketWriter writer(4);
+    Buffer::Iterator i = writer.Begin();
+    i.WriteHtonU32(0x01020304);
+    p = writer.GetPacket();
+    p->AddHeader(ATestHeader<10>());
+    p->AddTrailer(ATestTrailer<2>());
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 16, "Bad written packet size");
+    out.resize(16);
+    p->CopyData(out.data(), 16);
+    NS_TEST_EXPECT_MSG_EQ((out == std::vector<uint8_t>{10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+                                                       1, 2, 3, 4, 2, 2}),
+                          true,
+                          "Bad written packet content");
+    ATestHeader<10> header;
+    p->RemoveHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(header.m_error, false, "Bad written packet header");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Allocation of the packet storage.
+ */
+class PacketAllocatorTest : public TestCase
+{
+  public:
+    PacketAllocatorTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAllocatorTest::PacketAllocatorTest()
+    : TestCase("Packet storage reused by size class")
+{
+}
+
+void
+PacketAllocatorTest::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(1), 32, "Bad smallest class");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(33), 48, "Bad class");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(1500), 1536, "Bad class");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(65536), 65536, "Bad largest class");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(70000), 70000, "Bad large block");
+
+    void* block = PacketAllocator::Allocate(1400);
+    PacketAllocator::Stats before = PacketAllocator::GetStats();
+    PacketAllocator::Deallocate(block, 1400);
+    void* other = PacketAllocator::Allocate(1500);
+    PacketAllocator::Stats after = PacketAllocator::GetStats();
+    PacketAllocator::Deallocate(other, 1500);
+    NS_TEST_EXPECT_MSG_EQ(other, block, "Freed block of the same class not reused");
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations, 1, "Bad allocation count");
+    NS_TEST_EXPECT_MSG_EQ(after.hits - before.hits, 1, "Bad hit count");
+    NS_TEST_EXPECT_MSG_EQ(after.bytesFree, before.bytesFree, "Bad free bytes");
+    NS_TEST_EXPECT_MSG_EQ(after.bytesResident, before.bytesResident, "Bad resident bytes");
+
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddHeader(ATestHeader<10>());
+        p->AddByteTag(ATestTag<4>());
+    }
+    after = PacketAllocator::GetStats();
+    NS_TEST_EXPECT_MSG_GT(after.GetHitRate(), 0.5, "Packet storage not reused");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.bytesResident, after.bytesFree, "Bad resident bytes");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1391,8 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketAdoptTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketAllocatorTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
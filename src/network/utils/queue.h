@@ -526,7 +526,7 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& r
     m_nTotalReceivedPackets++;
 
     NS_LOG_LOGIC("m_traceEnqueue (p)");
-    m_traceEnqueue(item);
+    NS_TRACE_ALWAYS(m_traceEnqueue, item);
 
     return true;
 }
@@ -555,7 +555,7 @@ Queue<Item, Container>::DoDequeue(ConstIterator pos)
         m_nPackets--;
 
         NS_LOG_LOGIC("m_traceDequeue (p)");
-        m_traceDequeue(item);
+        NS_TRACE_ALWAYS(m_traceDequeue, item);
     }
     return item;
 }
@@ -585,7 +585,7 @@ Queue<Item, Container>::DoRemove(ConstIterator pos)
 
         // packets are first dequeued and then dropped
         NS_LOG_LOGIC("m_traceDequeue (p)");
-        m_traceDequeue(item);
+        NS_TRACE_ALWAYS(m_traceDequeue, item);
 
         DropAfterDequeue(item);
     }
@@ -639,8 +639,8 @@ Queue<Item, Container>::DropBeforeEnqueue(Ptr<Item> item)
     m_nTotalDroppedBytesBeforeEnqueue += item->GetSize();
 
     NS_LOG_LOGIC("m_traceDropBeforeEnqueue (p)");
-    m_traceDrop(item);
-    m_traceDropBeforeEnqueue(item);
+    NS_TRACE_ALWAYS(m_traceDrop, item);
+    NS_TRACE_ALWAYS(m_traceDropBeforeEnqueue, item);
 }
 
 template <typename Item, typename Container>
@@ -655,8 +655,8 @@ Queue<Item, Container>::DropAfterDequeue(Ptr<Item> item)
     m_nTotalDroppedBytesAfterDequeue += item->GetSize();
 
     NS_LOG_LOGIC("m_traceDropAfterDequeue (p)");
-    m_traceDrop(item);
-    m_traceDropAfterDequeue(item);
+    NS_TRACE_ALWAYS(m_traceDrop, item);
+    NS_TRACE_ALWAYS(m_traceDropAfterDequeue, item);
 }
 
 // The following explicit template instantiation declarations prevent all the
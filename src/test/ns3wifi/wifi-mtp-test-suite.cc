@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiMtpTest");
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Run groups of moving ad hoc Wi-Fi nodes with the default and the
+ * multithreaded SimulatorImpl, and compare the receptions.
+ *
+ * The nodes move with a ConstantVelocityMobilityModel and the channels use a
+ * Nakagami loss model, so that sending updates the mobility and the random
+ * stream of the receivers. The nodes of a channel must then run on the same
+ * thread, and each channel is expected to get its own partition.
+ */
+class WifiMtpTest : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param channels The number of channels, each with its own nodes.
+     */
+    WifiMtpTest(uint32_t channels);
+
+  private:
+    void DoRun() override;
+
+    /** A reception: time, packet size. */
+    using Rx = std::tuple<int64_t, uint32_t>;
+
+    /**
+     * Run the nodes.
+     *
+     * @param impl The simulator implementation.
+     * @returns The receptions, indexed by node.
+     */
+    std::vector<std::vector<Rx>> RunNodes(Ptr<SimulatorImpl> impl);
+
+    /**
+     * Send a broadcast packet, and schedule the next one.
+     *
+     * @param device The sending device.
+     */
+    void Send(Ptr<NetDevice> device);
+
+    /**
+     * Device receive callback.
+     *
+     * @param device The receiving device.
+     * @param packet The packet.
+     * @param protocol The protocol.
+     * @param from The sender address.
+     * @returns true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    static constexpr uint32_t N_NODES = 4; //!< The number of nodes of each channel.
+
+    uint32_t m_channels;               //!< The number of channels.
+    std::vector<std::vector<Rx>> m_rx; //!< The receptions, indexed by node.
+};
+
+WifiMtpTest::WifiMtpTest(uint32_t channels)
+    : TestCase("Check that " + std::to_string(channels) +
+               " Wi-Fi channels run the same on several threads"),
+      m_channels(channels)
+{
+}
+
+void
+WifiMtpTest::Send(Ptr<NetDevice> device)
+{
+    device->Send(Create<Packet>(100 + device->GetNode()->GetId()),
+                 Mac48Address::GetBroadcast(),
+                 0x800);
+    Simulator::Schedule(MilliSeconds(10), &WifiMtpTest::Send, this, device);
+}
+
+bool
+WifiMtpTest::Receive(Ptr<NetDevice> device,
+                     Ptr<const Packet> packet,
+                     uint16_t protocol,
+                     const Address& from)
+{
+    m_rx[device->GetNode()->GetId()].emplace_back(Simulator::Now().GetTimeStep(),
+                                                  packet->GetSize());
+    return true;
+}
+
+std::vector<std::vector<WifiMtpTest::Rx>>
+WifiMtpTest::RunNodes(Ptr<SimulatorImpl> impl)
+{
+    Simulator::Destroy();
+    Simulator::SetImplementation(impl);
+
+    m_rx.assign(m_channels * N_NODES, {});
+    int64_t stream = 1;
+    for (uint32_t c = 0; c < m_channels; c++)
+    {
+        NodeContainer nodes(N_NODES);
+        for (uint32_t i = 0; i < N_NODES; i++)
+        {
+            auto mobility = CreateObject<ConstantVelocityMobilityModel>();
+            mobility->SetPosition(Vector(1000.0 * c + 10.0 * i, 0, 0));
+            mobility->SetVelocity(Vector(i, 1, 0));
+            nodes.Get(i)->AggregateObject(mobility);
+        }
+
+        YansWifiChannelHelper channelHelper = YansWifiChannelHelper::Default();
+        channelHelper.AddPropagationLoss("ns3::NakagamiPropagationLossModel");
+        Ptr<YansWifiChannel> channel = channelHelper.Create();
+        YansWifiPhyHelper phy;
+        phy.SetChannel(channel);
+        WifiHelper wifi;
+        wifi.SetStandard(WIFI_STANDARD_80211a);
+        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                     "DataMode",
+                                     StringValue("OfdmRate6Mbps"),
+                                     "ControlMode",
+                                     StringValue("OfdmRate6Mbps"));
+        WifiMacHelper mac;
+        mac.SetType("ns3::AdhocWifiMac");
+        NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+        stream += WifiHelper::AssignStreams(devices, stream);
+        stream += channelHelper.AssignStreams(channel, stream);
+
+        for (uint32_t i = 0; i < N_NODES; i++)
+        {
+            Ptr<NetDevice> device = devices.Get(i);
+            device->SetReceiveCallback(MakeCallback(&WifiMtpTest::Receive, this));
+            Simulator::ScheduleWithContext(device->GetNode()->GetId(),
+                                           MilliSeconds(100 + 3 * i),
+                                           &WifiMtpTest::Send,
+                                           this,
+                                           device);
+        }
+    }
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+
+    auto rx = m_rx;
+    for (auto& nodeRx : rx)
+    {
+        std::sort(nodeRx.begin(), nodeRx.end());
+    }
+    Simulator::Destroy();
+    return rx;
+}
+
+void
+WifiMtpTest::DoRun()
+{
+    auto reference = RunNodes(CreateObject<DefaultSimulatorImpl>());
+
+    ObjectFactory factory("ns3::MultithreadedSimulatorImpl");
+    factory.Set("MaxThreads", UintegerValue(2));
+    auto impl = factory.Create<MultithreadedSimulatorImpl>();
+    auto rx = RunNodes(impl);
+
+    NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(),
+                          std::min<uint32_t>(m_channels, 2),
+                          "The nodes of a channel must share a partition");
+    for (uint32_t i = 0; i < m_channels * N_NODES; i++)
+    {
+        NS_TEST_EXPECT_MSG_GT(rx[i].size(), 0, "No reception at node " << i);
+        NS_TEST_EXPECT_MSG_EQ((rx[i] == reference[i]), true, "Different receptions at node " << i);
+    }
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Wi-Fi with the multithreaded simulator Test Suite
+ */
+class WifiMtpTestSuite : public TestSuite
+{
+  public:
+    WifiMtpTestSuite();
+};
+
+WifiMtpTestSuite::WifiMtpTestSuite()
+    : TestSuite("wifi-mtp", Type::UNIT)
+{
+    AddTestCase(new WifiMtpTest(1), TestCase::Duration::QUICK);
+    AddTestCase(new WifiMtpTest(2), TestCase::Duration::QUICK);
+}
+
+static WifiMtpTestSuite g_wifiMtpTestSuite; ///< the test suite
@@ -680,7 +680,7 @@ QueueDisc::PacketEnqueued(Ptr<const QueueDiscItem> item)
     m_stats.nTotalEnqueuedBytes += item->GetSize();
 
     NS_LOG_LOGIC("m_traceEnqueue (p)");
-    m_traceEnqueue(item);
+    NS_TRACE_ALWAYS(m_traceEnqueue, item);
 }
 
 void
@@ -701,7 +701,7 @@ QueueDisc::PacketDequeued(Ptr<const QueueDiscItem> item)
         m_sojourn(Simulator::Now() - item->GetTimeStamp());
 
         NS_LOG_LOGIC("m_traceDequeue (p)");
-        m_traceDequeue(item);
+        NS_TRACE_ALWAYS(m_traceDequeue, item);
     }
 }
 
@@ -740,8 +740,8 @@ QueueDisc::DropBeforeEnqueue(Ptr<const QueueDiscItem> item, const char* reason)
                  << m_stats.nTotalDroppedPacketsBeforeEnqueue << " / "
                  << m_stats.nTotalDroppedBytesBeforeEnqueue);
     NS_LOG_LOGIC("m_traceDropBeforeEnqueue (p)");
-    m_traceDrop(item);
-    m_traceDropBeforeEnqueue(item, reason);
+    NS_TRACE_ALWAYS(m_traceDrop, item);
+    NS_TRACE_ALWAYS(m_traceDropBeforeEnqueue, item, reason);
 }
 
 void
@@ -790,8 +790,8 @@ QueueDisc::DropAfterDequeue(Ptr<const QueueDiscItem> item, const char* reason)
                  << m_stats.nTotalDroppedPacketsAfterDequeue << " / "
                  << m_stats.nTotalDroppedBytesAfterDequeue);
     NS_LOG_LOGIC("m_traceDropAfterDequeue (p)");
-    m_traceDrop(item);
-    m_traceDropAfterDequeue(item, reason);
+    NS_TRACE_ALWAYS(m_traceDrop, item);
+    NS_TRACE_ALWAYS(m_traceDropAfterDequeue, item, reason);
 }
 
 bool
@@ -832,7 +832,7 @@ QueueDisc::Mark(Ptr<QueueDiscItem> item, const char* reason)
 
     NS_LOG_DEBUG("Total packets/bytes marked: " << m_stats.nTotalMarkedPackets << " / "
                                                 << m_stats.nTotalMarkedBytes);
-    m_traceMark(item, reason);
+    NS_TRACE_ALWAYS(m_traceMark, item, reason);
     return true;
 }
 
@@ -1046,7 +1046,7 @@ QueueDisc::Requeue(Ptr<QueueDiscItem> item)
     m_stats.nTotalRequeuedBytes += item->GetSize();
 
     NS_LOG_LOGIC("m_traceRequeue (p)");
-    m_traceRequeue(item);
+    NS_TRACE(m_traceRequeue, item);
 }
 
 bool
@@ -20,6 +20,11 @@
 #include "ns3/wifi-net-device.h"
 #include "ns3/yans-wifi-phy.h"
 
+#ifdef NS3_MPI
+#include "ns3/distributed-yans-wifi-channel.h"
+#include "ns3/mpi-interface.h"
+#endif
+
 namespace ns3
 {
 
@@ -41,7 +46,19 @@ YansWifiChannelHelper::Default()
 Ptr<YansWifiChannel>
 YansWifiChannelHelper::Create() const
 {
-    Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel>();
+    Ptr<YansWifiChannel> channel;
+    // If MPI is enabled with several ranks, the nodes of the channel may be
+    // simulated by different ranks
+#ifdef NS3_MPI
+    if (MpiInterface::IsEnabled() && MpiInterface::GetSize() > 1)
+    {
+        channel = CreateObject<DistributedYansWifiChannel>();
+    }
+#endif
+    if (!channel)
+    {
+        channel = CreateObject<YansWifiChannel>();
+    }
     Ptr<PropagationLossModel> prev = nullptr;
     for (auto i = m_propagationLoss.begin(); i != m_propagationLoss.end(); ++i)
     {
@@ -107,8 +124,8 @@ YansWifiPhyHelper::Create(Ptr<Node> node, Ptr<WifiNetDevice> device) const
         auto preambleDetection = m_preambleDetectionModel.front().Create<PreambleDetectionModel>();
         phy->SetPreambleDetectionModel(preambleDetection);
     }
-    phy->SetChannel(m_channel);
     phy->SetDevice(device);
+    phy->SetChannel(m_channel);
     return std::vector<Ptr<WifiPhy>>({phy});
 }
 
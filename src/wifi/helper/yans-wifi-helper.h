@@ -72,6 +72,8 @@ class YansWifiChannelHelper
      * @returns a new channel
      *
      * Create a channel based on the configuration parameters set previously.
+     * When MPI is enabled with more than one rank, the channel is a
+     * DistributedYansWifiChannel.
      */
     Ptr<YansWifiChannel> Create() const;
 
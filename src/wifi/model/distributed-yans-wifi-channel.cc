@@ -0,0 +1,536 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "distributed-yans-wifi-channel.h"
+
+#include "phy-entity.h"
+#include "wifi-mpdu.h"
+#include "wifi-net-device.h"
+#include "wifi-ppdu.h"
+#include "wifi-psdu.h"
+#include "wifi-utils.h"
+#include "yans-wifi-phy.h"
+
+#include "ns3/boolean.h"
+#include "ns3/channel-list.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/mpi-receiver.h"
+#include "ns3/node.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("DistributedYansWifiChannel");
+
+NS_OBJECT_ENSURE_REGISTERED(DistributedYansWifiChannel);
+
+namespace
+{
+
+/**
+ * Size of the receive buffers of the MPI interfaces, hence the largest
+ * message they can carry (MAX_MPI_MSG_SIZE).
+ */
+constexpr uint32_t MAX_MPI_MSG_SIZE = 2000;
+
+/**
+ * Bytes added by MpiInterface::SendPacket to the serialized packet: the
+ * arrival time, node id and interface index.
+ */
+constexpr uint32_t MPI_MSG_HEADER_SIZE = 16;
+
+/**
+ * Write a double to a buffer.
+ *
+ * @param i the buffer iterator
+ * @param value the value
+ */
+void
+WriteDouble(Buffer::Iterator& i, double value)
+{
+    i.WriteHtonU64(std::bit_cast<uint64_t>(value));
+}
+
+/**
+ * Read a double from a buffer.
+ *
+ * @param i the buffer iterator
+ * @return the value
+ */
+double
+ReadDouble(Buffer::Iterator& i)
+{
+    return std::bit_cast<double>(i.ReadNtohU64());
+}
+
+} // namespace
+
+TypeId
+DistributedYansWifiChannel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::DistributedYansWifiChannel")
+            .SetParent<YansWifiChannel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<DistributedYansWifiChannel>()
+            .AddAttribute("MinimumDistance",
+                          "The minimum distance, in meters, between two nodes of different "
+                          "ranks, which bounds the lookahead. If zero, it is measured between "
+                          "the positions of the nodes when the simulation starts.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&DistributedYansWifiChannel::m_minimumDistance),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("ExchangeMobility",
+                          "Whether the ranks send the course of their nodes to each other, "
+                          "rather than reading the position of the remote nodes from their twins.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&DistributedYansWifiChannel::m_exchangeMobility),
+                          MakeBooleanChecker())
+            .AddAttribute("Lookahead",
+                          "The propagation delay over the minimum distance between two nodes "
+                          "of different ranks.",
+                          TypeId::ATTR_GET,
+                          TimeValue(),
+                          MakeTimeAccessor(&DistributedYansWifiChannel::GetLookahead),
+                          MakeTimeChecker());
+    return tid;
+}
+
+DistributedYansWifiChannel::DistributedYansWifiChannel()
+    : m_mobilityIsSet(false),
+      m_lookaheadIsSet(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+DistributedYansWifiChannel::~DistributedYansWifiChannel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+DistributedYansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_proxies.clear();
+    m_ranks.clear();
+    YansWifiChannel::DoDispose();
+}
+
+bool
+DistributedYansWifiChannel::IsLocal(Ptr<YansWifiPhy> phy)
+{
+    auto device = phy->GetDevice();
+    return !device || device->GetNode()->GetSystemId() == MpiInterface::GetSystemId();
+}
+
+void
+DistributedYansWifiChannel::Add(Ptr<YansWifiPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    YansWifiChannel::Add(phy);
+    if (!m_mobilityIsSet)
+    {
+        m_mobilityIsSet = true;
+        Simulator::ScheduleNow(&DistributedYansWifiChannel::SetUpMobility, this);
+    }
+    if (!MpiInterface::IsEnabled())
+    {
+        return;
+    }
+
+    auto device = phy->GetDevice();
+    NS_ABORT_MSG_IF(!device, "The device of the PHY must be set before adding it to the channel");
+    auto node = device->GetNode();
+    if (node->GetSystemId() == MpiInterface::GetSystemId())
+    {
+        if (!device->GetObject<MpiReceiver>())
+        {
+            auto mpiRec = CreateObject<MpiReceiver>();
+            mpiRec->SetReceiveCallback(
+                MakeCallback(&DistributedYansWifiChannel::ReceiveFromRank));
+            device->AggregateObject(mpiRec);
+        }
+    }
+    else
+    {
+        m_ranks.emplace(node->GetSystemId(), std::make_pair(node->GetId(), device->GetIfIndex()));
+    }
+}
+
+Time
+DistributedYansWifiChannel::GetLookahead() const
+{
+    if (m_lookaheadIsSet)
+    {
+        return m_lookahead;
+    }
+    auto delay = DynamicCast<ConstantSpeedPropagationDelayModel>(m_delay);
+    NS_ABORT_MSG_IF(!delay, "A distributed channel requires a ConstantSpeedPropagationDelayModel");
+
+    double distance = m_minimumDistance;
+    if (distance == 0)
+    {
+        distance = std::numeric_limits<double>::infinity();
+        for (const auto& local : m_phyList)
+        {
+            if (!IsLocal(local) || !local->GetMobility())
+            {
+                continue;
+            }
+            for (const auto& remote : m_phyList)
+            {
+                if (!IsLocal(remote) && remote->GetMobility())
+                {
+                    distance = std::min(distance,
+                                        local->GetMobility()->GetDistanceFrom(
+                                            remote->GetMobility()));
+                }
+            }
+        }
+    }
+    m_lookahead = std::isinf(distance) ? Time::Max() : Seconds(distance / delay->GetSpeed());
+    m_lookaheadIsSet = true;
+    NS_LOG_DEBUG("minimum distance=" << distance << "m, lookahead=" << m_lookahead);
+    NS_ABORT_MSG_IF(m_lookahead.IsZero(), "Nodes of different ranks at the same position");
+    return m_lookahead;
+}
+
+void
+DistributedYansWifiChannel::SetUpMobility()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_exchangeMobility)
+    {
+        return;
+    }
+    m_proxies.assign(m_phyList.size(), nullptr);
+    for (uint32_t i = 0; i < m_phyList.size(); i++)
+    {
+        auto mobility = m_phyList[i]->GetMobility();
+        if (IsLocal(m_phyList[i]))
+        {
+            NS_ASSERT(mobility);
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&DistributedYansWifiChannel::CourseChanged, this).Bind(i));
+            continue;
+        }
+        // the initial course of the remote nodes is the one of their twins
+        m_proxies[i] = CreateObject<ConstantVelocityMobilityModel>();
+        if (mobility)
+        {
+            m_proxies[i]->SetPosition(mobility->GetPosition());
+            m_proxies[i]->SetVelocity(mobility->GetVelocity());
+        }
+    }
+}
+
+Ptr<MobilityModel>
+DistributedYansWifiChannel::GetReceiverMobility(uint32_t i) const
+{
+    if (i < m_proxies.size() && m_proxies[i])
+    {
+        return m_proxies[i];
+    }
+    return m_phyList[i]->GetMobility();
+}
+
+void
+DistributedYansWifiChannel::Send(Ptr<YansWifiPhy> sender,
+                                 Ptr<const WifiPpdu> ppdu,
+                                 dBm_u txPower) const
+{
+    NS_LOG_FUNCTION(this << sender << ppdu << txPower);
+    if (!IsLocal(sender))
+    {
+        // the twin of a remote node: its rank sends the PPDU
+        NS_LOG_LOGIC("Ignore the transmission of a remote PHY");
+        return;
+    }
+    Ptr<MobilityModel> senderMobility = sender->GetMobility();
+    NS_ASSERT(senderMobility);
+    for (uint32_t i = 0; i < m_phyList.size(); i++)
+    {
+        const auto& receiver = m_phyList[i];
+        if (receiver == sender)
+        {
+            continue;
+        }
+        if (IsLocal(receiver))
+        {
+            Deliver(sender, receiver, ppdu, txPower);
+            continue;
+        }
+
+        // the signal is only sent to the ranks whose receivers would process it
+        auto receiverMobility = GetReceiverMobility(i);
+        NS_ASSERT_MSG(receiverMobility, "No position for the remote receiver");
+        const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
+        const auto txWidth = ppdu->GetTxChannelWidth();
+        if (rxPower + receiver->GetRxGain() <
+            receiver->GetRxSensitivity() + RatioToDb(txWidth / MHz_u{20}))
+        {
+            continue;
+        }
+        const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+        if (delay < GetLookahead())
+        {
+            NS_FATAL_ERROR("Nodes " << sender->GetDevice()->GetNode()->GetId() << " and "
+                                    << receiver->GetDevice()->GetNode()->GetId()
+                                    << " of different ranks are closer ("
+                                    << senderMobility->GetDistanceFrom(receiverMobility)
+                                    << "m) than the lookahead allows");
+        }
+        SendToRank(i, sender, ppdu, rxPower, delay);
+    }
+}
+
+void
+DistributedYansWifiChannel::SendToRank(uint32_t i,
+                                       Ptr<YansWifiPhy> sender,
+                                       Ptr<const WifiPpdu> ppdu,
+                                       dBm_u rxPower,
+                                       Time delay) const
+{
+    NS_LOG_FUNCTION(this << i << sender << ppdu << rxPower << delay);
+    auto device = m_phyList[i]->GetDevice();
+    MpiInterface::SendPacket(SerializeSignal(i, sender, ppdu, rxPower),
+                             Simulator::Now() + delay,
+                             device->GetNode()->GetId(),
+                             device->GetIfIndex());
+}
+
+Ptr<Packet>
+DistributedYansWifiChannel::SerializeSignal(uint32_t i,
+                                            Ptr<YansWifiPhy> sender,
+                                            Ptr<const WifiPpdu> ppdu,
+                                            dBm_u rxPower) const
+{
+    NS_LOG_FUNCTION(this << i << sender << ppdu << rxPower);
+    const auto& txVector = ppdu->GetTxVector();
+    NS_ABORT_MSG_IF(txVector.IsMu(), "Multi-user PPDUs cannot be sent to another rank");
+    auto psdu = ppdu->GetPsdu();
+    const auto mode = txVector.GetMode().GetUniqueName();
+
+    // channel id, type, receiver, RX power, channel number and duration
+    uint32_t size = 4 + 1 + 4 + 8 + 1 + 8;
+    // TXVECTOR
+    size += 1 + mode.size() + 1 + 1 + 8 + 3 + 8 + 3 + 1 + 2 + 1;
+    // single MPDU flag, number of MPDUs, and the MPDUs
+    size += 1 + 2;
+    for (const auto& mpdu : *psdu)
+    {
+        size += mpdu->GetHeader().GetSerializedSize() + 4 + mpdu->GetPacket()->GetSerializedSize();
+    }
+
+    Buffer buffer;
+    buffer.AddAtStart(size);
+    auto it = buffer.Begin();
+    it.WriteHtonU32(GetId());
+    it.WriteU8(SIGNAL);
+    it.WriteHtonU32(i);
+    WriteDouble(it, rxPower);
+    it.WriteU8(sender->GetChannelNumber());
+    it.WriteHtonU64(ppdu->GetTxDuration().GetTimeStep());
+
+    it.WriteU8(mode.size());
+    it.Write(reinterpret_cast<const uint8_t*>(mode.data()), mode.size());
+    it.WriteU8(txVector.GetTxPowerLevel());
+    it.WriteU8(txVector.GetPreambleType());
+    it.WriteHtonU64(txVector.GetGuardInterval().GetTimeStep());
+    it.WriteU8(txVector.GetNTx());
+    it.WriteU8(txVector.GetNss());
+    it.WriteU8(txVector.GetNess());
+    WriteDouble(it, txVector.GetChannelWidth());
+    it.WriteU8(txVector.IsAggregation());
+    it.WriteU8(txVector.IsStbc());
+    it.WriteU8(txVector.IsLdpc());
+    it.WriteU8(txVector.GetBssColor());
+    it.WriteHtonU16(txVector.GetLength());
+    it.WriteU8(txVector.IsTriggerResponding());
+
+    it.WriteU8(psdu->IsSingle());
+    it.WriteHtonU16(psdu->GetNMpdus());
+    for (const auto& mpdu : *psdu)
+    {
+        mpdu->GetHeader().Serialize(it);
+        it.Next(mpdu->GetHeader().GetSerializedSize());
+        auto packet = mpdu->GetPacket();
+        uint32_t packetSize = packet->GetSerializedSize();
+        std::vector<uint8_t> bytes(packetSize);
+        packet->Serialize(bytes.data(), packetSize);
+        it.WriteHtonU32(packetSize);
+        it.Write(bytes.data(), packetSize);
+    }
+
+    // the message is itself serialized, with its metadata, by MpiInterface::SendPacket
+    auto message = Create<Packet>(buffer.PeekData(), size);
+    const auto messageSize = message->GetSerializedSize() + MPI_MSG_HEADER_SIZE;
+    NS_ABORT_MSG_IF(messageSize > MAX_MPI_MSG_SIZE,
+                    "PPDU too large (" << messageSize << " bytes) to be sent to another rank; "
+                                       << "A-MPDU aggregation should be reduced");
+    return message;
+}
+
+void
+DistributedYansWifiChannel::CourseChanged(uint32_t i, Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << i << mobility);
+    auto message = SerializeCourse(i, mobility);
+    for (const auto& [rank, device] : m_ranks)
+    {
+        MpiInterface::SendPacket(message,
+                                 Simulator::Now() + GetLookahead(),
+                                 device.first,
+                                 device.second);
+    }
+}
+
+Ptr<Packet>
+DistributedYansWifiChannel::SerializeCourse(uint32_t i, Ptr<const MobilityModel> mobility) const
+{
+    NS_LOG_FUNCTION(this << i << mobility);
+    const auto position = mobility->GetPosition();
+    const auto velocity = mobility->GetVelocity();
+    const uint32_t size = 4 + 1 + 4 + 6 * 8;
+    Buffer buffer;
+    buffer.AddAtStart(size);
+    auto it = buffer.Begin();
+    it.WriteHtonU32(GetId());
+    it.WriteU8(COURSE);
+    it.WriteHtonU32(i);
+    for (double value : {position.x, position.y, position.z, velocity.x, velocity.y, velocity.z})
+    {
+        WriteDouble(it, value);
+    }
+    return Create<Packet>(buffer.PeekData(), size);
+}
+
+void
+DistributedYansWifiChannel::ReceiveFromRank(Ptr<Packet> message)
+{
+    NS_LOG_FUNCTION(message);
+    Buffer buffer;
+    buffer.AddAtStart(message->GetSize());
+    std::vector<uint8_t> bytes(message->GetSize());
+    message->CopyData(bytes.data(), bytes.size());
+    auto it = buffer.Begin();
+    it.Write(bytes.data(), bytes.size());
+
+    it = buffer.Begin();
+    auto channel = DynamicCast<DistributedYansWifiChannel>(
+        ChannelList::GetChannel(it.ReadNtohU32()));
+    NS_ASSERT_MSG(channel, "Message for a channel which is not distributed");
+    if (it.ReadU8() == SIGNAL)
+    {
+        channel->ReceiveSignal(it);
+    }
+    else
+    {
+        channel->ReceiveCourse(it);
+    }
+}
+
+void
+DistributedYansWifiChannel::ReceiveSignal(Buffer::Iterator it)
+{
+    NS_LOG_FUNCTION(this);
+    auto phy = m_phyList.at(it.ReadNtohU32());
+    const dBm_u rxPower{ReadDouble(it)};
+    uint8_t channelNumber = it.ReadU8();
+    Time duration = TimeStep(it.ReadNtohU64());
+
+    std::string name(it.ReadU8(), '\0');
+    it.Read(reinterpret_cast<uint8_t*>(name.data()), name.size());
+    WifiMode mode;
+    std::istringstream(name) >> mode;
+    uint8_t powerLevel = it.ReadU8();
+    auto preamble = static_cast<WifiPreamble>(it.ReadU8());
+    Time guardInterval = TimeStep(it.ReadNtohU64());
+    uint8_t nTx = it.ReadU8();
+    uint8_t nss = it.ReadU8();
+    uint8_t ness = it.ReadU8();
+    MHz_u channelWidth{ReadDouble(it)};
+    bool aggregation = it.ReadU8();
+    bool stbc = it.ReadU8();
+    bool ldpc = it.ReadU8();
+    uint8_t bssColor = it.ReadU8();
+    uint16_t length = it.ReadNtohU16();
+    bool triggerResponding = it.ReadU8();
+    WifiTxVector txVector(mode,
+                          powerLevel,
+                          preamble,
+                          guardInterval,
+                          nTx,
+                          nss,
+                          ness,
+                          channelWidth,
+                          aggregation,
+                          stbc,
+                          ldpc,
+                          bssColor,
+                          length,
+                          triggerResponding);
+
+    bool isSingle = it.ReadU8();
+    std::vector<Ptr<WifiMpdu>> mpdus(it.ReadNtohU16());
+    for (auto& mpdu : mpdus)
+    {
+        WifiMacHeader header;
+        it.Next(header.Deserialize(it));
+        std::vector<uint8_t> bytes(it.ReadNtohU32());
+        it.Read(bytes.data(), bytes.size());
+        mpdu = Create<WifiMpdu>(Create<Packet>(bytes.data(), bytes.size(), true), header);
+    }
+
+    // For now don't account for inter channel interference nor channel bonding
+    if (phy->GetChannelNumber() != channelNumber)
+    {
+        return;
+    }
+    auto psdu = mpdus.size() == 1 ? Create<WifiPsdu>(mpdus.front(), isSingle)
+                                  : Create<WifiPsdu>(mpdus);
+    auto ppdu = phy->GetPhyEntity(txVector.GetModulationClass())
+                    ->BuildPpdu(WifiConstPsduMap{{SU_STA_ID, psdu}}, txVector, duration);
+    Receive(phy, ppdu, rxPower);
+}
+
+void
+DistributedYansWifiChannel::ReceiveCourse(Buffer::Iterator it)
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t i = it.ReadNtohU32();
+    Vector position;
+    position.x = ReadDouble(it);
+    position.y = ReadDouble(it);
+    position.z = ReadDouble(it);
+    Vector velocity;
+    velocity.x = ReadDouble(it);
+    velocity.y = ReadDouble(it);
+    velocity.z = ReadDouble(it);
+    if (i >= m_proxies.size() || !m_proxies[i])
+    {
+        return;
+    }
+    // the course was sent one lookahead ago
+    const double elapsed = GetLookahead().GetSeconds();
+    m_proxies[i]->SetPosition(Vector(position.x + velocity.x * elapsed,
+                                     position.y + velocity.y * elapsed,
+                                     position.z + velocity.z * elapsed));
+    m_proxies[i]->SetVelocity(velocity);
+}
+
+} // namespace ns3
@@ -0,0 +1,206 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef DISTRIBUTED_YANS_WIFI_CHANNEL_H
+#define DISTRIBUTED_YANS_WIFI_CHANNEL_H
+
+#include "yans-wifi-channel.h"
+
+#include "ns3/buffer.h"
+#include "ns3/nstime.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+class ConstantVelocityMobilityModel;
+
+/**
+ * @brief A YansWifiChannel whose PHYs are spread over several MPI ranks.
+ * @ingroup wifi
+ *
+ * As in any distributed simulation, every rank builds the whole topology,
+ * and each node is simulated by the rank given by its SystemId.  The
+ * channel only accepts the transmissions of the PHYs of the local nodes:
+ * the local receivers are scheduled as by YansWifiChannel, and the
+ * transmission is replicated, through MpiInterface, to the ranks owning a
+ * receiver which gets the signal above its RX sensitivity.  The receiving
+ * rank rebuilds the PPDU on the receiving PHY and delivers it at the
+ * arrival time computed by the sender.  Only single-user PPDUs can be sent
+ * to another rank, and a PPDU must fit in an MPI message, which in practice
+ * means that A-MPDU aggregation should be disabled or kept small.
+ *
+ * The lookahead of the channel, used by the distributed simulator
+ * implementations, is the propagation delay over the minimum distance
+ * between the nodes of different ranks, so the channel requires a
+ * ConstantSpeedPropagationDelayModel.  That distance is given by the
+ * MinimumDistance attribute, when the scenario keeps the nodes of each
+ * rank apart (spatial decomposition), or else measured between the
+ * positions of the nodes when the simulation starts.  A transmission to a
+ * remote receiver closer than that distance would violate the lookahead,
+ * and aborts the simulation.
+ *
+ * By default, the positions of the receivers of the other ranks are read
+ * from their local twins, which is exact when the mobility of the nodes is
+ * deterministic, as with trace-driven vehicular mobility.  With the
+ * ExchangeMobility attribute, each rank instead sends the position and
+ * velocity of its nodes to the other ranks when their course changes, and
+ * the receivers of the other ranks are located by extrapolating the last
+ * course received.  Those updates are only delivered after the lookahead,
+ * during which the remote course is still extrapolated from the previous
+ * update.
+ *
+ * YansWifiChannelHelper creates this channel instead of a YansWifiChannel
+ * when MPI is enabled with more than one rank.
+ */
+class DistributedYansWifiChannel : public YansWifiChannel
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    DistributedYansWifiChannel();
+    ~DistributedYansWifiChannel() override;
+
+    /**
+     * Adds the given YansWifiPhy to the PHY list.  When MPI is enabled,
+     * the device of the PHY must be set, as an MpiReceiver is aggregated
+     * to it to receive the transmissions of the other ranks.
+     *
+     * @param phy the YansWifiPhy to be added to the PHY list
+     */
+    void Add(Ptr<YansWifiPhy> phy) override;
+
+    void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const override;
+
+    /**
+     * Get the lookahead of the channel: the propagation delay over the
+     * minimum distance between two nodes of different ranks.  When it is
+     * not set by the MinimumDistance attribute, that distance is measured
+     * at the first call.
+     *
+     * @return the lookahead
+     */
+    Time GetLookahead() const;
+
+  protected:
+    /**
+     * Serialize a PPDU for a PHY simulated by another rank.
+     *
+     * @param i the index of the receiving PHY in the PHY list
+     * @param sender the transmitting PHY
+     * @param ppdu the PPDU
+     * @param rxPower the RX power, before the antenna gain of the receiver
+     * @return the message, which ReceiveFromRank() delivers to the PHY
+     */
+    Ptr<Packet> SerializeSignal(uint32_t i,
+                                Ptr<YansWifiPhy> sender,
+                                Ptr<const WifiPpdu> ppdu,
+                                dBm_u rxPower) const;
+
+    /**
+     * Serialize the course of a local PHY for the other ranks.
+     *
+     * @param i the index of the PHY in the PHY list
+     * @param mobility the mobility model of the PHY
+     * @return the message, which ReceiveFromRank() applies to the proxy of the PHY
+     */
+    Ptr<Packet> SerializeCourse(uint32_t i, Ptr<const MobilityModel> mobility) const;
+
+    /**
+     * Receive a message of another rank: the callback of the MpiReceiver
+     * aggregated to the devices of the local PHYs.
+     *
+     * @param message the message
+     */
+    static void ReceiveFromRank(Ptr<Packet> message);
+
+    /**
+     * @param i the index of a PHY in the PHY list
+     * @return the mobility model which locates the PHY on this rank
+     */
+    Ptr<MobilityModel> GetReceiverMobility(uint32_t i) const;
+
+  private:
+    void DoDispose() override;
+
+    /** Type of the messages exchanged between ranks. */
+    enum MessageType : uint8_t
+    {
+        SIGNAL = 0, //!< A PPDU to deliver to a receiver
+        COURSE = 1, //!< The course of a PHY of the sender rank
+    };
+
+    /**
+     * @param phy a PHY of the channel
+     * @return true if the node of the PHY is simulated by this rank
+     */
+    static bool IsLocal(Ptr<YansWifiPhy> phy);
+
+    /**
+     * Create the mobility proxies of the remote PHYs and listen to the
+     * course changes of the local ones, when ExchangeMobility is set.
+     */
+    void SetUpMobility();
+
+    /**
+     * Send the PPDU to a PHY simulated by another rank.
+     *
+     * @param i the index of the receiving PHY in the PHY list
+     * @param sender the transmitting PHY
+     * @param ppdu the PPDU
+     * @param rxPower the RX power, before the antenna gain of the receiver
+     * @param delay the propagation delay
+     */
+    void SendToRank(uint32_t i,
+                    Ptr<YansWifiPhy> sender,
+                    Ptr<const WifiPpdu> ppdu,
+                    dBm_u rxPower,
+                    Time delay) const;
+
+    /**
+     * Send the new course of a local PHY to the other ranks.
+     *
+     * @param i the index of the PHY in the PHY list
+     * @param mobility the mobility model of the PHY
+     */
+    void CourseChanged(uint32_t i, Ptr<const MobilityModel> mobility);
+
+    /**
+     * Handle a PPDU sent by another rank.
+     *
+     * @param i the message, past its channel id and type
+     */
+    void ReceiveSignal(Buffer::Iterator i);
+
+    /**
+     * Handle a course sent by another rank.
+     *
+     * @param i the message, past its channel id and type
+     */
+    void ReceiveCourse(Buffer::Iterator i);
+
+    double m_minimumDistance; //!< Minimum distance between nodes of different ranks, in meters
+    bool m_exchangeMobility;  //!< Whether the ranks exchange the course of their nodes
+    bool m_mobilityIsSet;     //!< Whether SetUpMobility has been scheduled
+
+    mutable Time m_lookahead;      //!< The lookahead, once computed
+    mutable bool m_lookaheadIsSet; //!< Whether the lookahead has been computed
+
+    /// A device of the channel on each other rank, as (node id, interface index)
+    std::map<uint32_t, std::pair<uint32_t, uint32_t>> m_ranks;
+    /// The last course received for each remote PHY, by index in the PHY list
+    std::vector<Ptr<ConstantVelocityMobilityModel>> m_proxies;
+};
+
+} // namespace ns3
+
+#endif /* DISTRIBUTED_YANS_WIFI_CHANNEL_H */
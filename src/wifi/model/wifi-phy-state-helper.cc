@@ -283,7 +283,7 @@ WifiPhyStateHelper::LogPreviousIdleAndCcaBusyStates()
         m_endCcaBusy = now;
         const auto ccaStart =
             std::max({m_endRx, m_endTx, m_startCcaBusy, m_endSwitching, m_endSleep, m_endOff});
-        m_stateLogger(ccaStart, now - ccaStart, WifiPhyState::CCA_BUSY);
+        NS_TRACE(m_stateLogger, ccaStart, now - ccaStart, WifiPhyState::CCA_BUSY);
     }
     else if (state == WifiPhyState::IDLE)
     {
@@ -298,12 +298,12 @@ WifiPhyStateHelper::LogPreviousIdleAndCcaBusyStates()
             if (const auto ccaBusyDuration = idleStart - ccaBusyStart;
                 ccaBusyDuration.IsStrictlyPositive())
             {
-                m_stateLogger(ccaBusyStart, ccaBusyDuration, WifiPhyState::CCA_BUSY);
+                NS_TRACE(m_stateLogger, ccaBusyStart, ccaBusyDuration, WifiPhyState::CCA_BUSY);
             }
         }
         if (const auto idleDuration = now - idleStart; idleDuration.IsStrictlyPositive())
         {
-            m_stateLogger(idleStart, idleDuration, WifiPhyState::IDLE);
+            NS_TRACE(m_stateLogger, idleStart, idleDuration, WifiPhyState::IDLE);
         }
     }
 }
@@ -332,7 +332,7 @@ WifiPhyStateHelper::SwitchToTx(Time txDuration,
         /* The packet which is being received as well
          * as its endRx event are cancelled by the caller.
          */
-        m_stateLogger(m_startRx, now - m_startRx, WifiPhyState::RX);
+        NS_TRACE(m_stateLogger, m_startRx, now - m_startRx, WifiPhyState::RX);
         m_endRx = now;
         break;
     case WifiPhyState::CCA_BUSY:
@@ -344,7 +344,7 @@ WifiPhyStateHelper::SwitchToTx(Time txDuration,
         NS_FATAL_ERROR("Invalid WifiPhy state.");
         break;
     }
-    m_stateLogger(now, txDuration, WifiPhyState::TX);
+    NS_TRACE(m_stateLogger, now, txDuration, WifiPhyState::TX);
     m_previousStateChangeTime = now;
     m_endTx = now + txDuration;
     m_startTx = now;
@@ -386,7 +386,7 @@ WifiPhyStateHelper::SwitchToChannelSwitching(Time switchingDuration)
         /* The packet which is being received as well
          * as its endRx event are cancelled by the caller.
          */
-        m_stateLogger(m_startRx, now - m_startRx, WifiPhyState::RX);
+        NS_TRACE(m_stateLogger, m_startRx, now - m_startRx, WifiPhyState::RX);
         m_endRx = now;
         break;
     case WifiPhyState::CCA_BUSY:
@@ -403,7 +403,7 @@ WifiPhyStateHelper::SwitchToChannelSwitching(Time switchingDuration)
     }
 
     m_endCcaBusy = std::min(now, m_endCcaBusy);
-    m_stateLogger(now, switchingDuration, WifiPhyState::SWITCHING);
+    NS_TRACE(m_stateLogger, now, switchingDuration, WifiPhyState::SWITCHING);
     m_previousStateChangeTime = now;
     m_startSwitching = now;
     m_endSwitching = now + switchingDuration;
@@ -435,13 +435,11 @@ WifiPhyStateHelper::NotifyRxPsduSucceeded(Ptr<const WifiPsdu> psdu,
                                 return v;
                             })); // returns true if all true
     NS_ASSERT(!statusPerMpdu.empty());
-    if (!m_rxOkTrace.IsEmpty())
-    {
-        m_rxOkTrace(psdu->GetPacket(),
-                    rxSignalInfo.snr,
-                    txVector.GetMode(staId),
-                    txVector.GetPreambleType());
-    }
+    NS_TRACE(m_rxOkTrace,
+             psdu->GetPacket(),
+             rxSignalInfo.snr,
+             txVector.GetMode(staId),
+             txVector.GetPreambleType());
     if (!m_rxOkCallback.IsNull())
     {
         m_rxOkCallback(psdu, rxSignalInfo, txVector, statusPerMpdu);
@@ -452,10 +450,7 @@ void
 WifiPhyStateHelper::NotifyRxPsduFailed(Ptr<const WifiPsdu> psdu, double snr)
 {
     NS_LOG_FUNCTION(this << *psdu << snr);
-    if (!m_rxErrorTrace.IsEmpty())
-    {
-        m_rxErrorTrace(psdu->GetPacket(), snr);
-    }
+    NS_TRACE(m_rxErrorTrace, psdu->GetPacket(), snr);
     if (!m_rxErrorCallback.IsNull())
     {
         m_rxErrorCallback(psdu);
@@ -469,7 +464,7 @@ WifiPhyStateHelper::NotifyRxPpduOutcome(Ptr<const WifiPpdu> ppdu,
                                         uint16_t staId,
                                         const std::vector<bool>& statusPerMpdu)
 {
-    m_rxOutcomeTrace(ppdu, rxSignalInfo, txVector, statusPerMpdu);
+    NS_TRACE(m_rxOutcomeTrace, ppdu, rxSignalInfo, txVector, statusPerMpdu);
 }
 
 void
@@ -495,7 +490,7 @@ WifiPhyStateHelper::DoSwitchFromRx()
 {
     NS_LOG_FUNCTION(this);
     Time now = Simulator::Now();
-    m_stateLogger(m_startRx, now - m_startRx, WifiPhyState::RX);
+    NS_TRACE(m_stateLogger, m_startRx, now - m_startRx, WifiPhyState::RX);
     m_previousStateChangeTime = now;
     m_endRx = Simulator::Now();
     NS_ASSERT(IsStateIdle() || IsStateCcaBusy());
@@ -561,7 +556,7 @@ WifiPhyStateHelper::SwitchFromSleep()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(IsStateSleep());
     Time now = Simulator::Now();
-    m_stateLogger(m_startSleep, now - m_startSleep, WifiPhyState::SLEEP);
+    NS_TRACE(m_stateLogger, m_startSleep, now - m_startSleep, WifiPhyState::SLEEP);
     m_previousStateChangeTime = now;
     m_sleeping = false;
     m_endSleep = now;
@@ -602,14 +597,14 @@ WifiPhyStateHelper::SwitchToOff()
         /* The packet which is being received as well
          * as its endRx event are cancelled by the caller.
          */
-        m_stateLogger(m_startRx, now - m_startRx, WifiPhyState::RX);
+        NS_TRACE(m_stateLogger, m_startRx, now - m_startRx, WifiPhyState::RX);
         m_endRx = now;
         break;
     case WifiPhyState::TX:
         /* The packet which is being transmitted as well
          * as its endTx event are cancelled by the caller.
          */
-        m_stateLogger(m_startTx, now - m_startTx, WifiPhyState::TX);
+        NS_TRACE(m_stateLogger, m_startTx, now - m_startTx, WifiPhyState::TX);
         m_endTx = now;
         break;
     case WifiPhyState::IDLE:
@@ -1689,7 +1689,7 @@ void
 WifiPhy::NotifyRxPpduDrop(Ptr<const WifiPpdu> ppdu, WifiPhyRxfailureReason reason)
 {
     NotifyRxDrop(GetAddressedPsduInPpdu(ppdu), reason);
-    m_phyRxPpduDropTrace(ppdu, reason);
+    NS_TRACE(m_phyRxPpduDropTrace, ppdu, reason);
 }
 
 void
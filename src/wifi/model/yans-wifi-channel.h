@@ -53,7 +53,7 @@ class YansWifiChannel : public Channel
      *
      * @param phy the YansWifiPhy to be added to the PHY list
      */
-    void Add(Ptr<YansWifiPhy> phy);
+    virtual void Add(Ptr<YansWifiPhy> phy);
 
     /**
      * @param loss the new propagation loss model.
@@ -74,7 +74,7 @@ class YansWifiChannel : public Channel
      * attempts to deliver the PPDU to all other YansWifiPhy objects
      * on the channel (except for the sender).
      */
-    void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const;
+    virtual void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const;
 
     /**
      * Assign a fixed random variable stream number to the random variables
@@ -87,12 +87,26 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
-  private:
+  protected:
     /**
      * A vector of pointers to YansWifiPhy.
      */
     typedef std::vector<Ptr<YansWifiPhy>> PhyList;
 
+    /**
+     * Schedule the reception of a PPDU by a PHY, if it is on the channel
+     * of the sender.
+     *
+     * @param sender the PHY object from which the packet is originating
+     * @param receiver the PHY to which the packet is destined
+     * @param ppdu the PPDU being sent
+     * @param txPower the TX power associated to the packet being sent
+     */
+    void Deliver(Ptr<YansWifiPhy> sender,
+                 Ptr<YansWifiPhy> receiver,
+                 Ptr<const WifiPpdu> ppdu,
+                 dBm_u txPower) const;
+
     /**
      * This method is scheduled by Send for each associated YansWifiPhy.
      * The method then calls the corresponding YansWifiPhy that the first
@@ -0,0 +1,369 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/distributed-yans-wifi-channel.h"
+#include "ns3/double.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/yans-wifi-phy.h"
+
+#include <numeric>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check the lookahead of a DistributedYansWifiChannel, and that it
+ * delivers the transmissions between local nodes as a YansWifiChannel.
+ *
+ * Two local nodes, 10 meters apart, exchange packets; a node of another
+ * rank is 30 km away, out of range, so no message has to be sent to it
+ * and MPI needs not be enabled.
+ */
+class DistributedYansWifiChannelTest : public TestCase
+{
+  public:
+    DistributedYansWifiChannelTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the scenario, and get the lookahead of the channel when it starts,
+     * as the distributed simulator implementations do.
+     *
+     * @param channel the channel, without its propagation models
+     * @return the number of packets received
+     */
+    uint32_t RunScenario(Ptr<YansWifiChannel> channel);
+
+    /**
+     * Callback invoked when a packet is received by the server application.
+     *
+     * @param p the packet
+     * @param addr the address
+     */
+    void AppRx(Ptr<const Packet> p, const Address& addr);
+
+    uint32_t m_received;   //!< Number of packets received
+    TimeValue m_lookahead; //!< Lookahead of the channel when the simulation starts
+};
+
+DistributedYansWifiChannelTest::DistributedYansWifiChannelTest()
+    : TestCase("Check the distributed YANS wifi channel on a single rank"),
+      m_received(0)
+{
+}
+
+void
+DistributedYansWifiChannelTest::AppRx(Ptr<const Packet> p, const Address& addr)
+{
+    m_received++;
+}
+
+uint32_t
+DistributedYansWifiChannelTest::RunScenario(Ptr<YansWifiChannel> channel)
+{
+    m_received = 0;
+    auto delay = CreateObject<ConstantSpeedPropagationDelayModel>();
+    delay->SetSpeed(3e8);
+    channel->SetPropagationDelayModel(delay);
+    channel->SetPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+
+    NodeContainer nodes(2);
+    nodes.Add(CreateObject<Node>(1));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    auto devices = wifi.Install(phy, mac, nodes);
+
+    MobilityHelper mobility;
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(10.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(30010.0, 0.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(nodes);
+
+    PacketSocketAddress socket;
+    socket.SetSingleDevice(devices.Get(0)->GetIfIndex());
+    socket.SetPhysicalAddress(devices.Get(1)->GetAddress());
+    socket.SetProtocol(1);
+
+    auto client = CreateObject<PacketSocketClient>();
+    client->SetAttribute("PacketSize", UintegerValue(1000));
+    client->SetAttribute("MaxPackets", UintegerValue(10));
+    client->SetAttribute("Interval", TimeValue(MilliSeconds(10)));
+    client->SetRemote(socket);
+    nodes.Get(0)->AddApplication(client);
+    client->SetStartTime(MilliSeconds(100));
+
+    auto server = CreateObject<PacketSocketServer>();
+    server->SetLocal(socket);
+    server->TraceConnectWithoutContext(
+        "Rx",
+        MakeCallback(&DistributedYansWifiChannelTest::AppRx, this));
+    nodes.Get(1)->AddApplication(server);
+
+    channel->GetAttributeFailSafe("Lookahead", m_lookahead);
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+    return m_received;
+}
+
+void
+DistributedYansWifiChannelTest::DoRun()
+{
+    uint32_t reference = RunScenario(CreateObject<YansWifiChannel>());
+    NS_TEST_ASSERT_MSG_EQ(reference, 10, "Packets lost on the YANS channel");
+
+    auto channel = CreateObject<DistributedYansWifiChannel>();
+    NS_TEST_EXPECT_MSG_EQ(RunScenario(channel), reference, "Different receptions");
+    // 30 km at 3e8 m/s
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_lookahead.Get().GetNanoSeconds(),
+                              100000,
+                              1,
+                              "Wrong lookahead measured between the nodes");
+
+    channel = CreateObject<DistributedYansWifiChannel>();
+    channel->SetAttribute("MinimumDistance", DoubleValue(60000));
+    NS_TEST_EXPECT_MSG_EQ(RunScenario(channel), reference, "Different receptions");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_lookahead.Get().GetNanoSeconds(),
+                              200000,
+                              1,
+                              "Wrong lookahead from the minimum distance");
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief A DistributedYansWifiChannel giving access to its messages.
+ */
+class DistributedYansWifiChannelTester : public DistributedYansWifiChannel
+{
+  public:
+    using DistributedYansWifiChannel::GetReceiverMobility;
+    using DistributedYansWifiChannel::ReceiveFromRank;
+    using DistributedYansWifiChannel::SerializeCourse;
+    using DistributedYansWifiChannel::SerializeSignal;
+};
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Check that the messages of a DistributedYansWifiChannel are
+ * rebuilt as they were sent, on a single process: a PPDU serialized for
+ * another rank reaches the receiving PHY with the same TXVECTOR, PSDU and
+ * RX power, and a course received from another rank moves the proxy of
+ * the remote node.
+ */
+class DistributedYansWifiChannelMessageTest : public TestCase
+{
+  public:
+    DistributedYansWifiChannelMessageTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback invoked when a signal arrives at the receiving PHY.
+     *
+     * @param ppdu the PPDU
+     * @param rxPowerDbm the RX power, in dBm
+     * @param duration the duration of the PPDU
+     */
+    void SignalArrival(Ptr<const WifiPpdu> ppdu, double rxPowerDbm, Time duration);
+
+    Ptr<const WifiPpdu> m_ppdu; //!< The PPDU rebuilt on the receiving PHY
+    double m_rxPowerDbm;        //!< The RX power of the rebuilt PPDU
+};
+
+DistributedYansWifiChannelMessageTest::DistributedYansWifiChannelMessageTest()
+    : TestCase("Check the messages of the distributed YANS wifi channel"),
+      m_rxPowerDbm(0)
+{
+}
+
+void
+DistributedYansWifiChannelMessageTest::SignalArrival(Ptr<const WifiPpdu> ppdu,
+                                                     double rxPowerDbm,
+                                                     Time duration)
+{
+    m_ppdu = ppdu;
+    m_rxPowerDbm = rxPowerDbm;
+}
+
+void
+DistributedYansWifiChannelMessageTest::DoRun()
+{
+    auto channel = CreateObject<DistributedYansWifiChannelTester>();
+    channel->SetAttribute("ExchangeMobility", BooleanValue(true));
+    // 1 ms at 3e8 m/s
+    channel->SetAttribute("MinimumDistance", DoubleValue(300000));
+    auto delay = CreateObject<ConstantSpeedPropagationDelayModel>();
+    delay->SetSpeed(3e8);
+    channel->SetPropagationDelayModel(delay);
+    channel->SetPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+
+    // node 2 belongs to another rank, and is located by a proxy
+    NodeContainer nodes(2);
+    nodes.Add(CreateObject<Node>(1));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    auto devices = wifi.Install(phy, mac, nodes);
+
+    MobilityHelper mobility;
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(10.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(300010.0, 0.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+
+    auto sender = DynamicCast<YansWifiPhy>(DynamicCast<WifiNetDevice>(devices.Get(0))->GetPhy());
+    auto receiver =
+        DynamicCast<YansWifiPhy>(DynamicCast<WifiNetDevice>(devices.Get(1))->GetPhy());
+    receiver->TraceConnectWithoutContext(
+        "SignalArrival",
+        MakeCallback(&DistributedYansWifiChannelMessageTest::SignalArrival, this));
+
+    WifiMacHeader header(WIFI_MAC_DATA);
+    header.SetAddr1(Mac48Address::ConvertFrom(devices.Get(1)->GetAddress()));
+    header.SetAddr2(Mac48Address::ConvertFrom(devices.Get(0)->GetAddress()));
+    header.SetAddr3(Mac48Address::GetBroadcast());
+    header.SetSequenceNumber(123);
+    std::vector<uint8_t> payload(300);
+    std::iota(payload.begin(), payload.end(), 0);
+    auto psdu = Create<WifiPsdu>(Create<Packet>(payload.data(), payload.size()), header);
+    WifiTxVector txVector(OfdmPhy::GetOfdmRate12Mbps(),
+                          3,
+                          WIFI_PREAMBLE_LONG,
+                          NanoSeconds(800),
+                          1,
+                          1,
+                          0,
+                          MHz_u{20},
+                          false);
+    const auto duration = WifiPhy::CalculateTxDuration(psdu, txVector, sender->GetPhyBand());
+    auto ppdu = sender->GetPhyEntity(WIFI_MOD_CLASS_OFDM)
+                    ->BuildPpdu(WifiConstPsduMap{{SU_STA_ID, psdu}}, txVector, duration);
+    const dBm_u rxPower{-62.5};
+    Simulator::Schedule(MilliSeconds(1), [=]() {
+        DistributedYansWifiChannelTester::ReceiveFromRank(
+            channel->SerializeSignal(1, sender, ppdu, rxPower));
+    });
+
+    // the course of node 2, received one lookahead after it was sent
+    auto course = CreateObject<ConstantVelocityMobilityModel>();
+    course->SetPosition(Vector(300100.0, 5.0, 0.0));
+    course->SetVelocity(Vector(20.0, -1.0, 0.0));
+    Vector proxyPosition;
+    Vector proxyVelocity;
+    Simulator::Schedule(MilliSeconds(2), [&]() {
+        DistributedYansWifiChannelTester::ReceiveFromRank(channel->SerializeCourse(2, course));
+        proxyPosition = channel->GetReceiverMobility(2)->GetPosition();
+        proxyVelocity = channel->GetReceiverMobility(2)->GetVelocity();
+    });
+
+    Simulator::Stop(MilliSeconds(3));
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_NE(m_ppdu, nullptr, "The PPDU did not reach the receiving PHY");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_rxPowerDbm,
+                              rxPower + receiver->GetRxGain(),
+                              1e-9,
+                              "Wrong RX power");
+    NS_TEST_EXPECT_MSG_EQ(m_ppdu->GetTxDuration(), duration, "Wrong duration");
+    const auto& rxVector = m_ppdu->GetTxVector();
+    NS_TEST_EXPECT_MSG_EQ(rxVector.GetMode(), txVector.GetMode(), "Wrong mode");
+    NS_TEST_EXPECT_MSG_EQ(+rxVector.GetTxPowerLevel(), 3, "Wrong TX power level");
+    NS_TEST_EXPECT_MSG_EQ(rxVector.GetPreambleType(), WIFI_PREAMBLE_LONG, "Wrong preamble");
+    NS_TEST_EXPECT_MSG_EQ(rxVector.GetGuardInterval(), NanoSeconds(800), "Wrong guard interval");
+    NS_TEST_EXPECT_MSG_EQ(+rxVector.GetNss(), 1, "Wrong number of spatial streams");
+    NS_TEST_EXPECT_MSG_EQ(rxVector.GetChannelWidth(), MHz_u{20}, "Wrong channel width");
+    NS_TEST_EXPECT_MSG_EQ(rxVector.IsAggregation(), false, "Wrong aggregation flag");
+
+    auto rxPsdu = m_ppdu->GetPsdu();
+    NS_TEST_ASSERT_MSG_EQ(rxPsdu->GetNMpdus(), 1, "Wrong number of MPDUs");
+    const auto& rxHeader = rxPsdu->GetHeader(0);
+    NS_TEST_EXPECT_MSG_EQ(rxHeader.GetAddr1(), header.GetAddr1(), "Wrong receiver address");
+    NS_TEST_EXPECT_MSG_EQ(rxHeader.GetAddr2(), header.GetAddr2(), "Wrong transmitter address");
+    NS_TEST_EXPECT_MSG_EQ(rxHeader.GetSequenceNumber(), 123, "Wrong sequence number");
+    std::vector<uint8_t> rxPayload(rxPsdu->GetPayload(0)->GetSize());
+    rxPsdu->GetPayload(0)->CopyData(rxPayload.data(), rxPayload.size());
+    NS_TEST_EXPECT_MSG_EQ((rxPayload == payload), true, "Wrong payload");
+
+    NS_TEST_EXPECT_MSG_NE(channel->GetReceiverMobility(2),
+                          nodes.Get(2)->GetObject<MobilityModel>(),
+                          "The remote node is not located by a proxy");
+    // the course is extrapolated over the lookahead
+    NS_TEST_EXPECT_MSG_EQ_TOL(proxyPosition.x, 300100.02, 1e-6, "Wrong proxy position");
+    NS_TEST_EXPECT_MSG_EQ_TOL(proxyPosition.y, 4.999, 1e-6, "Wrong proxy position");
+    NS_TEST_EXPECT_MSG_EQ_TOL(proxyVelocity.x, 20.0, 1e-9, "Wrong proxy velocity");
+    NS_TEST_EXPECT_MSG_EQ_TOL(proxyVelocity.y, -1.0, 1e-9, "Wrong proxy velocity");
+
+    m_ppdu = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Distributed YANS wifi channel Test Suite
+ */
+class DistributedYansWifiChannelTestSuite : public TestSuite
+{
+  public:
+    DistributedYansWifiChannelTestSuite();
+};
+
+DistributedYansWifiChannelTestSuite::DistributedYansWifiChannelTestSuite()
+    : TestSuite("distributed-yans-wifi-channel", Type::UNIT)
+{
+    AddTestCase(new DistributedYansWifiChannelTest, TestCase::Duration::QUICK);
+    AddTestCase(new DistributedYansWifiChannelMessageTest, TestCase::Duration::QUICK);
+}
+
+static DistributedYansWifiChannelTestSuite
+    g_distributedYansWifiChannelTestSuite; ///< the test suite
@@ -0,0 +1,330 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/event-trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+/** Define if the heap usage can be sampled with mallinfo2(). */
+#define HAVE_MALLINFO2
+#endif
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/**
+ * Count the last level cache misses of this thread with a perf counter,
+ * when the platform and the permissions allow it.
+ */
+class CacheMissCounter
+{
+  public:
+    CacheMissCounter()
+    {
+#ifdef __linux__
+        perf_event_attr pe{};
+        pe.type = PERF_TYPE_HARDWARE;
+        pe.size = sizeof(pe);
+        pe.config = PERF_COUNT_HW_CACHE_MISSES;
+        pe.disabled = 1;
+        pe.exclude_kernel = 1;
+        pe.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(__NR_perf_event_open, &pe, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+#endif
+    }
+
+    /** @returns \c true if the counter could be opened. */
+    bool IsValid() const
+    {
+        return m_fd >= 0;
+    }
+
+    /** Reset and start counting. */
+    void Start()
+    {
+#ifdef __linux__
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /** @returns The number of misses since Start(). */
+    uint64_t Stop()
+    {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (m_fd >= 0)
+        {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_fd, &count, sizeof(count)) != sizeof(count))
+            {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+  private:
+    int m_fd{-1}; //!< The perf event file descriptor.
+};
+
+/**
+ * @returns The number of bytes allocated on the heap, or 0 if unknown.
+ */
+uint64_t
+HeapInUse()
+{
+#ifdef HAVE_MALLINFO2
+    struct mallinfo2 mi = mallinfo2();
+    return mi.uordblks + mi.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+/** Outcome of one replay. */
+struct ReplayResult
+{
+    double seconds{0};       //!< Wall clock time.
+    uint64_t ops{0};         //!< Number of Scheduler calls.
+    uint64_t mismatches{0};  //!< RUN records where the scheduler returned another timestamp.
+    uint64_t peakBytes{0};   //!< Peak heap growth, when sampled.
+    uint64_t cacheMisses{0}; //!< Cache misses, when counted.
+};
+
+/**
+ * Replay a trace against a new scheduler.
+ *
+ * @param [in] factory The scheduler factory.
+ * @param [in] records The decoded trace.
+ * @param [in] sampleEvery Sample the heap every this many records; 0 to not sample.
+ * @param [in] counter Cache miss counter, or nullptr.
+ * @returns The replay result.
+ */
+ReplayResult
+Replay(ObjectFactory factory,
+       const std::vector<EventTraceReader::Record>& records,
+       uint64_t sampleEvery,
+       CacheMissCounter* counter)
+{
+    ReplayResult result;
+    uint64_t baseline = sampleEvery ? HeapInUse() : 0;
+    Ptr<Scheduler> scheduler = factory.Create<Scheduler>();
+
+    if (counter)
+    {
+        counter->Start();
+    }
+    auto start = std::chrono::steady_clock::now();
+    uint64_t n = 0;
+    for (const auto& r : records)
+    {
+        switch (r.op)
+        {
+        case EventTraceOp::INSERT:
+            scheduler->Insert(Scheduler::Event{nullptr, {r.ts, r.uid, r.context}});
+            result.ops++;
+            break;
+        case EventTraceOp::RUN:
+            result.mismatches += scheduler->RemoveNext().key.m_ts != r.ts;
+            result.ops++;
+            break;
+        case EventTraceOp::REMOVE:
+            scheduler->Remove(Scheduler::Event{nullptr, {r.ts, r.uid, 0}});
+            result.ops++;
+            break;
+        case EventTraceOp::CANCEL:
+            // cancelled events stay in the event list
+            break;
+        }
+        if (sampleEvery && ++n % sampleEvery == 0)
+        {
+            uint64_t inUse = HeapInUse();
+            if (inUse > baseline)
+            {
+                result.peakBytes = std::max(result.peakBytes, inUse - baseline);
+            }
+        }
+    }
+    while (!scheduler->IsEmpty())
+    {
+        scheduler->RemoveNext();
+        result.ops++;
+    }
+    result.seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (counter)
+    {
+        result.cacheMisses = counter->Stop();
+    }
+    return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string trace;
+    std::string schedulers;
+    uint32_t runs = 3;
+    uint64_t sampleEvery = 1024;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Replay a recorded event trace against the Scheduler implementations.\n"
+              "\n"
+              "Record a trace by running any simulation with the attribute\n"
+              "  ns3::DefaultSimulatorImpl::EventTraceFile=<file>\n"
+              "set, for instance from the environment:\n"
+              "  NS_ATTRIBUTE_DEFAULT='ns3::DefaultSimulatorImpl::EventTraceFile=wifi.evtr'\n"
+              "\n"
+              "For each scheduler this reports the mean time per Scheduler call over\n"
+              "the timed runs, the cache misses per call (when perf counters are\n"
+              "available) and the peak heap growth (in a separate, sampled run).");
+    cmd.AddValue("trace", "event trace file", trace);
+    cmd.AddValue("schedulers",
+                 "comma separated scheduler TypeIds; all registered schedulers if empty",
+                 schedulers);
+    cmd.AddValue("runs", "number of timed runs per scheduler", runs);
+    cmd.AddValue("sample", "sample the heap every this many records, 0 to skip", sampleEvery);
+    cmd.Parse(argc, argv);
+
+    if (trace.empty())
+    {
+        NS_FATAL_ERROR("No --trace given");
+    }
+    if (runs == 0)
+    {
+        NS_FATAL_ERROR("--runs must be positive");
+    }
+
+    std::vector<std::string> names;
+    if (schedulers.empty())
+    {
+        for (uint16_t i = 0; i < TypeId::GetRegisteredN(); i++)
+        {
+            TypeId tid = TypeId::GetRegistered(i);
+            if (tid != Scheduler::GetTypeId() && tid.IsChildOf(Scheduler::GetTypeId()) &&
+                tid.HasConstructor())
+            {
+                names.push_back(tid.GetName());
+            }
+        }
+    }
+    else
+    {
+        names = SplitString(schedulers, ",");
+    }
+
+    auto records = EventTraceReader::ReadAll(trace);
+    uint64_t inserts = 0;
+    uint64_t removes = 0;
+    uint64_t cancels = 0;
+    for (const auto& r : records)
+    {
+        inserts += r.op == EventTraceOp::INSERT;
+        removes += r.op == EventTraceOp::REMOVE;
+        cancels += r.op == EventTraceOp::CANCEL;
+    }
+    LOG(cmd.GetName() << ": " << trace << ": " << records.size() << " records, " << inserts
+                      << " inserts, " << removes << " removes, " << cancels << " cancels");
+
+    CacheMissCounter counter;
+    if (!counter.IsValid())
+    {
+        LOG("Cache miss counter not available");
+    }
+
+    LOG(std::left << std::setw(28) << "scheduler" << std::right << std::setw(12) << "ns/op"
+                  << std::setw(12) << "stdev" << std::setw(14) << "misses/op" << std::setw(14)
+                  << "peak KiB" << std::setw(12) << "errors");
+    for (const auto& name : names)
+    {
+        ObjectFactory factory(name);
+        if (name == "ns3::ListScheduler" && records.size() > 1000000)
+        {
+            LOG(std::left << std::setw(28) << name << " skipped, too slow for this trace");
+            continue;
+        }
+
+        std::vector<double> nsPerOp;
+        uint64_t misses = 0;
+        uint64_t ops = 0;
+        uint64_t errors = 0;
+        for (uint32_t run = 0; run < runs; run++)
+        {
+            auto result = Replay(factory, records, 0, counter.IsValid() ? &counter : nullptr);
+            nsPerOp.push_back(result.seconds * 1e9 / result.ops);
+            misses += result.cacheMisses;
+            ops += result.ops;
+            errors += result.mismatches;
+        }
+        uint64_t peak = sampleEvery ? Replay(factory, records, sampleEvery, nullptr).peakBytes : 0;
+
+        double mean = 0;
+        for (auto v : nsPerOp)
+        {
+            mean += v;
+        }
+        mean /= nsPerOp.size();
+        double var = 0;
+        for (auto v : nsPerOp)
+        {
+            var += (v - mean) * (v - mean);
+        }
+        double stdev = nsPerOp.size() > 1 ? std::sqrt(var / (nsPerOp.size() - 1)) : 0;
+
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(12) << mean << std::setw(12) << stdev;
+        if (counter.IsValid())
+        {
+            std::cout << std::setw(14) << static_cast<double>(misses) / ops;
+        }
+        else
+        {
+            std::cout << std::setw(14) << "-";
+        }
+        if (sampleEvery && HeapInUse() != 0)
+        {
+            std::cout << std::setw(14) << peak / 1024;
+        }
+        else
+        {
+            std::cout << std::setw(14) << "-";
+        }
+        std::cout << std::setw(12) << errors << std::defaultfloat << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv6.h"
+#include "ns3/node.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/udp-l4-protocol.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/**
+ * Time repeated lookups of an aggregated object, and print the cost of one.
+ *
+ * @tparam T \pname{T} the type of the object looked up
+ * @param node the node to look the object up on
+ * @param name the name to print
+ * @param n the number of lookups
+ */
+template <typename T>
+void
+Bench(Ptr<Node> node, const std::string& name, uint64_t n)
+{
+    uint64_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < n; i++)
+    {
+        found += (node->GetObject<T>() != nullptr);
+    }
+    double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << elapsed * 1e9 / n << " ns"
+              << std::setw(8) << (found ? "hit" : "miss") << std::defaultfloat << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t n = 10000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Time Object::GetObject lookups on a node with an IPv4 Internet stack.\n");
+    cmd.AddValue("n", "number of lookups of each type", n);
+    cmd.Parse(argc, argv);
+
+    auto node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    internet.Install(node);
+
+    LOG(cmd.GetName() << ": " << n << " lookups of each type");
+    Bench<Ipv4>(node, "Ipv4", n);
+    Bench<Ipv4L3Protocol>(node, "Ipv4L3Protocol", n);
+    Bench<UdpL4Protocol>(node, "UdpL4Protocol", n);
+    Bench<TcpL4Protocol>(node, "TcpL4Protocol", n);
+    Bench<TrafficControlLayer>(node, "TrafficControlLayer", n);
+    Bench<Ipv6>(node, "Ipv6", n);
+
+    Simulator::Destroy();
+    return 0;
+}
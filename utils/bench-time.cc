@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/** Where the results go, so that the operations are not optimized out. */
+static volatile double g_sink;
+
+/**
+ * Time an operation over a vector of inputs, and print the cost of one.
+ *
+ * @tparam F \deduced the type of the operation
+ * @param name the name to print
+ * @param n the number of operations
+ * @param op the operation, called with the index of the operation
+ */
+template <typename F>
+void
+Bench(const std::string& name, uint64_t n, F op)
+{
+    double sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < n; i++)
+    {
+        sink += op(i);
+    }
+    double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << elapsed * 1e9 / n << " ns"
+              << std::defaultfloat << std::endl;
+    g_sink = sink;
+}
+
+/**
+ * Time each kind of operation.
+ *
+ * This runs as an event: the Time objects created before Simulator::Run
+ * are recorded in case the resolution changes, which would dominate the cost.
+ *
+ * @param name the name of the program
+ * @param n the number of operations of each kind
+ */
+void
+RunBenches(const std::string& name, uint64_t n)
+{
+    // inputs the compiler cannot fold
+    const std::size_t SIZE = 1024;
+    std::vector<Time> times(SIZE);
+    std::vector<double> wholes(SIZE);
+    std::vector<double> fractions(SIZE);
+    std::vector<int64x64_t> fixed(SIZE);
+    for (std::size_t i = 0; i < SIZE; i++)
+    {
+        times[i] = NanoSeconds(1000 + 7919 * i);
+        wholes[i] = static_cast<double>(1 + i % 16);
+        fractions[i] = 0.5 + i / 3.0;
+        fixed[i] = int64x64_t(fractions[i]);
+    }
+    auto mask = SIZE - 1;
+
+    LOG(name << ": " << n << " operations of each kind, "
+             << (int64x64_t::implementation == int64x64_t::int128_impl  ? "int128"
+                 : int64x64_t::implementation == int64x64_t::cairo_impl ? "cairo"
+                                                                        : "long double")
+             << " int64x64_t");
+    Bench("Time + Time", n, [&](uint64_t i) {
+        return (times[i & mask] + times[(i + 1) & mask]).GetTimeStep();
+    });
+    Bench("Time * integer", n, [&](uint64_t i) {
+        return (times[i & mask] * static_cast<int64_t>(i & 15)).GetTimeStep();
+    });
+    Bench("Time * whole double", n, [&](uint64_t i) {
+        return (times[i & mask] * wholes[i & mask]).GetTimeStep();
+    });
+    Bench("Time * double", n, [&](uint64_t i) {
+        return (times[i & mask] * fractions[i & mask]).GetTimeStep();
+    });
+    Bench("Time / whole double", n, [&](uint64_t i) {
+        return (times[i & mask] / wholes[i & mask]).GetTimeStep();
+    });
+    Bench("Seconds(whole double)", n, [&](uint64_t i) {
+        return Seconds(wholes[i & mask]).GetTimeStep();
+    });
+    Bench("Seconds(double)", n, [&](uint64_t i) {
+        return Seconds(fractions[i & mask]).GetTimeStep();
+    });
+    Bench("MicroSeconds(integer)", n, [&](uint64_t i) {
+        return MicroSeconds(i & mask).GetTimeStep();
+    });
+    Bench("GetSeconds", n, [&](uint64_t i) { return times[i & mask].GetSeconds(); });
+    Bench("GetMicroSeconds", n, [&](uint64_t i) { return times[i & mask].GetMicroSeconds(); });
+    Bench("ToDouble(NS)", n, [&](uint64_t i) { return times[i & mask].ToDouble(Time::NS); });
+    Bench("ToDouble(PS)", n, [&](uint64_t i) { return times[i & mask].ToDouble(Time::PS); });
+    Bench("Time / Time", n, [&](uint64_t i) {
+        return (times[i & mask] / times[(i + 1) & mask]).GetDouble();
+    });
+    Bench("int64x64_t * int64x64_t", n, [&](uint64_t i) {
+        return (fixed[i & mask] * fixed[(i + 1) & mask]).GetDouble();
+    });
+    Bench("int64x64_t / int64x64_t", n, [&](uint64_t i) {
+        return (fixed[i & mask] / fixed[(i + 1) & mask]).GetDouble();
+    });
+    Bench("int64x64_t(double)", n, [&](uint64_t i) {
+        return int64x64_t(fractions[i & mask]).GetHigh();
+    });
+
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t n = 10000000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Time the Time conversions and arithmetic, and the int64x64_t operations.\n");
+    cmd.AddValue("n", "number of operations of each kind", n);
+    cmd.Parse(argc, argv);
+
+    Simulator::Schedule(Seconds(0), &RunBenches, cmd.GetName(), n);
+    Simulator::Run();
+    Simulator::Destroy();
+    return 0;
+}
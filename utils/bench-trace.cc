@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy-state.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-ppdu.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/** The number of packets received by the devices. */
+static uint64_t g_received = 0;
+
+/**
+ * Count a received packet.
+ *
+ * @param device the receiving device
+ * @param packet the packet
+ * @param protocol the protocol
+ * @param from the sender address
+ * @returns true
+ */
+static bool
+Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from)
+{
+    g_received++;
+    return true;
+}
+
+/**
+ * Send a packet to the next device, and schedule the next one.
+ *
+ * @param device the sending device
+ * @param to the receiving device
+ * @param size the packet size
+ * @param interval the time between two packets
+ */
+static void
+Send(Ptr<NetDevice> device, Address to, uint32_t size, Time interval)
+{
+    device->Send(Create<Packet>(size), to, 0x800);
+    Simulator::Schedule(interval, &Send, device, to, size, interval);
+}
+
+/**
+ * A trace sink doing nothing.
+ *
+ * @tparam Args \deduced the arguments of the trace source
+ */
+template <typename... Args>
+void
+Sink(Args...)
+{
+}
+
+/**
+ * Connect Sink to the per-packet trace sources of the Wi-Fi devices
+ * which are compiled out when tracing is disabled.
+ */
+static void
+ConnectSinks()
+{
+    const std::string mac = "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/";
+    for (const auto& name : {"MacTx", "MacTxDrop", "MacPromiscRx", "MacRx", "MacRxDrop"})
+    {
+        Config::ConnectWithoutContext(mac + name, MakeCallback(&Sink<Ptr<const Packet>>));
+    }
+    const std::string phy = "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/";
+    Config::ConnectWithoutContext(phy + "State/State",
+                                  MakeCallback(&Sink<Time, Time, WifiPhyState>));
+    Config::ConnectWithoutContext(
+        phy + "State/RxOk",
+        MakeCallback(&Sink<Ptr<const Packet>, double, WifiMode, WifiPreamble>));
+    Config::ConnectWithoutContext(phy + "State/RxError",
+                                  MakeCallback(&Sink<Ptr<const Packet>, double>));
+    Config::ConnectWithoutContext(
+        phy + "PhyRxPpduDrop",
+        MakeCallback(&Sink<Ptr<const WifiPpdu>, WifiPhyRxfailureReason>));
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nStations = 10;
+    uint32_t size = 1000;
+    Time interval = MilliSeconds(1);
+    Time duration = Seconds(10);
+    bool connect = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Time a saturated ad hoc 802.11a network, as in wifi-bianchi, and print the "
+              "cost of one received packet.\n"
+              "Compare the runs of builds configured with and without --disable-tracing.\n");
+    cmd.AddValue("stations", "number of stations", nStations);
+    cmd.AddValue("size", "packet size in bytes", size);
+    cmd.AddValue("interval", "time between two packets of a station", interval);
+    cmd.AddValue("duration", "simulated time", duration);
+    cmd.AddValue("connect", "connect a trace sink to the Wi-Fi trace sources", connect);
+    cmd.Parse(argc, argv);
+
+    NodeContainer nodes(nStations);
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(1.0),
+                                  "GridWidth",
+                                  UintegerValue(5));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate54Mbps"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate24Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    WifiHelper::AssignStreams(devices, 1);
+
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        Ptr<NetDevice> device = devices.Get(i);
+        device->SetReceiveCallback(MakeCallback(&Receive));
+        Simulator::Schedule(MicroSeconds(7 * i),
+                            &Send,
+                            device,
+                            devices.Get((i + 1) % nStations)->GetAddress(),
+                            size,
+                            interval);
+    }
+    if (connect)
+    {
+        ConnectSinks();
+    }
+
+    Simulator::Stop(duration);
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    LOG(cmd.GetName() << ": " << nStations << " stations, " << duration.As(Time::S)
+                      << (connect ? ", trace sinks connected" : ""));
+    LOG("received packets  " << g_received);
+    LOG("events            " << Simulator::GetEventCount());
+    LOG("run time          " << std::fixed << std::setprecision(3) << elapsed << " s");
+    LOG("per packet        " << std::setprecision(0) << elapsed * 1e9 / g_received << " ns");
+
+    Simulator::Destroy();
+    return 0;
+}
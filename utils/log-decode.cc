@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/log.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Print a binary log file, written after LogSetBinaryFile(), as text.\n");
+    cmd.AddNonOption("input", "binary log file", input);
+    cmd.Parse(argc, argv);
+
+    std::ifstream file(input, std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << cmd.GetName() << ": cannot open " << input << std::endl;
+        return 1;
+    }
+    if (!LogBinaryDecode(file, std::cout))
+    {
+        std::cerr << cmd.GetName() << ": " << input << " is not a valid binary log file"
+                  << std::endl;
+        return 1;
+    }
+    return 0;
+}